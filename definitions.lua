@@ -1,9 +1,69 @@
 ---@meta
 
 
+---Called every frame before drawing, with the elapsed time since the last frame.
+---@alias UpdateEvent fun(delta: number)
+
 ---Called every frame with the elapsed time since the last frame.
 ---@alias DrawEvent fun(delta: number)
 
+---Called whenever a key or mouse button is pressed or released, with the name of the key or the index of the button.
+---@alias InputEvent fun(device: "key"|"mouse", code: string|integer, down: boolean)
+
+---Resolve the global functions `update`, `draw` & `input` again.
+---These are only looked up once the main script has run, so that they're not looked up by name every frame.
+function register() end
+
+
+---Garbage collection of scripts, stepped every frame with the time left before the next refresh.
+---@class garbage
+garbage = {}
+
+---Get or set the most time spent collecting garbage every frame.
+---@param seconds number? New budget, or zero to only collect when the allocator decides to.
+---@return number # The budget before this call.
+function garbage.budget(seconds) end
+
+---Get or set the mode of garbage collection.
+---@param mode ("incremental"|"generational")? New mode.
+---@return "incremental"|"generational" # The mode before this call.
+function garbage.mode(mode) end
+
+---Get the garbage collection telemetry of the last frame.
+---@return integer collected # Bytes freed by the last frame's steps.
+---@return integer heap # Bytes in use by scripts.
+---@return number time # Time spent collecting during the last frame, in seconds.
+function garbage.stats() end
+
+---Counters of the memory allocated by scripts.
+---@class MemoryStats
+---@field live integer Bytes in use by scripts.
+---@field reserved integer Bytes reserved from the system, including the unused parts of pools.
+---@field allocations integer Number of blocks allocated so far.
+---@field rate number Blocks allocated per second, over the last second.
+---@field classes { size: integer?, live: integer, allocations: integer }[] Counters of each size class, smallest first, followed by blocks too large for any class.
+local MemoryStats
+
+---Get the counters of the memory allocated by scripts.
+---@return MemoryStats
+function garbage.memory() end
+
+
+---Reading of JSON data straight into Lua tables.
+---@class json
+---@field null lightuserdata Value of JSON nulls, which would otherwise leave holes in tables.
+json = {}
+
+---Read a JSON file.
+---@param filename string Name of a file containing JSON data.
+---@return any # The resulting value, or nil if the file is empty.
+function json.load(filename) end
+
+---Read a JSON string.
+---@param data string JSON data.
+---@return any # The resulting value, or nil if the string is empty.
+function json.decode(data) end
+
 
 ---Represents a color where each component is a value from 0 to 1.
 ---@class Color
@@ -1,6 +1,7 @@
 #include "bindings.hpp"
 
 
+#include "bindings/json.hpp"
 #include "bindings/color.hpp"
 #include "bindings/shader.hpp"
 #include "bindings/texture.hpp"
@@ -14,6 +15,7 @@
 void lua_openbindings(lua_State* lua)
 {
 	auto top = lua_gettop(lua);
+	luaL_requiref(lua, "json", luaopen_json, true);
 	luaL_requiref(lua, "Color", luaopen_color, true);
 	luaL_requiref(lua, "Shader", luaopen_shader, true);
 	luaL_requiref(lua, "Texture", luaopen_texture, true);
@@ -2,7 +2,7 @@
 
 
 #include "../luax.hpp"
-#include "../hashmap.hpp"
+#include "../perfecthash.hpp"
 
 
 static int call_constructor(lua_State* lua);
@@ -29,7 +29,7 @@ int luaopen_color(lua_State* lua)
 		{ nullptr, nullptr },
 	};
 
-	if (luaL_newmetatable(lua, "Color"))
+	if (lua_newtype(lua, lua_colortype))
 	{
 		// Fill metatable.
 		luaL_setfuncs(lua, metatable, 0);
@@ -49,7 +49,7 @@ int luaopen_color(lua_State* lua)
 
 SDL_FColor* lua_testcolor(lua_State* lua, int arg)
 {
-	if (auto ptr = luaL_testudata(lua, arg, "Color"))
+	if (auto ptr = lua_testtype(lua, arg, lua_colortype))
 	{ return (SDL_FColor*)ptr; }
 	else
 	{ return nullptr; }
@@ -58,14 +58,14 @@ SDL_FColor* lua_testcolor(lua_State* lua, int arg)
 
 SDL_FColor& lua_checkcolor(lua_State* lua, int arg)
 {
-	return *lua_checkudata<SDL_FColor>(lua, arg, "Color");
+	return *lua_checkudata<SDL_FColor>(lua, arg, lua_colortype);
 }
 
 
 static int call_constructor(lua_State* lua)
 {
 	auto& color = *lua_newudata<SDL_FColor>(lua);
-	luaL_setmetatable(lua, "Color");
+	lua_settype(lua, lua_colortype);
 	SDL_zero(color);
 
 	if (lua_type(lua, 2) == LUA_TTABLE)
@@ -146,13 +146,13 @@ static void get_a(lua_State* lua, SDL_FColor& color)
 
 static int meta_index(lua_State* lua)
 {
-	static const Game::HashMap<std::string, lua_Prop<SDL_FColor>> getters
-	{
+	static constexpr auto getters = Game::MakePerfectHashMap<lua_Prop<SDL_FColor>>
+	({
 		{ "r", get_r },
 		{ "g", get_g },
 		{ "b", get_b },
 		{ "a", get_a },
-	};
+	});
 
 	auto key = lua_checkstringview(lua, 2);
 
@@ -180,13 +180,13 @@ static void set_a(lua_State* lua, SDL_FColor& color)
 
 static int meta_newindex(lua_State* lua)
 {
-	static const Game::HashMap<std::string, lua_Prop<SDL_FColor>> setters
-	{
+	static constexpr auto setters = Game::MakePerfectHashMap<lua_Prop<SDL_FColor>>
+	({
 		{ "r", set_r },
 		{ "g", set_g },
 		{ "b", set_b },
 		{ "a", set_a },
-	};
+	});
 
 	auto key = lua_checkstringview(lua, 2);
 
@@ -5,6 +5,13 @@
 #include <SDL3/SDL.h>
 #include <lua.hpp>
 
+#include "../luax.hpp"
+
+
+/**
+ * @brief Userdata type of colors.
+ */
+inline constexpr lua_Type lua_colortype { "Color" };
 
 /**
  * Library loading function for color type.
@@ -25,7 +32,7 @@ int luaopen_color(lua_State* lua);
  * @param arg Argument index to test.
  * @return A pointer to a color, or `nullptr` on failure.
  * 
- * @see #luaL_testudata
+ * @see #lua_testtype
  */
 SDL_FColor* lua_testcolor(lua_State* lua, int arg);
 
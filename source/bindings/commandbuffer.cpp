@@ -5,9 +5,8 @@
 #include "../program.hpp"
 #include "color.hpp"
 #include "pipeline.hpp"
-
-
-#define LUA_TEXTURE_USERVALUE 1
+#include "copypass.hpp"
+#include "renderpass.hpp"
 
 
 static int call_constructor(lua_State* lua);
@@ -42,7 +41,7 @@ int luaopen_commandbuffer(lua_State* lua)
 		{ nullptr, nullptr },
 	};
 
-	if (luaL_newmetatable(lua, "CommandBuffer"))
+	if (lua_newtype(lua, lua_commandbuffertype))
 	{
 		// Fill metatable.
 		luaL_setfuncs(lua, metatable, 0);
@@ -62,18 +61,15 @@ int luaopen_commandbuffer(lua_State* lua)
 }
 
 
-SDL_GPUCommandBuffer* lua_testcommandbuffer(lua_State* lua, int arg)
+lua_CommandBuffer* lua_testcommandbuffer(lua_State* lua, int arg)
 {
-	if (auto ptr = luaL_testudata(lua, arg, "CommandBuffer"))
-	{ return *(SDL_GPUCommandBuffer**)ptr; }
-	else
-	{ return nullptr; }
+	return lua_testhandle<lua_CommandBuffer>(lua, arg, lua_commandbuffertype);
 }
 
 
-SDL_GPUCommandBuffer*& lua_checkcommandbuffer(lua_State* lua, int arg)
+lua_CommandBuffer& lua_checkcommandbuffer(lua_State* lua, int arg)
 {
-	return *lua_checkudata<SDL_GPUCommandBuffer*>(lua, arg, "CommandBuffer");
+	return lua_checkhandle<lua_CommandBuffer>(lua, arg, lua_commandbuffertype);
 }
 
 
@@ -82,23 +78,17 @@ static int call_constructor(lua_State* lua)
 	auto& program = *lua_getprogram(lua);
 
 	// Create our command buffer.
-	auto& commands = *lua_newudata<SDL_GPUCommandBuffer*>(lua, 1);
-	commands = SDL_AcquireGPUCommandBuffer(program);
-	luaL_setmetatable(lua, "CommandBuffer");
-	auto commands_index = lua_gettop(lua);
+	auto& commands = lua_newhandle<lua_CommandBuffer>(lua, lua_commandbuffertype);
+	commands.handle = SDL_AcquireGPUCommandBuffer(program);
 
-	if (commands == nullptr)
+	if (commands.handle == nullptr)
 	{ return luaL_error(lua, SDL_GetError()); }
 
 	// Store our swapchain target texture for later.
 	if (lua_isstring(lua, 2) && lua_tostringview(lua, 2) == "display")
 	{
-		SDL_GPUTexture* texture;
-		if (!SDL_WaitAndAcquireGPUSwapchainTexture(commands, program, &texture, nullptr, nullptr))
+		if (!SDL_WaitAndAcquireGPUSwapchainTexture(commands.handle, program, &commands.meta.swapchain, nullptr, nullptr))
 		{ return luaL_error(lua, SDL_GetError()); }
-
-		lua_pushinteger(lua, (uintptr_t)texture);
-		lua_setiuservalue(lua, commands_index, LUA_TEXTURE_USERVALUE);
 	}
 
 	return 1;
@@ -109,9 +99,9 @@ static int call_destructor(lua_State* lua)
 {
 	auto& commands = lua_checkcommandbuffer(lua, 1);
 
-	if (!SDL_SubmitGPUCommandBuffer(commands))
+	if (!SDL_SubmitGPUCommandBuffer(commands.handle))
 	{ return luaL_error(lua, SDL_GetError()); }
-	commands = nullptr;
+	commands.handle = nullptr;
 
 	return 0;
 }
@@ -121,25 +111,21 @@ static int call_finalizer(lua_State* lua)
 {
 	auto& commands = lua_checkcommandbuffer(lua, 1);
 
-	if (commands != nullptr)
+	if (commands.handle != nullptr)
 	{
-		lua_getiuservalue(lua, 1, LUA_TEXTURE_USERVALUE);
-		auto texture = (SDL_GPUTexture*)lua_tointeger(lua, -1);
-		lua_pop(lua, 1);
-
 		// Attempt to either cancel or submit our dangling command buffer.
-		if (texture != nullptr)
+		if (commands.meta.swapchain != nullptr)
 		{
-			if (!SDL_SubmitGPUCommandBuffer(commands))
+			if (!SDL_SubmitGPUCommandBuffer(commands.handle))
 			{ return luaL_error(lua, SDL_GetError()); }
 		}
 		else
 		{
-			if (!SDL_CancelGPUCommandBuffer(commands))
+			if (!SDL_CancelGPUCommandBuffer(commands.handle))
 			{ return luaL_error(lua, SDL_GetError()); }
 		}
 
-		commands = nullptr;
+		commands.handle = nullptr;
 
 		return luaL_error(lua, "CommandBuffer %p was not closed properly (did you forget to add <close>)", lua_topointer(lua, 1));
 	}
@@ -152,9 +138,8 @@ static int call_copypass(lua_State* lua)
 {
 	auto& commands = lua_checkcommandbuffer(lua, 1);
 
-	auto& pass = *lua_newudata<SDL_GPUCopyPass*>(lua);
-	pass = SDL_BeginGPUCopyPass(commands);
-	luaL_setmetatable(lua, "CopyPass");
+	auto& pass = lua_newhandle<lua_CopyPass>(lua, lua_copypasstype);
+	pass.handle = SDL_BeginGPUCopyPass(commands.handle);
 
 	return 1;
 }
@@ -163,10 +148,7 @@ static int call_copypass(lua_State* lua)
 static int call_renderpass(lua_State* lua)
 {
 	auto& commands = lua_checkcommandbuffer(lua, 1);
-
-	lua_getiuservalue(lua, 1, LUA_TEXTURE_USERVALUE);
-	auto texture = (SDL_GPUTexture*)lua_tointeger(lua, -1);
-	lua_pop(lua, 1);
+	auto texture = commands.meta.swapchain;
 
 	SDL_GPUColorTargetInfo target_info{};
 	if (auto color = lua_testcolor(lua, 2))
@@ -207,9 +189,8 @@ static int call_renderpass(lua_State* lua)
 		};
 	}
 
-	auto& pass = *lua_newudata<SDL_GPURenderPass*>(lua);
-	pass = SDL_BeginGPURenderPass(commands, &target_info, 1, nullptr);
-	luaL_setmetatable(lua, "RenderPass");
+	auto& pass = lua_newhandle<lua_RenderPass>(lua, lua_renderpasstype);
+	pass.handle = SDL_BeginGPURenderPass(commands.handle, &target_info, 1, nullptr);
 
 	return 1;
 }
\ No newline at end of file
@@ -5,6 +5,27 @@
 #include <SDL3/SDL.h>
 #include <lua.hpp>
 
+#include "../luax.hpp"
+
+
+/**
+ * @brief Swapchain texture acquired by a command buffer, kept alongside it in its userdata.
+ */
+struct lua_CommandBufferTarget
+{
+	SDL_GPUTexture* swapchain;	/**< Texture to render to, or `nullptr` if the command buffer doesn't present. */
+};
+
+/**
+ * @brief Userdata layout of a command buffer.
+ */
+using lua_CommandBuffer = lua_Handle<SDL_GPUCommandBuffer*, lua_CommandBufferTarget>;
+
+/**
+ * @brief Userdata type of command buffers.
+ */
+inline constexpr lua_Type lua_commandbuffertype { "CommandBuffer" };
+
 
 /**
  * Library loading function for command buffer type.
@@ -23,9 +44,9 @@ int luaopen_commandbuffer(lua_State* lua);
  * 
  * @param lua Lua state.
  * @param arg Argument index to test.
- * @return A pointer to a command buffer, or `nullptr` on failure.
+ * @return A pointer to the handle of a command buffer, or `nullptr` on failure.
  */
-SDL_GPUCommandBuffer* lua_testcommandbuffer(lua_State* lua, int arg);
+lua_CommandBuffer* lua_testcommandbuffer(lua_State* lua, int arg);
 
 /**
  * [-0, +0, v]
@@ -34,9 +55,9 @@ SDL_GPUCommandBuffer* lua_testcommandbuffer(lua_State* lua, int arg);
  * 
  * @param lua Lua state.
  * @param arg Argument index to check.
- * @return A pointer to a command buffer.
+ * @return A reference to the handle of a command buffer.
  */
-SDL_GPUCommandBuffer*& lua_checkcommandbuffer(lua_State* lua, int arg);
+lua_CommandBuffer& lua_checkcommandbuffer(lua_State* lua, int arg);
 
 
 #endif // GAME_COMMANDBUFFER_HEADER
\ No newline at end of file
@@ -30,7 +30,7 @@ int luaopen_copypass(lua_State* lua)
 		{ nullptr, nullptr },
 	};
 
-	if (luaL_newmetatable(lua, "CopyPass"))
+	if (lua_newtype(lua, lua_copypasstype))
 	{
 		// Fill metatable
 		luaL_setfuncs(lua, metatable, 0);
@@ -44,18 +44,15 @@ int luaopen_copypass(lua_State* lua)
 }
 
 
-SDL_GPUCopyPass* lua_testcopypass(lua_State* lua, int arg)
+lua_CopyPass* lua_testcopypass(lua_State* lua, int arg)
 {
-	if (auto ptr = luaL_testudata(lua, arg, "CopyPass"))
-	{ return *(SDL_GPUCopyPass**)ptr; }
-	else
-	{ return nullptr; }
+	return lua_testhandle<lua_CopyPass>(lua, arg, lua_copypasstype);
 }
 
 
-SDL_GPUCopyPass*& lua_checkcopypass(lua_State* lua, int arg)
+lua_CopyPass& lua_checkcopypass(lua_State* lua, int arg)
 {
-	return *lua_checkudata<SDL_GPUCopyPass*>(lua, arg, "CopyPass");
+	return lua_checkhandle<lua_CopyPass>(lua, arg, lua_copypasstype);
 }
 
 
@@ -63,8 +60,8 @@ static int call_destructor(lua_State* lua)
 {
 	auto& pass = lua_checkcopypass(lua, 1);
 
-	SDL_EndGPUCopyPass(pass);
-	pass = nullptr;
+	SDL_EndGPUCopyPass(pass.handle);
+	pass.handle = nullptr;
 
 	return 0;
 }
@@ -74,10 +71,10 @@ static int call_finalizer(lua_State* lua)
 {
 	auto& pass = lua_checkcopypass(lua, 1);
 
-	if (pass != nullptr)
+	if (pass.handle != nullptr)
 	{
-		SDL_EndGPUCopyPass(pass);
-		pass = nullptr;
+		SDL_EndGPUCopyPass(pass.handle);
+		pass.handle = nullptr;
 
 		return luaL_error(lua, "CopyPass %p was not closed properly (did you forget to add <close>)", lua_topointer(lua, 1));
 	}
@@ -90,16 +87,16 @@ static int call_upload(lua_State* lua)
 {
 	auto& program = *lua_getprogram(lua);
 
-	auto pass = lua_checkcopypass(lua, 1);
+	auto pass = lua_checkcopypass(lua, 1).handle;
 
 	if (auto texture = lua_testtexture(lua, 3))
 	{
-		auto width = lua_gettexturewidth(lua, 3);
-		auto height = lua_gettextureheight(lua, 3);
+		auto width = texture->meta.width;
+		auto height = texture->meta.height;
 
 		SDL_GPUTextureRegion region
 		{
-			.texture = texture,
+			.texture = texture->handle,
 			.w = width,
 			.h = height,
 			.d = 1,
@@ -5,6 +5,19 @@
 #include <SDL3/SDL.h>
 #include <lua.hpp>
 
+#include "../luax.hpp"
+
+
+/**
+ * @brief Userdata layout of a copy pass.
+ */
+using lua_CopyPass = lua_Handle<SDL_GPUCopyPass*>;
+
+/**
+ * @brief Userdata type of copy passes.
+ */
+inline constexpr lua_Type lua_copypasstype { "CopyPass" };
+
 
 /**
  * Library loading function for copy pass type.
@@ -23,9 +36,9 @@ int luaopen_copypass(lua_State* lua);
  * 
  * @param lua Lua state.
  * @param arg Argument index to test.
- * @return A pointer to a copy pass, or `nullptr` on failure.
+ * @return A pointer to the handle of a copy pass, or `nullptr` on failure.
  */
-SDL_GPUCopyPass* lua_testcopypass(lua_State* lua, int arg);
+lua_CopyPass* lua_testcopypass(lua_State* lua, int arg);
 
 /**
  * [-0, +0, v]
@@ -34,9 +47,9 @@ SDL_GPUCopyPass* lua_testcopypass(lua_State* lua, int arg);
  * 
  * @param lua Lua state.
  * @param arg Argument index to check.
- * @return A reference to a pointer to a copy pass.
+ * @return A reference to the handle of a copy pass.
  */
-SDL_GPUCopyPass*& lua_checkcopypass(lua_State* lua, int arg);
+lua_CopyPass& lua_checkcopypass(lua_State* lua, int arg);
 
 
 #endif // GAME_COPYPASS_HEADER
\ No newline at end of file
@@ -0,0 +1,406 @@
+#include "json.hpp"
+
+
+#include <bit>
+
+#include "../json.hpp"
+#include "../luax.hpp"
+
+
+#define LUA_JSON_KEY_SLOTS 256
+
+#define LUA_JSON_BATCH 1024
+
+
+static int call_load(lua_State* lua);
+
+static int call_decode(lua_State* lua);
+
+
+int luaopen_json(lua_State* lua)
+{
+	static const luaL_Reg library[]
+	{
+		{ "load", call_load },
+		{ "decode", call_decode },
+		{ "null", nullptr },
+		{ nullptr, nullptr },
+	};
+
+	luaL_newlib(lua, library);
+	lua_pushlightuserdata(lua, nullptr);
+	lua_setfield(lua, -2, "null");
+
+	return 1;
+}
+
+
+/**
+ * Key recently pushed by a table builder, the string itself being kept in the builder's key table.
+ */
+struct KeySlot
+{
+	uint64_t hash;
+	size_t length;
+};
+
+
+/**
+ * Array or object opened but not yet closed by a table builder.
+ */
+struct OpenContainer
+{
+	int base;						/**< Stack top when the container was opened. */
+	bool object;
+	bool table;						/**< Whether the container's table was created, right above its base. */
+	lua_Integer count;				/**< Number of children already moved into the table. */
+};
+
+
+/**
+ * Reader interface implementation that builds Lua tables.
+ * 
+ * @note Children of open containers are pushed onto the Lua stack, then moved into their container's table
+ *  once it closes or once `LUA_JSON_BATCH` of them are pending, so that the stack doesn't grow with the data.
+ *  Containers closed within a single batch get a table created with exactly the right size.
+ */
+struct TableBuilder
+{
+	lua_State* lua;
+	JSN_Parser* parser;
+	const void* data;
+	size_t length;
+	bool success;
+	int keys;						/**< Stack index of the table interning recent keys, by slot. */
+	size_t depth;
+	OpenContainer containers[JSN_MAX_DEPTH];
+	KeySlot slots[LUA_JSON_KEY_SLOTS];
+};
+
+
+static bool check_stack(lua_State* lua, int n)
+{
+	if (!lua_checkstack(lua, n))
+	{ return SDL_SetError("JSON data is too large to fit on the Lua stack"); }
+
+	return true;
+}
+
+
+/**
+ * Hash the length & outer bytes of a key, collisions only costing a lookup.
+ */
+static uint64_t hash_key(const char* key, size_t length)
+{
+	uint64_t head = 0;
+	uint64_t tail = 0;
+	SDL_memcpy(&head, key, SDL_min(length, 8));
+
+	if (length > 8)
+	{ SDL_memcpy(&tail, key + length - 8, 8); }
+
+	return ((head ^ std::rotl(tail, 29) ^ length) * 0x9E3779B97F4A7C15ull) | 1;
+}
+
+
+/**
+ * Move the pending children of the innermost open container into its table, creating the table if needed.
+ */
+static void builder_flush(TableBuilder& builder)
+{
+	auto lua = builder.lua;
+	auto& container = builder.containers[builder.depth - 1];
+	auto table = container.base + 1;
+
+	if (!container.table)
+	{
+		auto pending = lua_gettop(lua) - container.base;
+		lua_createtable(lua, container.object ? 0 : pending, container.object ? pending / 2 : 0);
+		lua_rotate(lua, table, 1);
+		container.table = true;
+	}
+
+	auto pending = lua_gettop(lua) - table;
+
+	if (!container.object)
+	{
+		for (auto i = pending; i > 0; --i)
+		{ lua_rawseti(lua, table, container.count + i); }
+
+		container.count += pending;
+		return;
+	}
+
+	if (container.count == 0)
+	{
+		// Properties are set from last to first, so the first of duplicate keys wins like with chunks.
+		for (auto i = pending / 2; i > 0; --i)
+		{ lua_rawset(lua, table); }
+	}
+	else
+	{
+		// Properties of earlier batches came first, so only keys missing from the table are set.
+		for (auto i = table + 1; i < table + pending; i += 2)
+		{
+			lua_pushvalue(lua, i);
+
+			if (lua_rawget(lua, table) == LUA_TNIL)
+			{
+				lua_pushvalue(lua, i);
+				lua_pushvalue(lua, i + 1);
+				lua_rawset(lua, table);
+			}
+
+			lua_pop(lua, 1);
+		}
+
+		lua_settop(lua, table);
+	}
+
+	container.count += pending / 2;
+}
+
+
+/**
+ * Flush the innermost open container once a whole batch of children is pending, after a child was pushed.
+ */
+static bool builder_pushed(TableBuilder& builder)
+{
+	if (builder.depth == 0)
+	{ return true; }
+
+	auto& container = builder.containers[builder.depth - 1];
+	auto pending = lua_gettop(builder.lua) - container.base - (container.table ? 1 : 0);
+
+	if (pending < (container.object ? 2 * LUA_JSON_BATCH : LUA_JSON_BATCH))
+	{ return true; }
+
+	if (!check_stack(builder.lua, 3))
+	{ return false; }
+
+	builder_flush(builder);
+	return true;
+}
+
+
+static bool builder_key(void* userdata, const char* key, size_t length)
+{
+	auto& builder = *(TableBuilder*)userdata;
+	auto lua = builder.lua;
+
+	if (!check_stack(lua, 2))
+	{ return false; }
+
+	// Repeated keys are fetched from the key table, instead of being hashed & interned again by Lua (or copied again if long).
+	auto hash = hash_key(key, length);
+	auto index = (lua_Integer)(hash >> 56) % LUA_JSON_KEY_SLOTS + 1;
+	auto& slot = builder.slots[index - 1];
+
+	if (slot.hash == hash && slot.length == length)
+	{
+		lua_rawgeti(lua, builder.keys, index);
+
+		if (SDL_memcmp(lua_tostring(lua, -1), key, length) == 0)
+		{ return true; }
+
+		lua_pop(lua, 1);
+	}
+
+	lua_pushlstring(lua, key, length);
+	lua_pushvalue(lua, -1);
+	lua_rawseti(lua, builder.keys, index);
+	slot = KeySlot{ hash, length };
+
+	return true;
+}
+
+
+static bool builder_value(void* userdata, JSN_Value* value)
+{
+	auto& builder = *(TableBuilder*)userdata;
+	auto lua = builder.lua;
+
+	if (!check_stack(lua, 1))
+	{ return false; }
+
+	switch (value->type)
+	{
+		case JSN_TYPE_NULL:
+			lua_pushlightuserdata(lua, nullptr);
+			break;
+
+		case JSN_TYPE_BOOL:
+			lua_pushboolean(lua, value->bool_value);
+			break;
+
+		case JSN_TYPE_INTEGER:
+			lua_pushinteger(lua, (lua_Integer)value->integer_value);
+			break;
+
+		case JSN_TYPE_NUMBER:
+			lua_pushnumber(lua, (lua_Number)value->number_value);
+			break;
+
+		case JSN_TYPE_STRING:
+			lua_pushlstring(lua, value->string_value, value->string_length);
+			break;
+
+		default:
+			return SDL_SetError("unexpected JSON value type %d", (int)value->type);
+	}
+
+	return builder_pushed(builder);
+}
+
+
+static bool builder_open(TableBuilder& builder, bool object)
+{
+	// Readers reject deeper nesting before it gets here.
+	SDL_assert(builder.depth < JSN_MAX_DEPTH);
+	builder.containers[builder.depth++] = OpenContainer{ lua_gettop(builder.lua), object, false, 0 };
+	return true;
+}
+
+
+static bool builder_open_array(void* userdata)
+{
+	return builder_open(*(TableBuilder*)userdata, false);
+}
+
+
+static bool builder_open_object(void* userdata)
+{
+	return builder_open(*(TableBuilder*)userdata, true);
+}
+
+
+/**
+ * Move the remaining children of the innermost open container into its table, leaving the table on top of the stack.
+ */
+static bool builder_close(void* userdata, size_t)
+{
+	auto& builder = *(TableBuilder*)userdata;
+
+	if (!check_stack(builder.lua, 3))
+	{ return false; }
+
+	builder_flush(builder);
+	--builder.depth;
+
+	return builder_pushed(builder);
+}
+
+
+static const JSN_ReaderInterface builder_iface
+{
+	.version = sizeof(JSN_ReaderInterface),
+	.key = builder_key,
+	.value = builder_value,
+	.open_array = builder_open_array,
+	.close_array = builder_close,
+	.open_object = builder_open_object,
+	.close_object = builder_close,
+};
+
+
+/**
+ * Build the value of the JSON data given to a table builder, as the protected part of `lua_pushjson`.
+ */
+static int call_build(lua_State* lua)
+{
+	auto& builder = *(TableBuilder*)lua_touserdata(lua, 1);
+	builder.lua = lua;
+
+	lua_createtable(lua, LUA_JSON_KEY_SLOTS, 0);
+	builder.keys = lua_gettop(lua);
+
+	builder.success = JSN_ParseMem(builder.parser, builder.data, builder.length);
+
+	if (!builder.success)
+	{ return 0; }
+
+	if (lua_gettop(lua) == builder.keys)
+	{ lua_pushnil(lua); }
+
+	return 1;
+}
+
+
+/**
+ * Push the value of the given JSON data, running the table builder in a protected call.
+ * 
+ * @return The status of the protected call, whose error object is pushed instead of the value on failure.
+ *  `success` is set to whether the data was read, nothing being pushed if it wasn't.
+ */
+static int pcall_build(lua_State* lua, const void* data, size_t length, bool& success)
+{
+	TableBuilder builder;
+	SDL_zero(builder);
+	builder.data = data;
+	builder.length = length;
+
+	builder.parser = JSN_CreateParser(&builder_iface, &builder);
+	success = false;
+
+	if (builder.parser == nullptr)
+	{ return LUA_OK; }
+
+	lua_pushcfunction(lua, call_build);
+	lua_pushlightuserdata(lua, &builder);
+	auto status = lua_pcall(lua, 1, 1, 0);
+
+	JSN_DestroyParser(builder.parser);
+	success = status == LUA_OK && builder.success;
+
+	if (status == LUA_OK && !success)
+	{ lua_pop(lua, 1); }
+
+	return status;
+}
+
+
+bool lua_pushjson(lua_State* lua, const void* data, size_t length)
+{
+	bool success;
+
+	// Lua errors raised while building, e.g. running out of memory, are raised again once the parser is freed.
+	if (pcall_build(lua, data, length, success) != LUA_OK)
+	{ lua_error(lua); }
+
+	return success;
+}
+
+
+static int call_load(lua_State* lua)
+{
+	auto filename = luaL_checkstring(lua, 1);
+
+	size_t length;
+	auto data = SDL_LoadFile(filename, &length);
+
+	if (data == nullptr)
+	{ return luaL_error(lua, "%s", SDL_GetError()); }
+
+	bool success;
+	auto status = pcall_build(lua, data, length, success);
+	SDL_free(data);
+
+	if (status != LUA_OK)
+	{ return lua_error(lua); }
+
+	if (!success)
+	{ return luaL_error(lua, "%s", SDL_GetError()); }
+
+	return 1;
+}
+
+
+static int call_decode(lua_State* lua)
+{
+	auto json = lua_checkstringview(lua, 1);
+
+	if (!lua_pushjson(lua, json.data(), json.size()))
+	{ return luaL_error(lua, "%s", SDL_GetError()); }
+
+	return 1;
+}
@@ -0,0 +1,36 @@
+#ifndef GAME_LUAJSON_HEADER
+#define GAME_LUAJSON_HEADER
+
+
+#include <SDL3/SDL.h>
+#include <lua.hpp>
+
+
+/**
+ * Library loading function for the JSON library.
+ * 
+ * @param lua Lua state.
+ * @return Number of returned values.
+ * 
+ * @note Meant to be used in conjunction with [`luaL_requiref`](https://www.lua.org/manual/5.4/manual.html#luaL_requiref).
+ */
+int luaopen_json(lua_State* lua);
+
+/**
+ * [-0, +1, m]
+ * 
+ * Read JSON data from a memory buffer, pushing the resulting value onto the stack.
+ * 
+ * Tables are built straight from the reader's events, without going through a `JSN_Chunk`.
+ * Null values are pushed as `json.null`, a light userdata, and empty inputs as `nil`.
+ * Lua errors raised while building tables, e.g. when running out of memory, are raised again once the reader is freed.
+ * 
+ * @param lua Lua state.
+ * @param data A pointer to a buffer containing JSON data.
+ * @param length The length of the buffer in bytes.
+ * @return `true` on success or `false` on failure, in which case nothing is pushed; call `SDL_GetError` for more information.
+ */
+bool lua_pushjson(lua_State* lua, const void* data, size_t length);
+
+
+#endif // GAME_LUAJSON_HEADER
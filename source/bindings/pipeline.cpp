@@ -7,7 +7,7 @@
 #include <SDL3/SDL.h>
 
 #include "../luax.hpp"
-#include "../hashmap.hpp"
+#include "../perfecthash.hpp"
 #include "../program.hpp"
 #include "shader.hpp"
 #include "renderpass.hpp"
@@ -43,7 +43,7 @@ int luaopen_pipeline(lua_State* lua)
 		{ nullptr, nullptr },
 	};
 
-	if (luaL_newmetatable(lua, "Pipeline"))
+	if (lua_newtype(lua, lua_pipelinetype))
 	{
 		// Fill metatable
 		luaL_setfuncs(lua, metatable, 0);
@@ -63,25 +63,22 @@ int luaopen_pipeline(lua_State* lua)
 }
 
 
-SDL_GPUGraphicsPipeline* lua_testpipeline(lua_State* lua, int arg)
+lua_Pipeline* lua_testpipeline(lua_State* lua, int arg)
 {
-	if (auto ptr = luaL_testudata(lua, arg, "Pipeline"))
-	{ return *(SDL_GPUGraphicsPipeline**)ptr; }
-	else
-	{ return nullptr; }
+	return lua_testhandle<lua_Pipeline>(lua, arg, lua_pipelinetype);
 }
 
 
-SDL_GPUGraphicsPipeline*& lua_checkpipeline(lua_State* lua, int arg)
+lua_Pipeline& lua_checkpipeline(lua_State* lua, int arg)
 {
-	return *lua_checkudata<SDL_GPUGraphicsPipeline*>(lua, arg, "Pipeline");
+	return lua_checkhandle<lua_Pipeline>(lua, arg, lua_pipelinetype);
 }
 
 
 static int call_constructor(lua_State* lua)
 {
-	static const Game::HashMap<std::string, SDL_GPUVertexElementFormat> vertex_formats
-	{
+	static constexpr auto vertex_formats = Game::MakePerfectHashMap<SDL_GPUVertexElementFormat>
+	({
 		{ "int",  SDL_GPU_VERTEXELEMENTFORMAT_INT },
 		{ "int2", SDL_GPU_VERTEXELEMENTFORMAT_INT2 },
 		{ "int3", SDL_GPU_VERTEXELEMENTFORMAT_INT3 },
@@ -120,22 +117,22 @@ static int call_constructor(lua_State* lua)
 
 		{ "ushort2norm", SDL_GPU_VERTEXELEMENTFORMAT_USHORT2_NORM },
 		{ "ushort4norm", SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM },
-	};
+	});
 
-	static const Game::HashMap<std::string, SDL_GPUPrimitiveType> primitives
-	{
+	static constexpr auto primitives = Game::MakePerfectHashMap<SDL_GPUPrimitiveType>
+	({
 		{ "trianglelist",  SDL_GPU_PRIMITIVETYPE_TRIANGLELIST },
 		{ "trianglestrip", SDL_GPU_PRIMITIVETYPE_TRIANGLESTRIP },
 		{ "linelist",      SDL_GPU_PRIMITIVETYPE_LINELIST },
 		{ "linestrip",     SDL_GPU_PRIMITIVETYPE_LINESTRIP },
 		{ "pointlist",     SDL_GPU_PRIMITIVETYPE_POINTLIST },
-	};
+	});
 
-	static const Game::HashMap<std::string, SDL_GPUVertexInputRate> rates
-	{
+	static constexpr auto rates = Game::MakePerfectHashMap<SDL_GPUVertexInputRate>
+	({
 		{ "vertex",   SDL_GPU_VERTEXINPUTRATE_VERTEX, },
 		{ "instance", SDL_GPU_VERTEXINPUTRATE_INSTANCE, },
-	};
+	});
 
 	auto& program = *lua_getprogram(lua);
 
@@ -144,11 +141,11 @@ static int call_constructor(lua_State* lua)
 
 	// First arg field 'vertex' is our vertex shader.
 	lua_getfield(lua, 2, "vertex");
-	auto vertex = lua_checkshader(lua, 3);
+	auto vertex = lua_checkshader(lua, 3).handle;
 
 	// First arg field 'fragment' is our fragment shader.
 	lua_getfield(lua, 2, "fragment");
-	auto fragment = lua_checkshader(lua, 4);
+	auto fragment = lua_checkshader(lua, 4).handle;
 
 	// First arg field 'inputs' is our input layout.
 	lua_getfield(lua, 2, "inputs");
@@ -281,12 +278,11 @@ static int call_constructor(lua_State* lua)
 	};
 
 	// Create our graphics pipeline.
-	auto& pipeline = *lua_newudata<SDL_GPUGraphicsPipeline*>(lua, 2);
-	pipeline = SDL_CreateGPUGraphicsPipeline(program, &info);
-	luaL_setmetatable(lua, "Pipeline");
+	auto& pipeline = lua_newhandle<lua_Pipeline>(lua, lua_pipelinetype, 2);
+	pipeline.handle = SDL_CreateGPUGraphicsPipeline(program, &info);
 	auto pipeline_index = lua_gettop(lua);
 
-	if (pipeline == nullptr)
+	if (pipeline.handle == nullptr)
 	{ return luaL_error(lua, "%s", SDL_GetError()); }
 
 	// Prevent our shaders from getting garbage-collected.
@@ -306,7 +302,7 @@ static int call_finalizer(lua_State* lua)
 	auto& program = *lua_getprogram(lua);
 
 	// Destroy our graphics pipeline.
-	auto pipeline = lua_checkpipeline(lua, 1);
+	auto pipeline = lua_checkpipeline(lua, 1).handle;
 	SDL_ReleaseGPUGraphicsPipeline(program, pipeline);
 
 	// Allow our shaders to get garbage-collected.
@@ -325,7 +321,7 @@ static int call_bind(lua_State* lua)
 	auto& pipeline = lua_checkpipeline(lua, 1);
 	auto& pass = lua_checkrenderpass(lua, 2);
 
-	SDL_BindGPUGraphicsPipeline(pass, pipeline);
+	SDL_BindGPUGraphicsPipeline(pass.handle, pipeline.handle);
 
 	return 0;
 }
\ No newline at end of file
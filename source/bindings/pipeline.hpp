@@ -5,6 +5,19 @@
 #include <SDL3/SDL.h>
 #include <lua.hpp>
 
+#include "../luax.hpp"
+
+
+/**
+ * @brief Userdata layout of a graphics pipeline.
+ */
+using lua_Pipeline = lua_Handle<SDL_GPUGraphicsPipeline*>;
+
+/**
+ * @brief Userdata type of graphics pipelines.
+ */
+inline constexpr lua_Type lua_pipelinetype { "Pipeline" };
+
 
 /**
  * Library loading function for graphics pipeline type.
@@ -23,9 +36,9 @@ int luaopen_pipeline(lua_State* lua);
  * 
  * @param lua Lua state.
  * @param arg Argument index to test.
- * @return A pointer to a graphics pipeline, or `nullptr` on failure.
+ * @return A pointer to the handle of a graphics pipeline, or `nullptr` on failure.
  */
-SDL_GPUGraphicsPipeline* lua_testpipeline(lua_State* lua, int arg);
+lua_Pipeline* lua_testpipeline(lua_State* lua, int arg);
 
 /**
  * [-0, +0, v]
@@ -34,9 +47,9 @@ SDL_GPUGraphicsPipeline* lua_testpipeline(lua_State* lua, int arg);
  * 
  * @param lua Lua state.
  * @param arg Argument index to check.
- * @return A pointer to a graphics pipeline.
+ * @return A reference to the handle of a graphics pipeline.
  */
-SDL_GPUGraphicsPipeline*& lua_checkpipeline(lua_State* lua, int arg);
+lua_Pipeline& lua_checkpipeline(lua_State* lua, int arg);
 
 
 #endif // GAME_BINDINGS_PIPELINE_HEADER
\ No newline at end of file
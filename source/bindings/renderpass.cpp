@@ -22,7 +22,7 @@ int luaopen_renderpass(lua_State* lua)
 		{ nullptr, nullptr },
 	};
 
-	if (luaL_newmetatable(lua, "RenderPass"))
+	if (lua_newtype(lua, lua_renderpasstype))
 	{
 		// Fill metatable.
 		luaL_setfuncs(lua, metatable, 0);
@@ -36,18 +36,15 @@ int luaopen_renderpass(lua_State* lua)
 }
 
 
-SDL_GPURenderPass* lua_testrenderpass(lua_State* lua, int arg)
+lua_RenderPass* lua_testrenderpass(lua_State* lua, int arg)
 {
-	if (auto ptr = luaL_testudata(lua, arg, "RenderPass"))
-	{ return *(SDL_GPURenderPass**)ptr; }
-	else
-	{ return nullptr; }
+	return lua_testhandle<lua_RenderPass>(lua, arg, lua_renderpasstype);
 }
 
 
-SDL_GPURenderPass*& lua_checkrenderpass(lua_State* lua, int arg)
+lua_RenderPass& lua_checkrenderpass(lua_State* lua, int arg)
 {
-	return *lua_checkudata<SDL_GPURenderPass*>(lua, arg, "RenderPass");
+	return lua_checkhandle<lua_RenderPass>(lua, arg, lua_renderpasstype);
 }
 
 
@@ -55,8 +52,8 @@ static int call_destructor(lua_State* lua)
 {
 	auto& pass = lua_checkrenderpass(lua, 1);
 
-	SDL_EndGPURenderPass(pass);
-	pass = nullptr;
+	SDL_EndGPURenderPass(pass.handle);
+	pass.handle = nullptr;
 
 	return 0;
 }
@@ -66,10 +63,10 @@ static int call_finalizer(lua_State* lua)
 {
 	auto& pass = lua_checkrenderpass(lua, 1);
 
-	if (pass != nullptr)
+	if (pass.handle != nullptr)
 	{
-		SDL_EndGPURenderPass(pass);
-		pass = nullptr;
+		SDL_EndGPURenderPass(pass.handle);
+		pass.handle = nullptr;
 
 		return luaL_error(lua, "RenderPass %p was not closed properly (did you forget to add <close>)", lua_topointer(lua, 1));
 	}
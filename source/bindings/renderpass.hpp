@@ -5,6 +5,19 @@
 #include <SDL3/SDL.h>
 #include <lua.hpp>
 
+#include "../luax.hpp"
+
+
+/**
+ * @brief Userdata layout of a render pass.
+ */
+using lua_RenderPass = lua_Handle<SDL_GPURenderPass*>;
+
+/**
+ * @brief Userdata type of render passes.
+ */
+inline constexpr lua_Type lua_renderpasstype { "RenderPass" };
+
 
 /**
  * Library loading function for render pass type.
@@ -23,9 +36,9 @@ int luaopen_renderpass(lua_State* lua);
  * 
  * @param lua Lua state.
  * @param arg Argument index to test.
- * @return A pointer to a render pass, or `nullptr` on failure.
+ * @return A pointer to the handle of a render pass, or `nullptr` on failure.
  */
-SDL_GPURenderPass* lua_testrenderpass(lua_State* lua, int arg);
+lua_RenderPass* lua_testrenderpass(lua_State* lua, int arg);
 
 /**
  * [-0, +0, v]
@@ -34,9 +47,9 @@ SDL_GPURenderPass* lua_testrenderpass(lua_State* lua, int arg);
  * 
  * @param lua Lua state.
  * @param arg Argument index to check.
- * @return A pointer to a render pass.
+ * @return A reference to the handle of a render pass.
  */
-SDL_GPURenderPass*& lua_checkrenderpass(lua_State* lua, int arg);
+lua_RenderPass& lua_checkrenderpass(lua_State* lua, int arg);
 
 
 #endif // GAME_RENDERPASS_HEADER
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 
 #include "../luax.hpp"
-#include "../hashmap.hpp"
+#include "../perfecthash.hpp"
 #include "../program.hpp"
 
 
@@ -27,7 +27,7 @@ int luaopen_sampler(lua_State* lua)
 		{ nullptr, nullptr },
 	};
 
-	if (luaL_newmetatable(lua, "Sampler"))
+	if (lua_newtype(lua, lua_samplertype))
 	{
 		// Fill metatable.
 		luaL_setfuncs(lua, metatable, 0);
@@ -45,41 +45,38 @@ int luaopen_sampler(lua_State* lua)
 }
 
 
-SDL_GPUSampler* lua_testsampler(lua_State* lua, int arg)
+lua_Sampler* lua_testsampler(lua_State* lua, int arg)
 {
-	if (auto ptr = luaL_testudata(lua, arg, "Sampler"))
-	{ return *(SDL_GPUSampler**)ptr; }
-	else
-	{ return nullptr; }
+	return lua_testhandle<lua_Sampler>(lua, arg, lua_samplertype);
 }
 
 
-SDL_GPUSampler*& lua_checksampler(lua_State* lua, int arg)
+lua_Sampler& lua_checksampler(lua_State* lua, int arg)
 {
-	return *lua_checkudata<SDL_GPUSampler*>(lua, arg, "Sampler");
+	return lua_checkhandle<lua_Sampler>(lua, arg, lua_samplertype);
 }
 
 
 static int call_constructor(lua_State* lua)
 {
-	static const Game::HashMap<std::string, SDL_GPUFilter> filters
-	{
+	static constexpr auto filters = Game::MakePerfectHashMap<SDL_GPUFilter>
+	({
 		{ "nearest", SDL_GPU_FILTER_NEAREST },
 		{ "linear",  SDL_GPU_FILTER_LINEAR },
-	};
+	});
 
-	static const Game::HashMap<std::string, SDL_GPUSamplerMipmapMode> mipmap_modes
-	{
+	static constexpr auto mipmap_modes = Game::MakePerfectHashMap<SDL_GPUSamplerMipmapMode>
+	({
 		{ "nearest", SDL_GPU_SAMPLERMIPMAPMODE_NEAREST },
 		{ "linear",  SDL_GPU_SAMPLERMIPMAPMODE_LINEAR },
-	};
+	});
 
-	static const Game::HashMap<std::string, SDL_GPUSamplerAddressMode> address_modes
-	{
+	static constexpr auto address_modes = Game::MakePerfectHashMap<SDL_GPUSamplerAddressMode>
+	({
 		{ "repeat", SDL_GPU_SAMPLERADDRESSMODE_REPEAT },
 		{ "mirror", SDL_GPU_SAMPLERADDRESSMODE_MIRRORED_REPEAT },
 		{ "clamp",  SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE },
-	};
+	});
 
 	enum stack_indices : int
 	{
@@ -164,11 +161,10 @@ static int call_constructor(lua_State* lua)
 	info.max_anisotropy = info.enable_anisotropy ? 16 : 0;
 
 	// Create our sampler.
-	auto& sampler = *lua_newudata<SDL_GPUSampler*>(lua, 0);
-	sampler = SDL_CreateGPUSampler(program, &info);
-	luaL_setmetatable(lua, "Sampler");
+	auto& sampler = lua_newhandle<lua_Sampler>(lua, lua_samplertype);
+	sampler.handle = SDL_CreateGPUSampler(program, &info);
 
-	if (sampler == nullptr)
+	if (sampler.handle == nullptr)
 	{ return luaL_error(lua, "%s", SDL_GetError()); }
 
 	// Return our sampler.
@@ -180,7 +176,7 @@ static int call_finalizer(lua_State* lua)
 {
 	auto& program = *lua_getprogram(lua);
 
-	auto sampler = lua_checksampler(lua, 1);
+	auto sampler = lua_checksampler(lua, 1).handle;
 	SDL_ReleaseGPUSampler(program, sampler);
 
 	return 0;
@@ -5,12 +5,25 @@
 #include <SDL3/SDL.h>
 #include <lua.hpp>
 
+#include "../luax.hpp"
+
+
+/**
+ * @brief Userdata layout of a sampler.
+ */
+using lua_Sampler = lua_Handle<SDL_GPUSampler*>;
+
+/**
+ * @brief Userdata type of samplers.
+ */
+inline constexpr lua_Type lua_samplertype { "Sampler" };
+
 
 int luaopen_sampler(lua_State* lua);
 
-SDL_GPUSampler* lua_testsampler(lua_State* lua, int arg);
+lua_Sampler* lua_testsampler(lua_State* lua, int arg);
 
-SDL_GPUSampler*& lua_checksampler(lua_State* lua, int arg);
+lua_Sampler& lua_checksampler(lua_State* lua, int arg);
 
 
 #endif // GAME_SAMPLER_HEADER
\ No newline at end of file
@@ -6,7 +6,7 @@
 
 #include "../luax.hpp"
 #include "../debug.hpp"
-#include "../hashmap.hpp"
+#include "../perfecthash.hpp"
 #include "../program.hpp"
 
 
@@ -33,7 +33,7 @@ int luaopen_shader(lua_State* lua)
 		{ nullptr, nullptr },
 	};
 
-	if (luaL_newmetatable(lua, "Shader"))
+	if (lua_newtype(lua, lua_shadertype))
 	{
 		// Fill metatable
 		luaL_setfuncs(lua, metatable, 0);
@@ -53,28 +53,25 @@ int luaopen_shader(lua_State* lua)
 }
 
 
-SDL_GPUShader* lua_testshader(lua_State* lua, int arg)
+lua_Shader* lua_testshader(lua_State* lua, int arg)
 {
-	if (auto ptr = luaL_testudata(lua, arg, "Shader"))
-	{ return *(SDL_GPUShader**)ptr; }
-	else
-	{ return nullptr; }
+	return lua_testhandle<lua_Shader>(lua, arg, lua_shadertype);
 }
 
 
-SDL_GPUShader*& lua_checkshader(lua_State* lua, int arg)
+lua_Shader& lua_checkshader(lua_State* lua, int arg)
 {
-	return *lua_checkudata<SDL_GPUShader*>(lua, arg, "Shader");
+	return lua_checkhandle<lua_Shader>(lua, arg, lua_shadertype);
 }
 
 
 static int call_constructor(lua_State* lua)
 {
-	static const Game::HashMap<std::string, SDL_GPUShaderStage> stages
-	{
+	static constexpr auto stages = Game::MakePerfectHashMap<SDL_GPUShaderStage>
+	({
 		{ "vertex",   SDL_GPU_SHADERSTAGE_VERTEX },
 		{ "fragment", SDL_GPU_SHADERSTAGE_FRAGMENT },
-	};
+	});
 
 	auto& program = *lua_getprogram(lua);
 
@@ -126,8 +123,7 @@ static int call_constructor(lua_State* lua)
 	{ return luaL_error(lua, "%s", SDL_GetError()); }
 
 	// Create a pointer to our shader.
-	auto& shader = *lua_newudata<SDL_GPUShader*>(lua);
-	luaL_setmetatable(lua, "Shader");
+	auto& shader = lua_newhandle<lua_Shader>(lua, lua_shadertype);
 
 	// Fill out information about bytecode.
 	auto props = SDL_CreateProperties();
@@ -144,7 +140,7 @@ static int call_constructor(lua_State* lua)
 	};
 
 	// Create our shader.
-	shader = SDL_CreateGPUShader(program, &code_info);
+	shader.handle = SDL_CreateGPUShader(program, &code_info);
 	SDL_DestroyProperties(props);
 	SDL_free(code_data);
 	lua_pop(lua, 1);
@@ -158,7 +154,7 @@ static int call_finalizer(lua_State* lua)
 {
 	auto& program = *lua_getprogram(lua);
 
-	auto shader = *lua_checkudata<SDL_GPUShader*>(lua, 1, "Shader");
+	auto shader = lua_checkshader(lua, 1).handle;
 	SDL_ReleaseGPUShader(program, shader);
 
 	return 0;
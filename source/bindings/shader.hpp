@@ -5,6 +5,19 @@
 #include <SDL3/SDL.h>
 #include <lua.hpp>
 
+#include "../luax.hpp"
+
+
+/**
+ * @brief Userdata layout of a shader.
+ */
+using lua_Shader = lua_Handle<SDL_GPUShader*>;
+
+/**
+ * @brief Userdata type of shaders.
+ */
+inline constexpr lua_Type lua_shadertype { "Shader" };
+
 
 /**
  * Library loading function for shader type.
@@ -23,9 +36,9 @@ int luaopen_shader(lua_State* lua);
  * 
  * @param lua Lua state.
  * @param arg Argument index to test.
- * @return A pointer to a shader, or `nullptr` on failure.
+ * @return A pointer to the handle of a shader, or `nullptr` on failure.
  */
-SDL_GPUShader* lua_testshader(lua_State* lua, int arg);
+lua_Shader* lua_testshader(lua_State* lua, int arg);
 
 /**
  * [-0, +0, v]
@@ -34,9 +47,9 @@ SDL_GPUShader* lua_testshader(lua_State* lua, int arg);
  * 
  * @param lua Lua state.
  * @param arg Argument index to check.
- * @return A pointer to a shader.
+ * @return A reference to the handle of a shader.
  */
-SDL_GPUShader*& lua_checkshader(lua_State* lua, int arg);
+lua_Shader& lua_checkshader(lua_State* lua, int arg);
 
 
 #endif // GAME_BINDINGS_SHADER_HEADER
\ No newline at end of file
@@ -5,10 +5,6 @@
 #include "../program.hpp"
 
 
-#define LUA_WIDTH_USERVALUE 1
-#define LUA_HEIGHT_USERVALUE 2
-
-
 static int call_constructor(lua_State* lua);
 
 static int call_finalizer(lua_State* lua);
@@ -30,7 +26,7 @@ int luaopen_texture(lua_State* lua)
 		{ nullptr, nullptr },
 	};
 
-	if (luaL_newmetatable(lua, "Texture"))
+	if (lua_newtype(lua, lua_texturetype))
 	{
 		// Fill metatable
 		luaL_setfuncs(lua, metatable, 0);
@@ -48,36 +44,15 @@ int luaopen_texture(lua_State* lua)
 }
 
 
-SDL_GPUTexture* lua_testtexture(lua_State* lua, int arg)
-{
-	if (auto ptr = luaL_testudata(lua, arg, "Texture"))
-	{ return *(SDL_GPUTexture**)ptr; }
-	else
-	{ return nullptr; }
-}
-
-
-SDL_GPUTexture*& lua_checktexture(lua_State* lua, int arg)
-{
-	return *lua_checkudata<SDL_GPUTexture*>(lua, arg, "Texture");
-}
-
-
-Uint32 lua_gettexturewidth(lua_State* lua, int index)
+lua_Texture* lua_testtexture(lua_State* lua, int arg)
 {
-	lua_getiuservalue(lua, index, LUA_WIDTH_USERVALUE);
-	auto width = lua_tointeger(lua, -1);
-	lua_pop(lua, 1);
-	return width;
+	return lua_testhandle<lua_Texture>(lua, arg, lua_texturetype);
 }
 
 
-Uint32 lua_gettextureheight(lua_State* lua, int index)
+lua_Texture& lua_checktexture(lua_State* lua, int arg)
 {
-	lua_getiuservalue(lua, index, LUA_HEIGHT_USERVALUE);
-	auto width = lua_tointeger(lua, -1);
-	lua_pop(lua, 1);
-	return width;
+	return lua_checkhandle<lua_Texture>(lua, arg, lua_texturetype);
 }
 
 
@@ -90,9 +65,7 @@ static int call_constructor(lua_State* lua)
 
 	lua_settop(lua, 3);
 
-	auto& texture = *lua_newudata<SDL_GPUTexture*>(lua, 2);
-	luaL_setmetatable(lua, "Texture");
-	auto texture_index = lua_gettop(lua);
+	auto& texture = lua_newhandle<lua_Texture>(lua, lua_texturetype);
 
 	SDL_GPUTextureCreateInfo info
 	{
@@ -104,14 +77,11 @@ static int call_constructor(lua_State* lua)
 		.layer_count_or_depth = 1,
 		.num_levels = 1,
 	};
-	texture = SDL_CreateGPUTexture(program, &info);
-	if (texture == nullptr)
+	texture.handle = SDL_CreateGPUTexture(program, &info);
+	if (texture.handle == nullptr)
 	{ return luaL_error(lua, "%s", SDL_GetError()); }
 
-	lua_pushinteger(lua, width);
-	lua_setiuservalue(lua, texture_index, LUA_WIDTH_USERVALUE);
-	lua_pushinteger(lua, height);
-	lua_setiuservalue(lua, texture_index, LUA_HEIGHT_USERVALUE);
+	texture.meta = lua_TextureSize{ width, height };
 
 	return 1;
 }
@@ -122,7 +92,7 @@ static int call_finalizer(lua_State* lua)
 	auto& program = *lua_getprogram(lua);
 
 	auto& texture = lua_checktexture(lua, 1);
-	SDL_ReleaseGPUTexture(program, texture);
+	SDL_ReleaseGPUTexture(program, texture.handle);
 
 	return 0;
 }
\ No newline at end of file
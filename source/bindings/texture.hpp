@@ -5,16 +5,34 @@
 #include <SDL3/SDL.h>
 #include <lua.hpp>
 
+#include "../luax.hpp"
 
-int luaopen_texture(lua_State* lua);
 
-SDL_GPUTexture* lua_testtexture(lua_State* lua, int arg);
+/**
+ * @brief Size of a texture, kept alongside it in its userdata.
+ */
+struct lua_TextureSize
+{
+	Uint32 width;
+	Uint32 height;
+};
+
+/**
+ * @brief Userdata layout of a texture.
+ */
+using lua_Texture = lua_Handle<SDL_GPUTexture*, lua_TextureSize>;
+
+/**
+ * @brief Userdata type of textures.
+ */
+inline constexpr lua_Type lua_texturetype { "Texture" };
 
-SDL_GPUTexture*& lua_checktexture(lua_State* lua, int arg);
 
-Uint32 lua_gettexturewidth(lua_State* lua, int index);
+int luaopen_texture(lua_State* lua);
+
+lua_Texture* lua_testtexture(lua_State* lua, int arg);
 
-Uint32 lua_gettextureheight(lua_State* lua, int index);
+lua_Texture& lua_checktexture(lua_State* lua, int arg);
 
 
 #endif // GAME_TEXTURE_HEADER
\ No newline at end of file
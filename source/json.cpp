@@ -1,705 +1,5553 @@
 #include "json.hpp"
 
 
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
 #include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_cpuinfo.h>
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_properties.h>
+#include <SDL3/SDL_thread.h>
+#include <SDL3/SDL_timer.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
 
 
 /* ==================================================
 	JSON CHUNK API
 ================================================== */
 
+/**
+ * @brief Size of the first arena block of a chunk, subsequent blocks double in size.
+ */
+constexpr size_t JSN_ARENA_MIN_BLOCK = 16 * 1024;
+
+/**
+ * @brief Size past which arena blocks stop doubling in size.
+ */
+constexpr size_t JSN_ARENA_MAX_BLOCK = 16 * 1024 * 1024;
+
+
+/**
+ * @brief Header of a block of memory from which chunk nodes & strings are bump-allocated.
+ */
+struct alignas(std::max_align_t) JSN_ArenaBlock
+{
+	JSN_ArenaBlock* next;
+	size_t size;
+	size_t used;
+};
+
+
 struct JSN_Chunk
 {
 	JSN_Value root;
+	JSN_ArenaBlock* blocks;		/**< Arena blocks owned by this chunk, most recent first. */
+	size_t next_block_size;		/**< Size of the next arena block to be allocated. */
+	SDL_IOStream* source;		/**< Stream from which the containers of a lazy chunk are read, NULL for other chunks. */
+	bool closeio;				/**< Whether the source is closed along with the chunk. */
+	SDL_AtomicInt refs;			/**< References to this chunk, from its owner & from the chunks sharing its values. */
+	struct JSN_ChunkRef* retained;	/**< Chunks whose values are shared by this one, released along with it. */
+	struct JSN_Lazy* sharing;	/**< Containers of this chunk made to share the children of other chunks' containers. */
+	SDL_AtomicInt shares;		/**< Containers of other chunks still to be built from containers of this one. */
 };
 
 
-static void FinalizeValue(JSN_Chunk* chunk, JSN_Value* value)
+struct JSN_ChunkRef
 {
-	switch (value->type)
-	{
-		case JSN_TYPE_STRING:
-			SDL_free((void*)value->string_value);
-			break;
-
-		case JSN_TYPE_ARRAY:
-		{
-			JSN_Array* array = value->array_value;
-			for (JSN_Element* el = array->first; el; el = el->next)
-			{ FinalizeValue(chunk, &el->value); }
-			SDL_free(array);
-			break;
-		}
+	JSN_Chunk* chunk;
+	JSN_ChunkRef* next;
+};
 
-		case JSN_TYPE_OBJECT:
-		{
-			JSN_Object* object = value->object_value;
-			for (JSN_Property* prop = object->first; prop; prop = prop->next)
-			{
-				SDL_free((void*)prop->key);
-				FinalizeValue(chunk, &prop->value);
-			}
-			SDL_free(object);
-			break;
-		}
-	}
 
-	SDL_zerop(value);
-}
+/**
+ * @brief Where the children of a container which haven't been built yet are to be found.
+ */
+struct JSN_Lazy
+{
+	Sint64 offset;			/**< Range of the source of a lazy chunk spanned by the container. */
+	size_t length;
+	JSN_Value shared;		/**< Container of another chunk whose children are shared with this one, or JSN_TYPE_EMPTY to read the range. */
+	JSN_Lazy* next;			/**< Next container of the chunk made to share another chunk's children. */
+};
 
 
-JSN_Chunk* JSN_CreateChunk()
+static char* JSN_ArenaBlockData(JSN_ArenaBlock* block)
 {
-	JSN_Chunk* chunk = (JSN_Chunk*)SDL_malloc(sizeof(JSN_Chunk));
-	SDL_zerop(chunk);
-	return chunk;
+	return (char*)block + sizeof(JSN_ArenaBlock);
 }
 
 
-void JSN_DestroyChunk(JSN_Chunk* chunk)
+static void* JSN_ChunkAlloc(JSN_Chunk* chunk, size_t size, size_t align)
 {
-	FinalizeValue(chunk, &chunk->root);
-	SDL_free(chunk);
-}
+	if (JSN_ArenaBlock* block = chunk->blocks)
+	{
+		size_t offset = (block->used + align - 1) & ~(align - 1);
+		if (offset + size <= block->size)
+		{
+			block->used = offset + size;
+			return JSN_ArenaBlockData(block) + offset;
+		}
+	}
 
+	// Oversized requests get a block of their own so as to not waste the tail of the current one.
+	size_t block_size = chunk->next_block_size;
+	if (size > block_size / 4)
+	{ block_size = size; }
+	else if (chunk->next_block_size < JSN_ARENA_MAX_BLOCK)
+	{ chunk->next_block_size *= 2; }
 
-bool JSN_ChunkCopy(JSN_Chunk* chunk, JSN_Value* dest, const JSN_Value* src)
-{
-	FinalizeValue(chunk, dest);
-	dest->type = src->type;
+	JSN_ArenaBlock* block = (JSN_ArenaBlock*)SDL_malloc(sizeof(JSN_ArenaBlock) + block_size);
+	if (block == NULL)
+	{ return NULL; }
 
-	switch (src->type)
+	block->size = block_size;
+	block->used = size;
+
+	// Keep filling the current block if the new one is dedicated to this request.
+	if (chunk->blocks && block_size == size)
 	{
-		case JSN_TYPE_BOOL:
-			dest->bool_value = src->bool_value;
-			break;
+		block->next = chunk->blocks->next;
+		chunk->blocks->next = block;
+	}
+	else
+	{
+		block->next = chunk->blocks;
+		chunk->blocks = block;
+	}
 
-		case JSN_TYPE_INTEGER:
-			dest->integer_value = src->integer_value;
-			break;
+	return JSN_ArenaBlockData(block);
+}
 
-		case JSN_TYPE_NUMBER:
-			dest->number_value = src->number_value;
-			break;
 
-		case JSN_TYPE_STRING:
+static void* JSN_ChunkRealloc(JSN_Chunk* chunk, void* data, size_t size, size_t new_size, size_t align)
+{
+	// Grow in place when the data is the last allocation of the current block.
+	if (JSN_ArenaBlock* block = chunk->blocks)
+	{
+		char* end = JSN_ArenaBlockData(block) + block->used;
+		if (data && (char*)data + size == end && block->used - size + new_size <= block->size)
 		{
-			size_t length = SDL_strlen(src->string_value);
-			char* copy = (char*)SDL_calloc(length + 1, sizeof(char));
-			SDL_strlcpy(copy, src->string_value, length);
-			dest->string_value = copy;
-			break;
+			block->used += new_size - size;
+			return data;
 		}
-
-		case JSN_TYPE_ARRAY:
-			for (JSN_Element* el = src->array_value->first; el; el = el->next)
-			{
-				JSN_Value* value = JSN_ChunkAddElement(chunk, dest, NULL, NULL);
-				JSN_ChunkCopy(chunk, value, &el->value);
-			}
-			break;
-
-		case JSN_TYPE_OBJECT:
-			for (JSN_Property* prop = src->object_value->first; prop; prop = prop->next)
-			{
-				JSN_Value* value = JSN_ChunkAddProperty(chunk, dest, NULL, NULL, prop->key, SDL_strlen(prop->key));
-				JSN_ChunkCopy(chunk, value, &prop->value);
-			}
-			break;
 	}
 
-	return true;
+	void* grown = JSN_ChunkAlloc(chunk, new_size, align);
+	if (grown && size)
+	{ SDL_memcpy(grown, data, size); }
+
+	return grown;
 }
 
 
-JSN_Value* JSN_GetChunkRoot(JSN_Chunk* chunk)
+template<typename T>
+static T* JSN_ChunkNew(JSN_Chunk* chunk)
 {
-	return &chunk->root;
+	T* ptr = (T*)JSN_ChunkAlloc(chunk, sizeof(T), alignof(T));
+	SDL_zerop(ptr);
+	return ptr;
 }
 
 
-void JSN_ChunkSetNull(JSN_Chunk* chunk, JSN_Value* value)
+template<typename T>
+static T* JSN_ChunkNewArray(JSN_Chunk* chunk, size_t count)
 {
-	FinalizeValue(chunk, value);
-	value->type = JSN_TYPE_NULL;
+	return count ? (T*)JSN_ChunkAlloc(chunk, count * sizeof(T), alignof(T)) : NULL;
 }
 
 
-void JSN_ChunkSetBool(JSN_Chunk* chunk, JSN_Value* value, bool bool_value)
+template<typename T>
+static T* JSN_ChunkGrowArray(JSN_Chunk* chunk, T* data, size_t count, size_t* capacity)
 {
-	FinalizeValue(chunk, value);
-	value->type = JSN_TYPE_BOOL;
-	value->bool_value = bool_value;
+	size_t new_capacity = SDL_max(*capacity * 2, (size_t)4);
+	T* grown = (T*)JSN_ChunkRealloc(chunk, data, count * sizeof(T), new_capacity * sizeof(T), alignof(T));
+	*capacity = new_capacity;
+	return grown;
 }
 
 
-void JSN_ChunkSetInteger(JSN_Chunk* chunk, JSN_Value* value, int64_t integer_value)
+static const char* JSN_ChunkNewString(JSN_Chunk* chunk, const char* data, size_t length)
 {
-	FinalizeValue(chunk, value);
-	value->type = JSN_TYPE_INTEGER;
-	value->integer_value = integer_value;
+	char* copy = (char*)JSN_ChunkAlloc(chunk, length + 1, 1);
+	SDL_memcpy(copy, data, length);
+	copy[length] = '\0';
+	return copy;
 }
 
 
-void JSN_ChunkSetNumber(JSN_Chunk* chunk, JSN_Value* value, double number_value)
+static void JSN_ChunkFreeBlocks(JSN_ArenaBlock* block)
 {
-	FinalizeValue(chunk, value);
-	value->type = JSN_TYPE_NUMBER;
-	value->number_value = number_value;
+	while (block)
+	{
+		JSN_ArenaBlock* next = block->next;
+		SDL_free(block);
+		block = next;
+	}
 }
 
 
-void JSN_ChunkSetString(JSN_Chunk* chunk, JSN_Value* value, const char* string_value, size_t length)
+/**
+ * @brief Reset a value before it is overwritten.
+ * 
+ * @note Memory used by the previous value is left in the chunk's arena until the chunk is compacted.
+ */
+static void FinalizeValue(JSN_Chunk* chunk, JSN_Value* value)
 {
-	FinalizeValue(chunk, value);
-	value->type = JSN_TYPE_STRING;
-	char* copy = (char*)SDL_calloc(length + 1, sizeof(char));
-	SDL_strlcpy(copy, string_value, length);
-	value->string_value = copy;
+	SDL_zerop(value);
 }
 
 
-void JSN_ChunkSetArray(JSN_Chunk* chunk, JSN_Value* value)
-{
-	FinalizeValue(chunk, value);
-	value->type = JSN_TYPE_ARRAY;
-	value->array_value = (JSN_Array*)SDL_malloc(sizeof(JSN_Array));
-	SDL_zerop(value->array_value);
-}
+static bool JSN_LoadLazy(JSN_Lazy* lazy, const JSN_Value* value);
+static bool JSN_LoadShared(JSN_Lazy* lazy, const JSN_Value* value);
+static void JSN_ChunkReleaseShared(JSN_Chunk* chunk);
+static bool JSN_CopyValue(JSN_Chunk* chunk, JSN_Value* dest, const JSN_Value* src);
 
 
-void JSN_ChunkSetObject(JSN_Chunk* chunk, JSN_Value* value)
+/**
+ * @brief Read the children of a container of a lazy chunk, unless they've already been read.
+ */
+static bool JSN_LoadContainer(const JSN_Value* value)
 {
-	FinalizeValue(chunk, value);
-	value->type = JSN_TYPE_OBJECT;
-	value->object_value = (JSN_Object*)SDL_malloc(sizeof(JSN_Object));
-	SDL_zerop(value->object_value);
+	JSN_Lazy* lazy = NULL;
+
+	if (value->type == JSN_TYPE_ARRAY)
+	{ lazy = value->array_value->lazy; }
+	else if (value->type == JSN_TYPE_OBJECT)
+	{ lazy = value->object_value->lazy; }
+
+	return lazy == NULL || JSN_LoadLazy(lazy, value);
 }
 
 
-JSN_Value* JSN_ChunkAddElement(JSN_Chunk* chunk, JSN_Value* array_value, JSN_Element* whence, size_t* index)
+static uint32_t HashKey(const char* key, size_t length)
 {
-	SDL_assert(array_value && array_value->type == JSN_TYPE_ARRAY);
-	SDL_assert(!whence || whence->parent == array_value->array_value);
-
-	JSN_Array* array = array_value->array_value;
+	return SDL_murmur3_32(key, length, 0);
+}
 
-	JSN_Element* el = (JSN_Element*)SDL_malloc(sizeof(JSN_Element));
-	SDL_zerop(el);
-	el->parent = array;
-	el->index = array->count++;
 
-	if (whence == array->first)
-	{ array->first = el; }
+static bool KeyEquals(const JSN_Property* prop, const char* key, size_t length)
+{
+	return prop->key_length == length && SDL_memcmp(prop->key, key, length) == 0;
+}
 
-	if (whence == NULL)
-	{ array->last = el; }
 
-	el->next = whence;
+/**
+ * @brief Add the property at the given index to the hash index of its object, unless its key is already present.
+ */
+static void JSN_ObjectIndexInsert(JSN_Object* object, size_t i)
+{
+	const JSN_Property* prop = &object->properties[i];
+	size_t mask = object->index_capacity - 1;
+	size_t slot = HashKey(prop->key, prop->key_length) & mask;
 
-	if (index)
-	{ *index = el->index; }
+	for (; object->index[slot]; slot = (slot + 1) & mask)
+	{
+		if (KeyEquals(&object->properties[object->index[slot] - 1], prop->key, prop->key_length))
+		{ return; }
+	}
 
-	return &el->value;
+	object->index[slot] = (uint32_t)(i + 1);
 }
 
 
-JSN_Value* JSN_ChunkAddProperty(JSN_Chunk* chunk, JSN_Value* object_value, JSN_Property* whence, size_t* index, const char* key, size_t length)
+/**
+ * @brief (Re)build the hash index of an object, sized so that it stays at most half full until its storage grows.
+ */
+static void JSN_ChunkIndexObject(JSN_Chunk* chunk, JSN_Object* object)
 {
-	SDL_assert(object_value && object_value->type == JSN_TYPE_OBJECT);
-	SDL_assert(!whence || whence->parent == object_value->object_value);
+	size_t capacity = 16;
+	while (capacity < object->capacity * 2)
+	{ capacity *= 2; }
 
-	JSN_Object* object = object_value->object_value;
+	if (capacity != object->index_capacity)
+	{
+		object->index = JSN_ChunkNewArray<uint32_t>(chunk, capacity);
+		object->index_capacity = capacity;
+	}
 
-	JSN_Property* prop = (JSN_Property*)SDL_malloc(sizeof(JSN_Property));
-	SDL_zerop(prop);
-	prop->parent = object;
-	prop->index = object->count++;
+	SDL_memset(object->index, 0, capacity * sizeof(uint32_t));
 
-	char* copy = (char*)SDL_calloc(length + 1, sizeof(char));
-	SDL_strlcpy(copy, key, length);
-	prop->key = copy;
+	for (size_t i = 0; i < object->count; ++i)
+	{ JSN_ObjectIndexInsert(object, i); }
+}
 
-	if (whence == object->first)
-	{ object->first = prop; }
 
-	if (whence == NULL)
-	{ object->last = prop; }
+static JSN_Property* JSN_ObjectFind(const JSN_Object* object, const char* key, size_t length)
+{
+	if (object->index)
+	{
+		size_t mask = object->index_capacity - 1;
+		for (size_t slot = HashKey(key, length) & mask; object->index[slot]; slot = (slot + 1) & mask)
+		{
+			JSN_Property* prop = &object->properties[object->index[slot] - 1];
+			if (KeyEquals(prop, key, length))
+			{ return prop; }
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < object->count; ++i)
+		{
+			if (KeyEquals(&object->properties[i], key, length))
+			{ return &object->properties[i]; }
+		}
+	}
 
-	prop->next = whence;
+	return NULL;
+}
 
-	if (index)
-	{ *index = prop->index; }
 
-	return &prop->value;
+JSN_Chunk* JSN_CreateChunk()
+{
+	JSN_Chunk* chunk = (JSN_Chunk*)SDL_malloc(sizeof(JSN_Chunk));
+	SDL_zerop(chunk);
+	chunk->next_block_size = JSN_ARENA_MIN_BLOCK;
+	SDL_SetAtomicInt(&chunk->refs, 1);
+	return chunk;
 }
 
 
-/* ==================================================
-	JSON TOKENIZER IMPLEMENTATION
-================================================== */
-
-enum JSN_TokenType
+/**
+ * @brief Keep a chunk alive for as long as another one shares its values.
+ */
+static void JSN_ChunkRetain(JSN_Chunk* chunk, JSN_Chunk* shared)
 {
-	JSN_TOKEN_NONE = 0,
-
-	JSN_TOKEN_NULL,
-	JSN_TOKEN_BOOL,
-	JSN_TOKEN_INTEGER,
-	JSN_TOKEN_NUMBER,
-	JSN_TOKEN_STRING,
+	if (shared == chunk)
+	{ return; }
 
-	JSN_TOKEN_COMMA,
-	JSN_TOKEN_COLON,
+	for (JSN_ChunkRef* ref = chunk->retained; ref; ref = ref->next)
+	{
+		if (ref->chunk == shared)
+		{ return; }
+	}
 
-	JSN_TOKEN_ARRAY_OPEN,
-	JSN_TOKEN_ARRAY_CLOSE,
+	JSN_ChunkRef* ref = JSN_ChunkNew<JSN_ChunkRef>(chunk);
+	ref->chunk = shared;
+	ref->next = chunk->retained;
+	chunk->retained = ref;
 
-	JSN_TOKEN_OBJECT_OPEN,
-	JSN_TOKEN_OBJECT_CLOSE,
-};
+	SDL_AddAtomicInt(&shared->refs, 1);
+}
 
 
-struct JSN_Tokenizer
+static void JSN_ChunkReleaseRetained(JSN_Chunk* chunk)
 {
-	char* token_data;
-	size_t token_size;
-	size_t token_cap;
-};
+	for (JSN_ChunkRef* ref = chunk->retained; ref; ref = ref->next)
+	{ JSN_DestroyChunk(ref->chunk); }
+
+	chunk->retained = NULL;
+}
 
 
-static void JSN_TokenizerInit(JSN_Tokenizer* tokenizer)
+void JSN_DestroyChunk(JSN_Chunk* chunk)
 {
-	constexpr size_t init_length = 16;
+	// Chunks whose values are shared by others are only freed along with the last of them.
+	if (SDL_AddAtomicInt(&chunk->refs, -1) > 1)
+	{ return; }
 
-	tokenizer->token_data = (char*)SDL_calloc(init_length, sizeof(char));
-	tokenizer->token_cap = init_length;
+	if (chunk->source && chunk->closeio)
+	{ SDL_CloseIO(chunk->source); }
 
-	tokenizer->token_size = 0;
-	tokenizer->token_data[0] = '\0';
+	JSN_ChunkReleaseShared(chunk);
+	JSN_ChunkReleaseRetained(chunk);
+	JSN_ChunkFreeBlocks(chunk->blocks);
+	SDL_free(chunk);
 }
 
 
-static void JSN_TokenizerQuit(JSN_Tokenizer* tokenizer)
+bool JSN_ChunkCompact(JSN_Chunk* chunk)
 {
-	SDL_free(tokenizer->token_data);
-}
+	// Pending containers are built in the old arenas first, so that only their final values end up in the new ones.
+	if (!JSN_LoadValue(&chunk->root, true))
+	{ return false; }
 
+	JSN_ArenaBlock* blocks = chunk->blocks;
+	size_t next_block_size = chunk->next_block_size;
+	chunk->blocks = NULL;
+	chunk->next_block_size = JSN_ARENA_MIN_BLOCK;
 
-static void JSN_TokenizerReset(JSN_Tokenizer* tokenizer)
-{
-	constexpr size_t init_length = 16;
+	if (!JSN_CopyValue(chunk, &chunk->root, &chunk->root))
+	{
+		JSN_ChunkFreeBlocks(chunk->blocks);
+		chunk->blocks = blocks;
+		chunk->next_block_size = next_block_size;
+		return false;
+	}
+
+	// Other chunks may still share values of the old arenas, which are then kept until the chunk is destroyed.
+	if (SDL_GetAtomicInt(&chunk->refs) > 1)
+	{
+		JSN_ArenaBlock** tail = &chunk->blocks;
+		while (*tail)
+		{ tail = &(*tail)->next; }
 
-	tokenizer->token_data = (char*)SDL_realloc(tokenizer->token_data, init_length * sizeof(char));
-	tokenizer->token_cap = init_length;
+		*tail = blocks;
+		return true;
+	}
 
-	tokenizer->token_size = 0;
-	tokenizer->token_data[0] = '\0';
+	// Retained chunks & containers never built are listed in the old arenas, and nothing is shared with them anymore.
+	JSN_ChunkReleaseShared(chunk);
+	JSN_ChunkReleaseRetained(chunk);
+	JSN_ChunkFreeBlocks(blocks);
+	return true;
 }
 
 
-static void JSN_TokenizerAppend(JSN_Tokenizer* tokenizer, char c)
+/**
+ * @brief Make a value an empty array of the chunk, leaving the containers holding it as they are.
+ */
+static void JSN_InitArray(JSN_Chunk* chunk, JSN_Value* value)
 {
-	if (tokenizer->token_size == tokenizer->token_cap - 1)
-	{
-		tokenizer->token_cap *= 1.5;
-		tokenizer->token_data = (char*)SDL_realloc(tokenizer->token_data, tokenizer->token_cap * sizeof(char));
-	}
+	FinalizeValue(chunk, value);
+	value->type = JSN_TYPE_ARRAY;
+	value->array_value = JSN_ChunkNew<JSN_Array>(chunk);
+	value->array_value->chunk = chunk;
+}
 
-	tokenizer->token_data[tokenizer->token_size] = c;
-	tokenizer->token_data[++tokenizer->token_size] = '\0';
+
+/**
+ * @brief Make a value an empty object of the chunk, leaving the containers holding it as they are.
+ */
+static void JSN_InitObject(JSN_Chunk* chunk, JSN_Value* value)
+{
+	FinalizeValue(chunk, value);
+	value->type = JSN_TYPE_OBJECT;
+	value->object_value = JSN_ChunkNew<JSN_Object>(chunk);
+	value->object_value->chunk = chunk;
 }
 
 
-static void JSN_TokenizerReturn(JSN_Tokenizer* tokenizer, const char** start, size_t* length)
+/**
+ * @brief Give an object a copy of the index of another one, since indices are rebuilt in place as properties are added.
+ */
+static void JSN_ChunkCopyIndex(JSN_Chunk* chunk, JSN_Object* object, const JSN_Object* source)
 {
-	*start = tokenizer->token_data;
-	*length = tokenizer->token_size;
+	if (source->index == NULL)
+	{ return; }
+
+	object->index = JSN_ChunkNewArray<uint32_t>(chunk, source->index_capacity);
+	object->index_capacity = source->index_capacity;
+	SDL_memcpy(object->index, source->index, source->index_capacity * sizeof(uint32_t));
 }
 
 
-static JSN_TokenType NextToken(JSN_Tokenizer* tokenizer, SDL_IOStream* stream, const char** start, size_t* length)
+static bool JSN_CopyValue(JSN_Chunk* chunk, JSN_Value* dest, const JSN_Value* src)
 {
-	uint8_t c;
+	if (!JSN_LoadContainer(src))
+	{ return false; }
 
-	JSN_TokenizerReset(tokenizer);
+	// Copy the source first, in case it is being overwritten by one of its descendants.
+	JSN_Value copy = *src;
 
- start:
-	if (SDL_ReadU8(stream, &c))
+	switch (src->type)
 	{
-		if (c == ' ' || c == '\t' || c == '\n')
-		{
-			goto start;
-		}
-		else if (c == ',')
-		{
-			JSN_TokenizerAppend(tokenizer, c);
-			JSN_TokenizerReturn(tokenizer, start, length);
-			return JSN_TOKEN_COMMA;
-		}
-		else if (c == ':')
-		{
-			JSN_TokenizerAppend(tokenizer, c);
-			JSN_TokenizerReturn(tokenizer, start, length);
-			return JSN_TOKEN_COLON;
-		}
-		else if (c == '[')
-		{
-			JSN_TokenizerAppend(tokenizer, c);
-			JSN_TokenizerReturn(tokenizer, start, length);
-			return JSN_TOKEN_ARRAY_OPEN;
-		}
-		else if (c == ']')
-		{
-			JSN_TokenizerAppend(tokenizer, c);
-			JSN_TokenizerReturn(tokenizer, start, length);
-			return JSN_TOKEN_ARRAY_CLOSE;
-		}
-		else if (c == '{')
-		{
-			JSN_TokenizerAppend(tokenizer, c);
-			JSN_TokenizerReturn(tokenizer, start, length);
-			return JSN_TOKEN_OBJECT_OPEN;
-		}
-		else if (c == '}')
-		{
-			JSN_TokenizerAppend(tokenizer, c);
-			JSN_TokenizerReturn(tokenizer, start, length);
-			return JSN_TOKEN_OBJECT_CLOSE;
-		}
-		else if (SDL_isdigit(c) || c == '-' || c == '+')
+		case JSN_TYPE_STRING:
+			copy.string_value = JSN_ChunkNewString(chunk, src->string_value, src->string_length);
+			break;
+
+		case JSN_TYPE_ARRAY:
 		{
-			JSN_TokenType type = JSN_TOKEN_INTEGER;
+			const JSN_Array* array = src->array_value;
+			JSN_InitArray(chunk, &copy);
 
-			do
+			JSN_Array* array_copy = copy.array_value;
+			array_copy->values = JSN_ChunkNewArray<JSN_Value>(chunk, array->count);
+			array_copy->count = array_copy->capacity = array->count;
+
+			for (size_t i = 0; i < array->count; ++i)
 			{
-				if (c == '.' || c == 'e')
-				{ type = JSN_TOKEN_NUMBER; }
+				SDL_zero(array_copy->values[i]);
 
-				JSN_TokenizerAppend(tokenizer, c);
-				SDL_ReadU8(stream, &c);
+				if (!JSN_CopyValue(chunk, &array_copy->values[i], &array->values[i]))
+				{ return false; }
 			}
-			while (SDL_isdigit(c) || c == '.' || c == 'e' || c == 'x');
-
-			if (SDL_GetIOStatus(stream) != SDL_IO_STATUS_EOF)
-			{ SDL_SeekIO(stream, -1, SDL_IO_SEEK_CUR); }
-
-			JSN_TokenizerReturn(tokenizer, start, length);
-			return type;
+			break;
 		}
-		else if (SDL_isalpha(c) || c == '_')
+
+		case JSN_TYPE_OBJECT:
 		{
-			do
-			{
-				JSN_TokenizerAppend(tokenizer, c);
-				SDL_ReadU8(stream, &c);
-			}
-			while (SDL_isalnum(c) || c == '_');
+			const JSN_Object* object = src->object_value;
+			JSN_InitObject(chunk, &copy);
 
-			if (SDL_GetIOStatus(stream) != SDL_IO_STATUS_EOF)
-			{ SDL_SeekIO(stream, -1, SDL_IO_SEEK_CUR); }
+			JSN_Object* object_copy = copy.object_value;
+			object_copy->properties = JSN_ChunkNewArray<JSN_Property>(chunk, object->count);
+			object_copy->count = object_copy->capacity = object->count;
 
-			if (SDL_strcmp(tokenizer->token_data, "null") == 0)
-			{
-				JSN_TokenizerReturn(tokenizer, start, length);
-				return JSN_TOKEN_NULL;
-			}
-			else if (SDL_strcmp(tokenizer->token_data, "true") == 0)
-			{
-				JSN_TokenizerReturn(tokenizer, start, length);
-				return JSN_TOKEN_BOOL;
-			}
-			else if (SDL_strcmp(tokenizer->token_data, "false") == 0)
-			{
-				JSN_TokenizerReturn(tokenizer, start, length);
-				return JSN_TOKEN_BOOL;
-			}
-			else if (SDL_strcmp(tokenizer->token_data, "Infinity") == 0)
-			{
-				JSN_TokenizerReturn(tokenizer, start, length);
-				return JSN_TOKEN_NUMBER;
-			}
-			else if (SDL_strcmp(tokenizer->token_data, "NaN") == 0)
-			{
-				JSN_TokenizerReturn(tokenizer, start, length);
-				return JSN_TOKEN_NUMBER;
-			}
-			else
+			for (size_t i = 0; i < object->count; ++i)
 			{
-				SDL_SetError("unknown token encountered while reading JSON stream: %s", tokenizer->token_data);
-				return JSN_TOKEN_NONE;
+				const JSN_Property* prop = &object->properties[i];
+				JSN_Property* prop_copy = &object_copy->properties[i];
+				SDL_zerop(prop_copy);
+				prop_copy->key = JSN_ChunkNewString(chunk, prop->key, prop->key_length);
+				prop_copy->key_length = prop->key_length;
+
+				if (!JSN_CopyValue(chunk, &prop_copy->value, &prop->value))
+				{ return false; }
 			}
-		}
-		else if (c == '"')
-		{
-			JSN_TokenizerReturn(tokenizer, start, length);
-			return JSN_TOKEN_STRING;
-		}
-		else if (c >= 128)
-		{
-			// TODO: actually handle UTF8 character sequences
-			SDL_SetError("UTF8 character encountered while reading JSON stream");
-			return JSN_TOKEN_NONE;
+
+			if (object_copy->count > JSN_OBJECT_INDEX_THRESHOLD)
+			{ JSN_ChunkIndexObject(chunk, object_copy); }
+			break;
 		}
 	}
 
-	return JSN_TOKEN_NONE;
-}
+	FinalizeValue(chunk, dest);
+	*dest = copy;
 
+	return true;
+}
 
-/* ==================================================
-	JSON READER INTERFACE API
-================================================== */
 
-bool JSN_Read(SDL_IOStream* stream, const JSN_ReaderInterface* iface, void* userdata, bool closeio)
+/**
+ * @brief Call a function on each array & object among the children of a container.
+ */
+static void JSN_ForEachContainer(const JSN_Value* value, void (*callback)(const JSN_Value*))
 {
-	JSN_Tokenizer tokenizer;
-	JSN_TokenizerInit(&tokenizer);
+	if (value->type == JSN_TYPE_ARRAY)
+	{
+		const JSN_Array* array = value->array_value;
+
+		for (size_t i = 0; i < array->count; ++i)
+		{
+			if (array->values[i].type == JSN_TYPE_ARRAY || array->values[i].type == JSN_TYPE_OBJECT)
+			{ callback(&array->values[i]); }
+		}
+	}
+	else
+	{
+		const JSN_Object* object = value->object_value;
+
+		for (size_t i = 0; i < object->count; ++i)
+		{
+			const JSN_Value* child = &object->properties[i].value;
+
+			if (child->type == JSN_TYPE_ARRAY || child->type == JSN_TYPE_OBJECT)
+			{ callback(child); }
+		}
+	}
+}
+
+
+/**
+ * @brief Count a container of another chunk still to be built from this one, which is left unmodified until then.
+ */
+static void JSN_RetainShared(const JSN_Value* shared)
+{
+	if (shared->type == JSN_TYPE_ARRAY)
+	{
+		SDL_AddAtomicInt(&shared->array_value->shares, 1);
+		SDL_AddAtomicInt(&shared->array_value->chunk->shares, 1);
+	}
+	else
+	{
+		SDL_AddAtomicInt(&shared->object_value->shares, 1);
+		SDL_AddAtomicInt(&shared->object_value->chunk->shares, 1);
+	}
+}
+
+
+static void JSN_ReleaseShared(const JSN_Value* shared)
+{
+	bool detached;
+
+	if (shared->type == JSN_TYPE_ARRAY)
+	{
+		JSN_Array* array = shared->array_value;
+		SDL_AddAtomicInt(&array->chunk->shares, -1);
+		detached = SDL_AddAtomicInt(&array->shares, -1) == 1 && array->detached;
+	}
+	else
+	{
+		JSN_Object* object = shared->object_value;
+		SDL_AddAtomicInt(&object->chunk->shares, -1);
+		detached = SDL_AddAtomicInt(&object->shares, -1) == 1 && object->detached;
+	}
+
+	// Detached containers keep their children shared for as long as they're shared themselves.
+	if (detached)
+	{ JSN_ForEachContainer(shared, JSN_ReleaseShared); }
+}
+
+
+static bool JSN_IsShared(const JSN_Value* value)
+{
+	if (value->type == JSN_TYPE_ARRAY)
+	{ return SDL_GetAtomicInt(&value->array_value->shares) > 0; }
+
+	if (value->type == JSN_TYPE_OBJECT)
+	{ return SDL_GetAtomicInt(&value->object_value->shares) > 0; }
+
+	return false;
+}
+
+
+/**
+ * @brief Replace a shared container of the chunk by a copy of it, its children being shared in turn by both.
+ */
+static void JSN_DetachContainer(JSN_Chunk* chunk, JSN_Value* value)
+{
+	JSN_Value shared = *value;
+
+	if (shared.type == JSN_TYPE_ARRAY)
+	{
+		const JSN_Array* source = shared.array_value;
+		JSN_InitArray(chunk, value);
+
+		JSN_Array* array = value->array_value;
+		array->values = JSN_ChunkNewArray<JSN_Value>(chunk, source->count);
+		array->count = array->capacity = source->count;
+
+		for (size_t i = 0; i < source->count; ++i)
+		{ array->values[i] = source->values[i]; }
+
+		shared.array_value->detached = true;
+	}
+	else
+	{
+		const JSN_Object* source = shared.object_value;
+		JSN_InitObject(chunk, value);
+
+		JSN_Object* object = value->object_value;
+		object->properties = JSN_ChunkNewArray<JSN_Property>(chunk, source->count);
+		object->count = object->capacity = source->count;
+		JSN_ChunkCopyIndex(chunk, object, source);
+
+		for (size_t i = 0; i < source->count; ++i)
+		{ object->properties[i] = source->properties[i]; }
+
+		shared.object_value->detached = true;
+	}
+
+	JSN_ForEachContainer(value, JSN_RetainShared);
+}
+
+
+/**
+ * @brief Find the children leading from a container to one of its descendants, storing their indices outermost first.
+ * 
+ * @returns the depth of the descendant, or 0 if it isn't found.
+ */
+static size_t JSN_FindDescendant(const JSN_Value* value, const JSN_Value* descendant, size_t* indices, size_t depth)
+{
+	// Containers which haven't been built yet hold no value, and values nested deeper than can be written are left alone.
+	if (depth == JSN_MAX_DEPTH)
+	{ return 0; }
+
+	uintptr_t address = (uintptr_t)descendant;
+
+	if (value->type == JSN_TYPE_ARRAY && value->array_value->lazy == NULL)
+	{
+		const JSN_Array* array = value->array_value;
+
+		if (address >= (uintptr_t)array->values && address < (uintptr_t)(array->values + array->count))
+		{
+			indices[depth] = descendant - array->values;
+			return depth + 1;
+		}
+
+		for (size_t i = 0; i < array->count; ++i)
+		{
+			indices[depth] = i;
+
+			if (size_t found = JSN_FindDescendant(&array->values[i], descendant, indices, depth + 1))
+			{ return found; }
+		}
+	}
+	else if (value->type == JSN_TYPE_OBJECT && value->object_value->lazy == NULL)
+	{
+		const JSN_Object* object = value->object_value;
+
+		if (address >= (uintptr_t)object->properties && address < (uintptr_t)(object->properties + object->count))
+		{
+			indices[depth] = (address - (uintptr_t)object->properties) / sizeof(JSN_Property);
+			return depth + 1;
+		}
+
+		for (size_t i = 0; i < object->count; ++i)
+		{
+			indices[depth] = i;
+
+			if (size_t found = JSN_FindDescendant(&object->properties[i].value, descendant, indices, depth + 1))
+			{ return found; }
+		}
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Detach the shared containers leading to a value of the chunk, before the value is modified.
+ * 
+ * @note Values outside of the chunk's root, such as temporaries, are modified in place.
+ * 
+ * @returns the value, which may have moved along with the containers holding it.
+ */
+static JSN_Value* JSN_ChunkUnshare(JSN_Chunk* chunk, JSN_Value* value)
+{
+	// Chunks none of whose containers are shared are modified in place, without looking for the value.
+	if (SDL_GetAtomicInt(&chunk->shares) == 0 || value == &chunk->root)
+	{ return value; }
+
+	size_t indices[JSN_MAX_DEPTH];
+	size_t depth = JSN_FindDescendant(&chunk->root, value, indices, 0);
+
+	// Detaching a container shares its children in turn, so that only the containers leading to the value are detached.
+	JSN_Value* current = depth ? &chunk->root : value;
+
+	for (size_t i = 0; i < depth; ++i)
+	{
+		if (JSN_IsShared(current))
+		{ JSN_DetachContainer(chunk, current); }
+
+		if (current->type == JSN_TYPE_ARRAY)
+		{ current = &current->array_value->values[indices[i]]; }
+		else
+		{ current = &current->object_value->properties[indices[i]].value; }
+	}
+
+	return current;
+}
+
+
+/**
+ * @brief Detach the shared containers leading to a container of the chunk & the container itself, before its children are modified.
+ */
+static JSN_Value* JSN_ChunkUnshareContainer(JSN_Chunk* chunk, JSN_Value* value)
+{
+	value = JSN_ChunkUnshare(chunk, value);
+
+	if (JSN_IsShared(value))
+	{ JSN_DetachContainer(chunk, value); }
+
+	return value;
+}
+
+
+bool JSN_ChunkCopy(JSN_Chunk* chunk, JSN_Value* dest, const JSN_Value* src)
+{
+	return JSN_CopyValue(chunk, JSN_ChunkUnshare(chunk, dest), src);
+}
+
+
+/**
+ * @brief Get the container of another chunk whose children a container shares, or the container itself if it shares none.
+ */
+static const JSN_Value* JSN_SharedContainer(const JSN_Value* value)
+{
+	JSN_Lazy* lazy = value->type == JSN_TYPE_ARRAY ? value->array_value->lazy : value->object_value->lazy;
+	return lazy && lazy->shared.type != JSN_TYPE_EMPTY ? &lazy->shared : value;
+}
+
+
+/**
+ * @brief Make a new container of the chunk which shares the children of another one, until it's first accessed.
+ */
+static void JSN_ShareContainer(JSN_Chunk* chunk, JSN_Value* value, const JSN_Value* shared)
+{
+	bool empty;
+
+	if (shared->type == JSN_TYPE_ARRAY)
+	{
+		JSN_InitArray(chunk, value);
+		empty = shared->array_value->count == 0 && shared->array_value->lazy == NULL;
+	}
+	else
+	{
+		JSN_InitObject(chunk, value);
+		empty = shared->object_value->count == 0 && shared->object_value->lazy == NULL;
+	}
+
+	// Empty containers have nothing to share.
+	if (empty)
+	{ return; }
+
+	JSN_Lazy* lazy = JSN_ChunkNew<JSN_Lazy>(chunk);
+	lazy->shared = *shared;
+	lazy->next = chunk->sharing;
+	chunk->sharing = lazy;
+	JSN_RetainShared(shared);
+
+	if (value->type == JSN_TYPE_ARRAY)
+	{ value->array_value->lazy = lazy; }
+	else
+	{ value->object_value->lazy = lazy; }
+}
+
+
+/**
+ * @brief Share a child of another chunk's container, strings being shared as is since they're never modified in place.
+ */
+static void JSN_ShareValue(JSN_Chunk* chunk, JSN_Value* dest, const JSN_Value* src)
+{
+	SDL_zerop(dest);
+
+	if (src->type == JSN_TYPE_ARRAY || src->type == JSN_TYPE_OBJECT)
+	{ JSN_ShareContainer(chunk, dest, JSN_SharedContainer(src)); }
+	else
+	{ *dest = *src; }
+}
+
+
+/**
+ * @brief Build the children of a container from the ones of the container it shares, sharing their own children in turn.
+ */
+static bool JSN_LoadShared(JSN_Lazy* lazy, const JSN_Value* value)
+{
+	const JSN_Value* shared = &lazy->shared;
+
+	// Shared containers may still have to be read from a lazy chunk.
+	if (!JSN_LoadContainer(shared))
+	{ return false; }
+
+	if (value->type == JSN_TYPE_ARRAY)
+	{
+		const JSN_Array* source = shared->array_value;
+		JSN_Array* array = value->array_value;
+		JSN_Value* values = JSN_ChunkNewArray<JSN_Value>(array->chunk, source->count);
+
+		for (size_t i = 0; i < source->count; ++i)
+		{ JSN_ShareValue(array->chunk, &values[i], &source->values[i]); }
+
+		array->values = values;
+		array->count = array->capacity = source->count;
+		array->lazy = NULL;
+	}
+	else
+	{
+		const JSN_Object* source = shared->object_value;
+		JSN_Object* object = value->object_value;
+		JSN_Property* properties = JSN_ChunkNewArray<JSN_Property>(object->chunk, source->count);
+
+		for (size_t i = 0; i < source->count; ++i)
+		{
+			properties[i].key = source->properties[i].key;
+			properties[i].key_length = source->properties[i].key_length;
+			JSN_ShareValue(object->chunk, &properties[i].value, &source->properties[i].value);
+		}
+
+		JSN_ChunkCopyIndex(object->chunk, object, source);
+		object->properties = properties;
+		object->count = object->capacity = source->count;
+		object->lazy = NULL;
+	}
+
+	// The shared container may be modified in place from now on, unless other containers are still to be built from it.
+	JSN_ReleaseShared(shared);
+	SDL_zero(lazy->shared);
+
+	return true;
+}
+
+
+/**
+ * @brief Release the containers of other chunks which containers of this one were made to share, but were never built from.
+ */
+static void JSN_ChunkReleaseShared(JSN_Chunk* chunk)
+{
+	for (JSN_Lazy* lazy = chunk->sharing; lazy; lazy = lazy->next)
+	{
+		if (lazy->shared.type != JSN_TYPE_EMPTY)
+		{ JSN_ReleaseShared(&lazy->shared); }
+	}
+
+	chunk->sharing = NULL;
+}
+
+
+bool JSN_ChunkShare(JSN_Chunk* chunk, JSN_Value* dest, const JSN_Value* src)
+{
+	dest = JSN_ChunkUnshare(chunk, dest);
+
+	if (src->type != JSN_TYPE_ARRAY && src->type != JSN_TYPE_OBJECT)
+	{ return JSN_CopyValue(chunk, dest, src); }
+
+	const JSN_Value* shared = JSN_SharedContainer(src);
+	JSN_Chunk* owner = shared->type == JSN_TYPE_ARRAY ? shared->array_value->chunk : shared->object_value->chunk;
+
+	// Values are only shared from other chunks, & chunks whose own values are shared don't share any in turn,
+	// so that chunks never keep each other alive.
+	if (owner == chunk || SDL_GetAtomicInt(&chunk->refs) > 1)
+	{ return JSN_CopyValue(chunk, dest, src); }
+
+	JSN_Value copy;
+	SDL_zero(copy);
+	JSN_ShareContainer(chunk, &copy, shared);
+	JSN_ChunkRetain(chunk, owner);
+
+	FinalizeValue(chunk, dest);
+	*dest = copy;
+
+	return true;
+}
+
+
+JSN_Value* JSN_GetChunkRoot(JSN_Chunk* chunk)
+{
+	return &chunk->root;
+}
+
+
+void JSN_ChunkSetNull(JSN_Chunk* chunk, JSN_Value* value)
+{
+	value = JSN_ChunkUnshare(chunk, value);
+	FinalizeValue(chunk, value);
+	value->type = JSN_TYPE_NULL;
+}
+
+
+void JSN_ChunkSetBool(JSN_Chunk* chunk, JSN_Value* value, bool bool_value)
+{
+	value = JSN_ChunkUnshare(chunk, value);
+	FinalizeValue(chunk, value);
+	value->type = JSN_TYPE_BOOL;
+	value->bool_value = bool_value;
+}
+
+
+void JSN_ChunkSetInteger(JSN_Chunk* chunk, JSN_Value* value, int64_t integer_value)
+{
+	value = JSN_ChunkUnshare(chunk, value);
+	FinalizeValue(chunk, value);
+	value->type = JSN_TYPE_INTEGER;
+	value->integer_value = integer_value;
+}
+
+
+void JSN_ChunkSetNumber(JSN_Chunk* chunk, JSN_Value* value, double number_value)
+{
+	value = JSN_ChunkUnshare(chunk, value);
+	FinalizeValue(chunk, value);
+	value->type = JSN_TYPE_NUMBER;
+	value->number_value = number_value;
+}
+
+
+void JSN_ChunkSetString(JSN_Chunk* chunk, JSN_Value* value, const char* string_value, size_t length)
+{
+	value = JSN_ChunkUnshare(chunk, value);
+	FinalizeValue(chunk, value);
+	value->type = JSN_TYPE_STRING;
+	SDL_assert(length <= UINT32_MAX);
+	value->string_value = JSN_ChunkNewString(chunk, string_value, length);
+	value->string_length = (uint32_t)length;
+}
+
+
+void JSN_ChunkSetArray(JSN_Chunk* chunk, JSN_Value* value)
+{
+	JSN_InitArray(chunk, JSN_ChunkUnshare(chunk, value));
+}
+
+
+void JSN_ChunkSetObject(JSN_Chunk* chunk, JSN_Value* value)
+{
+	JSN_InitObject(chunk, JSN_ChunkUnshare(chunk, value));
+}
+
+
+JSN_Value* JSN_ChunkAddElement(JSN_Chunk* chunk, JSN_Value* array_value, size_t whence, size_t* index)
+{
+	// Containers detached from their chunk are only kept for the ones still to be built from them.
+	SDL_assert(array_value && array_value->type == JSN_TYPE_ARRAY && !array_value->array_value->detached);
+
+	if (!JSN_LoadContainer(array_value))
+	{ return NULL; }
+
+	array_value = JSN_ChunkUnshareContainer(chunk, array_value);
+	JSN_Array* array = array_value->array_value;
+
+	if (array->count == array->capacity)
+	{ array->values = JSN_ChunkGrowArray(chunk, array->values, array->count, &array->capacity); }
+
+	size_t i = SDL_min(whence, array->count);
+	SDL_memmove(&array->values[i + 1], &array->values[i], (array->count - i) * sizeof(JSN_Value));
+	array->count++;
+
+	JSN_Value* value = &array->values[i];
+	SDL_zerop(value);
+
+	if (index)
+	{ *index = i; }
+
+	return value;
+}
+
+
+JSN_Value* JSN_ChunkAddProperty(JSN_Chunk* chunk, JSN_Value* object_value, size_t whence, size_t* index, const char* key, size_t length)
+{
+	// Containers detached from their chunk are only kept for the ones still to be built from them.
+	SDL_assert(object_value && object_value->type == JSN_TYPE_OBJECT && !object_value->object_value->detached);
+
+	if (!JSN_LoadContainer(object_value))
+	{ return NULL; }
+
+	object_value = JSN_ChunkUnshareContainer(chunk, object_value);
+	JSN_Object* object = object_value->object_value;
+
+	bool grown = object->count == object->capacity;
+	if (grown)
+	{ object->properties = JSN_ChunkGrowArray(chunk, object->properties, object->count, &object->capacity); }
+
+	size_t i = SDL_min(whence, object->count);
+	SDL_memmove(&object->properties[i + 1], &object->properties[i], (object->count - i) * sizeof(JSN_Property));
+	object->count++;
+
+	JSN_Property* prop = &object->properties[i];
+	SDL_zerop(prop);
+	prop->key = JSN_ChunkNewString(chunk, key, length);
+	prop->key_length = length;
+
+	// Insertions anywhere but the end shift the indices of the following properties.
+	if (object->count > JSN_OBJECT_INDEX_THRESHOLD)
+	{
+		if (object->index == NULL || grown || i != object->count - 1)
+		{ JSN_ChunkIndexObject(chunk, object); }
+		else
+		{ JSN_ObjectIndexInsert(object, i); }
+	}
+
+	if (index)
+	{ *index = i; }
+
+	return &prop->value;
+}
+
+
+bool JSN_LoadValue(const JSN_Value* value, bool recursive)
+{
+	if (!JSN_LoadContainer(value))
+	{ return false; }
+
+	if (!recursive)
+	{ return true; }
+
+	if (value->type == JSN_TYPE_ARRAY)
+	{
+		const JSN_Array* array = value->array_value;
+
+		for (size_t i = 0; i < array->count; ++i)
+		{
+			if (!JSN_LoadValue(&array->values[i], true))
+			{ return false; }
+		}
+	}
+	else if (value->type == JSN_TYPE_OBJECT)
+	{
+		const JSN_Object* object = value->object_value;
+
+		for (size_t i = 0; i < object->count; ++i)
+		{
+			if (!JSN_LoadValue(&object->properties[i].value, true))
+			{ return false; }
+		}
+	}
+
+	return true;
+}
+
+
+JSN_Value* JSN_ArrayGet(const JSN_Value* array_value, size_t index)
+{
+	if (array_value->type != JSN_TYPE_ARRAY || !JSN_LoadContainer(array_value) || index >= array_value->array_value->count)
+	{ return NULL; }
+
+	return &array_value->array_value->values[index];
+}
+
+
+JSN_Value* JSN_ObjectGet(const JSN_Value* object_value, const char* key, size_t length)
+{
+	if (object_value->type != JSN_TYPE_OBJECT || !JSN_LoadContainer(object_value))
+	{ return NULL; }
+
+	JSN_Property* prop = JSN_ObjectFind(object_value->object_value, key, length);
+	return prop ? &prop->value : NULL;
+}
+
+
+/* ==================================================
+	JSON TOKENIZER IMPLEMENTATION
+================================================== */
+
+enum JSN_TokenType
+{
+	JSN_TOKEN_NONE = 0,
+
+	JSN_TOKEN_NULL,
+	JSN_TOKEN_BOOL,
+	JSN_TOKEN_NUMBER,
+	JSN_TOKEN_STRING,
+
+	JSN_TOKEN_COMMA,
+	JSN_TOKEN_COLON,
+
+	JSN_TOKEN_ARRAY_OPEN,
+	JSN_TOKEN_ARRAY_CLOSE,
+
+	JSN_TOKEN_OBJECT_OPEN,
+	JSN_TOKEN_OBJECT_CLOSE,
+};
+
+
+static const char* const token_names[]
+{
+	"end of input",
+	"null",
+	"boolean",
+	"number",
+	"string",
+	"','",
+	"':'",
+	"'['",
+	"']'",
+	"'{'",
+	"'}'",
+};
+
+
+/**
+ * @brief Size of the blocks read from streams that aren't backed by memory.
+ */
+constexpr size_t JSN_BLOCK_SIZE = 64 * 1024;
+
+/**
+ * @brief Size of the windows of memory input indexed at once.
+ */
+constexpr size_t JSN_INDEX_WINDOW = 16 * 1024;
+
+/**
+ * @brief Length of memory input past which the structural index is used.
+ */
+constexpr size_t JSN_INDEX_MIN_LENGTH = 4 * 1024;
+
+/**
+ * @brief Size of the scratch blocks kept by each thread, serving as stream buffers & structural indices.
+ */
+constexpr size_t JSN_SCRATCH_BLOCK_SIZE = SDL_max(JSN_BLOCK_SIZE, JSN_INDEX_WINDOW * sizeof(uint32_t)) + 256;
+
+/**
+ * @brief Size of the scratch buffer within each tokenizer, before tokens that need to be copied outgrow it.
+ */
+constexpr size_t JSN_TOKEN_SCRATCH_SIZE = 256;
+
+
+/**
+ * @brief Character classes used by the tokenizer to scan spans of characters.
+ */
+enum JSN_CharClass : uint8_t
+{
+	JSN_CLASS_SPACE = 1 << 0,
+	JSN_CLASS_NUMBER = 1 << 1,
+	JSN_CLASS_IDENT = 1 << 2,
+	JSN_CLASS_STRING = 1 << 3,		/**< Characters that end a plain run within a string. */
+	JSN_CLASS_DELIMITER = 1 << 4,	/**< Characters that may follow a scalar. */
+};
+
+
+struct JSN_CharTable
+{
+	uint8_t classes[256];
+
+	constexpr JSN_CharTable() : classes()
+	{
+		classes[' '] = classes['\t'] = classes['\n'] = classes['\r'] = JSN_CLASS_SPACE;
+
+		for (int c = '0'; c <= '9'; ++c)
+		{ classes[c] = JSN_CLASS_NUMBER|JSN_CLASS_IDENT; }
+
+		for (int c = 'a'; c <= 'z'; ++c)
+		{ classes[c] = JSN_CLASS_IDENT; }
+
+		for (int c = 'A'; c <= 'Z'; ++c)
+		{ classes[c] = JSN_CLASS_IDENT; }
+
+		classes['_'] = JSN_CLASS_IDENT;
+		classes['.'] = classes['+'] = classes['-'] = JSN_CLASS_NUMBER;
+		classes['e'] = classes['E'] = JSN_CLASS_NUMBER|JSN_CLASS_IDENT;
+
+		for (int c = 0; c < 0x20; ++c)
+		{ classes[c] |= JSN_CLASS_STRING; }
+
+		classes['"'] = classes['\\'] = JSN_CLASS_STRING;
+
+		const char delimiters[] = " \t\n\r,:[]{}\"";
+		for (size_t i = 0; i < sizeof(delimiters) - 1; ++i)
+		{ classes[(uint8_t)delimiters[i]] |= JSN_CLASS_DELIMITER; }
+	}
+};
+
+
+static constexpr JSN_CharTable char_table;
+
+
+struct JSN_StructuralIndex;
+
+
+/**
+ * @brief Large scratch block of the last read on this thread, reused by the next one instead of allocating another.
+ * 
+ * @note Blocks serve either as the refill buffer of streams or as the structural index of memory input.
+ */
+struct JSN_ScratchCache
+{
+	void* block = NULL;
+
+	~JSN_ScratchCache()
+	{ SDL_free(block); }
+};
+
+
+static thread_local JSN_ScratchCache scratch_cache;
+
+
+static void* JSN_AcquireScratch()
+{
+	void* block = scratch_cache.block;
+	scratch_cache.block = NULL;
+	return block ? block : SDL_malloc(JSN_SCRATCH_BLOCK_SIZE);
+}
+
+
+static void JSN_ReleaseScratch(void* block)
+{
+	// Reads nested within the callbacks of another read may release a second block.
+	if (scratch_cache.block == NULL)
+	{ scratch_cache.block = block; }
+	else
+	{ SDL_free(block); }
+}
+
+
+struct JSN_Tokenizer
+{
+	SDL_IOStream* stream;		/**< Stream to refill from, NULL when reading memory directly. */
+	char* block;				/**< Refill buffer, NULL when reading memory directly. */
+	const char* cursor;			/**< Next character to be read. */
+	const char* end;			/**< End of the readable characters. */
+	const char* mark;			/**< Start of the token being read, from which reading resumes once more input is fed. */
+	const char* origin;			/**< Start of the current block, or of the memory being read. */
+	Sint64 offset;				/**< Offset of the origin within the input. */
+	bool insitu;				/**< Whether the input may be overwritten to decode strings in place. */
+	bool partial;				/**< Whether more memory input may follow, in which case running out of it isn't an error. */
+	bool starved;				/**< Whether partial input ran out in the middle of a token. */
+	bool failed;				/**< Whether an error was encountered. */
+	JSN_StructuralIndex* index;	/**< Structural index of large memory input, may be NULL. */
+
+	char* token_data;			/**< Scratch buffer for tokens straddling two blocks or containing escapes. */
+	size_t token_size;
+	size_t token_cap;
+	char token_scratch[JSN_TOKEN_SCRATCH_SIZE];		/**< Initial scratch buffer, only outgrown by long tokens. */
+};
+
+
+static JSN_StructuralIndex* JSN_CreateStructuralIndex(const char* mem, size_t length);
+
+
+static void JSN_TokenizerInitMem(JSN_Tokenizer* tokenizer, const void* mem, size_t length)
+{
+	SDL_zerop(tokenizer);
+	tokenizer->cursor = tokenizer->origin = (const char*)mem;
+	tokenizer->end = tokenizer->cursor + length;
+
+	if (length >= JSN_INDEX_MIN_LENGTH)
+	{ tokenizer->index = JSN_CreateStructuralIndex(tokenizer->cursor, length); }
+}
+
+
+static void JSN_TokenizerInit(JSN_Tokenizer* tokenizer, SDL_IOStream* stream)
+{
+	// Streams created from memory expose their buffer, which we can read in place.
+	SDL_PropertiesID props = SDL_GetIOProperties(stream);
+	const char* mem = (const char*)SDL_GetPointerProperty(props, SDL_PROP_IOSTREAM_MEMORY_POINTER, NULL);
+	Sint64 size = SDL_GetNumberProperty(props, SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER, -1);
+	Sint64 offset = mem && size >= 0 ? SDL_TellIO(stream) : -1;
+
+	if (offset >= 0 && offset <= size)
+	{
+		JSN_TokenizerInitMem(tokenizer, mem + offset, (size_t)(size - offset));
+		tokenizer->offset = offset;
+		SDL_SeekIO(stream, 0, SDL_IO_SEEK_END);
+		return;
+	}
+
+	SDL_zerop(tokenizer);
+	tokenizer->stream = stream;
+	tokenizer->block = (char*)JSN_AcquireScratch();
+	tokenizer->cursor = tokenizer->end = tokenizer->origin = tokenizer->block;
+	tokenizer->offset = SDL_TellIO(stream);
+}
+
+
+static void JSN_TokenizerQuit(JSN_Tokenizer* tokenizer)
+{
+	if (tokenizer->token_data != tokenizer->token_scratch)
+	{ SDL_free(tokenizer->token_data); }
+
+	if (tokenizer->block)
+	{ JSN_ReleaseScratch(tokenizer->block); }
+
+	if (tokenizer->index)
+	{ JSN_ReleaseScratch(tokenizer->index); }
+}
+
+
+static bool JSN_TokenizerFail(JSN_Tokenizer* tokenizer, const char* what)
+{
+	// Tokens cut short by the end of partial input are resumed once more of it is fed.
+	if (tokenizer->starved)
+	{ return false; }
+
+	tokenizer->failed = true;
+	return SDL_SetError("%s while reading JSON stream", what);
+}
+
+
+static bool JSN_TokenizerRefill(JSN_Tokenizer* tokenizer)
+{
+	if (tokenizer->stream == NULL)
+	{
+		tokenizer->starved = tokenizer->partial;
+		return false;
+	}
+
+	tokenizer->offset += tokenizer->end - tokenizer->block;
+
+	size_t size = SDL_ReadIO(tokenizer->stream, tokenizer->block, JSN_BLOCK_SIZE);
+	tokenizer->cursor = tokenizer->block;
+	tokenizer->end = tokenizer->block + size;
+
+	if (size == 0)
+	{
+		if (SDL_GetIOStatus(tokenizer->stream) != SDL_IO_STATUS_EOF)
+		{ tokenizer->failed = true; }
+
+		tokenizer->stream = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Get the offset within the input of the next character to be read.
+ */
+static Sint64 JSN_TokenizerTell(const JSN_Tokenizer* tokenizer)
+{
+	return tokenizer->offset + (tokenizer->cursor - tokenizer->origin);
+}
+
+
+static bool JSN_TokenizerGet(JSN_Tokenizer* tokenizer, char* c)
+{
+	if (tokenizer->cursor == tokenizer->end && !JSN_TokenizerRefill(tokenizer))
+	{ return false; }
+
+	*c = *tokenizer->cursor++;
+	return true;
+}
+
+
+static void JSN_TokenizerAppend(JSN_Tokenizer* tokenizer, const char* data, size_t size)
+{
+	if (tokenizer->token_cap == 0)
+	{
+		tokenizer->token_data = tokenizer->token_scratch;
+		tokenizer->token_cap = sizeof(tokenizer->token_scratch);
+	}
+
+	// Grown buffers are kept for the rest of the read, so that only the longest token allocates.
+	if (tokenizer->token_size + size + 1 > tokenizer->token_cap)
+	{
+		size_t cap = SDL_max(tokenizer->token_cap * 2, tokenizer->token_size + size + 1);
+		char* data = (char*)SDL_malloc(cap * sizeof(char));
+		SDL_memcpy(data, tokenizer->token_data, tokenizer->token_size);
+
+		if (tokenizer->token_data != tokenizer->token_scratch)
+		{ SDL_free(tokenizer->token_data); }
+
+		tokenizer->token_data = data;
+		tokenizer->token_cap = cap;
+	}
+
+	SDL_memcpy(tokenizer->token_data + tokenizer->token_size, data, size);
+	tokenizer->token_size += size;
+	tokenizer->token_data[tokenizer->token_size] = '\0';
+}
+
+
+/**
+ * @brief Consume the longest span of characters of the given classes.
+ * 
+ * @note The span points into the input when possible, or into the scratch buffer when it straddles two blocks.
+ */
+static void JSN_TokenizerSpan(JSN_Tokenizer* tokenizer, uint8_t mask, const char** start, size_t* length)
+{
+	const char* first = tokenizer->cursor;
+	bool spilled = false;
+
+	for (;;)
+	{
+		const char* p = tokenizer->cursor;
+		const char* end = tokenizer->end;
+
+		while (p != end && (char_table.classes[(uint8_t)*p] & mask))
+		{ ++p; }
+
+		tokenizer->cursor = p;
+
+		if (p != end)
+		{ break; }
+
+		if (tokenizer->stream == NULL)
+		{
+			tokenizer->starved = tokenizer->partial;
+			break;
+		}
+
+		// Token continues past the end of this block, stash it before refilling.
+		if (!spilled)
+		{ tokenizer->token_size = 0; spilled = true; }
+
+		JSN_TokenizerAppend(tokenizer, first, p - first);
+
+		if (!JSN_TokenizerRefill(tokenizer))
+		{ break; }
+
+		first = tokenizer->cursor;
+	}
+
+	if (spilled)
+	{
+		JSN_TokenizerAppend(tokenizer, first, tokenizer->cursor - first);
+		*start = tokenizer->token_data;
+		*length = tokenizer->token_size;
+	}
+	else
+	{
+		*start = first;
+		*length = tokenizer->cursor - first;
+	}
+}
+
+
+static size_t EncodeUTF8(uint32_t codepoint, char* out)
+{
+	if (codepoint < 0x80)
+	{
+		out[0] = (char)codepoint;
+		return 1;
+	}
+	else if (codepoint < 0x800)
+	{
+		out[0] = (char)(0xC0 | (codepoint >> 6));
+		out[1] = (char)(0x80 | (codepoint & 0x3F));
+		return 2;
+	}
+	else if (codepoint < 0x10000)
+	{
+		out[0] = (char)(0xE0 | (codepoint >> 12));
+		out[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+		out[2] = (char)(0x80 | (codepoint & 0x3F));
+		return 3;
+	}
+	else
+	{
+		out[0] = (char)(0xF0 | (codepoint >> 18));
+		out[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+		out[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+		out[3] = (char)(0x80 | (codepoint & 0x3F));
+		return 4;
+	}
+}
+
+
+static bool JSN_TokenizerHex4(JSN_Tokenizer* tokenizer, uint32_t* value)
+{
+	*value = 0;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		char c;
+		if (!JSN_TokenizerGet(tokenizer, &c))
+		{ return false; }
+
+		uint32_t digit;
+		if (c >= '0' && c <= '9')
+		{ digit = c - '0'; }
+		else if (c >= 'a' && c <= 'f')
+		{ digit = c - 'a' + 10; }
+		else if (c >= 'A' && c <= 'F')
+		{ digit = c - 'A' + 10; }
+		else
+		{ return false; }
+
+		*value = (*value << 4) | digit;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Decode the escape sequence following a backslash into UTF-8.
+ * 
+ * @returns the number of bytes written to out, or zero on failure.
+ */
+static size_t JSN_TokenizerEscape(JSN_Tokenizer* tokenizer, char* out)
+{
+	char c;
+	if (!JSN_TokenizerGet(tokenizer, &c))
+	{ return 0; }
+
+	switch (c)
+	{
+		case '"':  out[0] = '"';  return 1;
+		case '\\': out[0] = '\\'; return 1;
+		case '/':  out[0] = '/';  return 1;
+		case 'b':  out[0] = '\b'; return 1;
+		case 'f':  out[0] = '\f'; return 1;
+		case 'n':  out[0] = '\n'; return 1;
+		case 'r':  out[0] = '\r'; return 1;
+		case 't':  out[0] = '\t'; return 1;
+
+		case 'u':
+		{
+			uint32_t codepoint;
+			if (!JSN_TokenizerHex4(tokenizer, &codepoint))
+			{ return 0; }
+
+			// Characters outside the BMP are escaped as a pair of UTF-16 surrogates.
+			if (codepoint >= 0xD800 && codepoint <= 0xDBFF)
+			{
+				char backslash, u;
+				uint32_t low;
+
+				if (!JSN_TokenizerGet(tokenizer, &backslash) || backslash != '\\' ||
+					!JSN_TokenizerGet(tokenizer, &u) || u != 'u' ||
+					!JSN_TokenizerHex4(tokenizer, &low) || low < 0xDC00 || low > 0xDFFF)
+				{ return 0; }
+
+				codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+			}
+			else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF)
+			{
+				return 0;
+			}
+
+			return EncodeUTF8(codepoint, out);
+		}
+
+		default:
+			return 0;
+	}
+}
+
+
+/**
+ * @brief Find the first character ending a plain run within a string, 32 or 16 characters at a time.
+ */
+static const char* JSN_SkipPlain(const char* p, const char* end)
+{
+#if defined(__AVX2__)
+	const __m256i quote = _mm256_set1_epi8('"');
+	const __m256i backslash = _mm256_set1_epi8('\\');
+	const __m256i control = _mm256_set1_epi8(0x1F);
+
+	for (; end - p >= 32; p += 32)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i*)p);
+		__m256i stop = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash));
+		stop = _mm256_or_si256(stop, _mm256_cmpeq_epi8(_mm256_max_epu8(v, control), control));
+
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(stop);
+		if (mask)
+		{ return p + std::countr_zero(mask); }
+	}
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i control = _mm_set1_epi8(0x1F);
+
+	for (; end - p >= 16; p += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)p);
+		__m128i stop = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash));
+		stop = _mm_or_si128(stop, _mm_cmpeq_epi8(_mm_max_epu8(v, control), control));
+
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(stop);
+		if (mask)
+		{ return p + std::countr_zero(mask); }
+	}
+#endif
+
+	while (p != end && !(char_table.classes[(uint8_t)*p] & JSN_CLASS_STRING))
+	{ ++p; }
+
+	return p;
+}
+
+
+/**
+ * @brief Consume a string token, the opening quote having already been consumed.
+ * 
+ * @note Strings without escapes are returned as views into the input whenever possible.
+ *  Otherwise they are decoded in place when the input may be overwritten, or into the scratch buffer.
+ *  Strings decoded in place are also null-terminated.
+ */
+static bool JSN_TokenizerString(JSN_Tokenizer* tokenizer, const char** start, size_t* length)
+{
+	const char* first = tokenizer->cursor;
+	const char* p = JSN_SkipPlain(first, tokenizer->end);
+
+	if (p != tokenizer->end && *p == '"')
+	{
+		if (tokenizer->insitu)
+		{ *(char*)p = '\0'; }
+
+		*start = first;
+		*length = p - first;
+		tokenizer->cursor = p + 1;
+		return true;
+	}
+
+	// Decoded characters are written behind the cursor in place, or appended to the scratch buffer.
+	char* write = tokenizer->insitu ? (char*)p : NULL;
+	tokenizer->cursor = p;
+
+	if (!tokenizer->insitu)
+	{
+		tokenizer->token_size = 0;
+		JSN_TokenizerAppend(tokenizer, first, p - first);
+	}
+
+	for (;;)
+	{
+		const char* run = tokenizer->cursor;
+		p = JSN_SkipPlain(run, tokenizer->end);
+
+		if (write)
+		{
+			SDL_memmove(write, run, p - run);
+			write += p - run;
+		}
+		else
+		{
+			JSN_TokenizerAppend(tokenizer, run, p - run);
+		}
+
+		tokenizer->cursor = p;
+
+		if (p == tokenizer->end)
+		{
+			if (!JSN_TokenizerRefill(tokenizer))
+			{ return JSN_TokenizerFail(tokenizer, "unterminated string encountered"); }
+
+			continue;
+		}
+
+		char c = *tokenizer->cursor++;
+
+		if (c == '"')
+		{ break; }
+
+		if (c != '\\')
+		{ return JSN_TokenizerFail(tokenizer, "control character encountered in string"); }
+
+		char decoded[4];
+		size_t size = JSN_TokenizerEscape(tokenizer, decoded);
+
+		if (size == 0)
+		{ return JSN_TokenizerFail(tokenizer, "invalid escape sequence encountered in string"); }
+
+		if (write)
+		{
+			SDL_memcpy(write, decoded, size);
+			write += size;
+		}
+		else
+		{
+			JSN_TokenizerAppend(tokenizer, decoded, size);
+		}
+	}
+
+	if (write)
+	{
+		*write = '\0';
+		*start = first;
+		*length = write - first;
+	}
+	else
+	{
+		*start = tokenizer->token_data;
+		*length = tokenizer->token_size;
+	}
+
+	return true;
+}
+
+
+static bool TokenEquals(const char* start, size_t length, const char* literal, size_t literal_length)
+{
+	return length == literal_length && SDL_memcmp(start, literal, length) == 0;
+}
+
+
+static JSN_TokenType ScanToken(JSN_Tokenizer* tokenizer, const char** start, size_t* length)
+{
+	// Skip whitespace, refilling as many times as needed.
+	for (;;)
+	{
+		while (tokenizer->cursor != tokenizer->end && (char_table.classes[(uint8_t)*tokenizer->cursor] & JSN_CLASS_SPACE))
+		{ ++tokenizer->cursor; }
+
+		if (tokenizer->cursor != tokenizer->end)
+		{ break; }
+
+		if (!JSN_TokenizerRefill(tokenizer))
+		{ return JSN_TOKEN_NONE; }
+	}
+
+	uint8_t c = *tokenizer->cursor;
+
+	*start = tokenizer->cursor;
+	*length = 1;
+
+	switch (c)
+	{
+		case ',':
+			++tokenizer->cursor;
+			return JSN_TOKEN_COMMA;
+
+		case ':':
+			++tokenizer->cursor;
+			return JSN_TOKEN_COLON;
+
+		case '[':
+			++tokenizer->cursor;
+			return JSN_TOKEN_ARRAY_OPEN;
+
+		case ']':
+			++tokenizer->cursor;
+			return JSN_TOKEN_ARRAY_CLOSE;
+
+		case '{':
+			++tokenizer->cursor;
+			return JSN_TOKEN_OBJECT_OPEN;
+
+		case '}':
+			++tokenizer->cursor;
+			return JSN_TOKEN_OBJECT_CLOSE;
+
+		case '"':
+			++tokenizer->cursor;
+			return JSN_TokenizerString(tokenizer, start, length) ? JSN_TOKEN_STRING : JSN_TOKEN_NONE;
+	}
+
+	if (SDL_isdigit(c) || c == '-' || c == '+')
+	{
+		JSN_TokenizerSpan(tokenizer, JSN_CLASS_NUMBER, start, length);
+		return tokenizer->starved ? JSN_TOKEN_NONE : JSN_TOKEN_NUMBER;
+	}
+	else if (SDL_isalpha(c) || c == '_')
+	{
+		JSN_TokenizerSpan(tokenizer, JSN_CLASS_IDENT, start, length);
+
+		if (tokenizer->starved)
+		{ return JSN_TOKEN_NONE; }
+		else if (TokenEquals(*start, *length, "null", 4))
+		{ return JSN_TOKEN_NULL; }
+		else if (TokenEquals(*start, *length, "true", 4))
+		{ return JSN_TOKEN_BOOL; }
+		else if (TokenEquals(*start, *length, "false", 5))
+		{ return JSN_TOKEN_BOOL; }
+		else if (TokenEquals(*start, *length, "Infinity", 8))
+		{ return JSN_TOKEN_NUMBER; }
+		else if (TokenEquals(*start, *length, "NaN", 3))
+		{ return JSN_TOKEN_NUMBER; }
+
+		SDL_SetError("unknown token encountered while reading JSON stream: %.*s", (int)*length, *start);
+	}
+	else if (c >= 128)
+	{
+		SDL_SetError("non-ASCII character encountered outside of a string while reading JSON stream");
+	}
+	else
+	{
+		SDL_SetError("unexpected character encountered while reading JSON stream: %c", c);
+	}
+
+	tokenizer->failed = true;
+	return JSN_TOKEN_NONE;
+}
+
+
+/* ==================================================
+	JSON NUMBER IMPLEMENTATION
+================================================== */
+
+/**
+ * @brief Powers of ten that are exactly representable as doubles.
+ */
+static const double exact_powers_of_ten[]
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+
+static bool IsDigit(char c)
+{ return (unsigned)(c - '0') < 10; }
+
+
+/**
+ * @brief Convert a numeric token into an integer or number value, following the JSON grammar strictly.
+ * 
+ * @note Digits are accumulated directly from the input. Integers that overflow 64 bits are promoted to numbers.
+ *  Numbers with few enough digits & a small exponent are computed exactly with a single multiplication or division,
+ *  any other number falls back to std::from_chars which rounds correctly.
+ */
+static bool JSN_ParseNumber(const char* start, size_t length, JSN_Value* value)
+{
+	const char* p = start;
+	const char* end = start + length;
+
+	if (TokenEquals(start, length, "Infinity", 8) || TokenEquals(start, length, "NaN", 3))
+	{
+		value->type = JSN_TYPE_NUMBER;
+		value->number_value = *start == 'I' ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+		return true;
+	}
+
+	bool negative = p != end && *p == '-';
+	if (negative)
+	{ ++p; }
+
+	if (p == end || !IsDigit(*p))
+	{ return false; }
+
+	// Leading zeros aren't allowed, so a zero is always the whole integer part.
+	const char* digits = p;
+	uint64_t mantissa = 0;
+
+	if (*p == '0')
+	{ ++p; }
+	else
+	{
+		for (; p != end && IsDigit(*p); ++p)
+		{ mantissa = mantissa * 10 + (uint64_t)(*p - '0'); }
+	}
+
+	size_t digit_count = p - digits;
+	int64_t exponent = 0;
+	bool integer = true;
+
+	if (p != end && *p == '.')
+	{
+		const char* fraction = ++p;
+
+		for (; p != end && IsDigit(*p); ++p)
+		{ mantissa = mantissa * 10 + (uint64_t)(*p - '0'); }
+
+		if (p == fraction)
+		{ return false; }
+
+		digit_count += p - fraction;
+		exponent = -(int64_t)(p - fraction);
+		integer = false;
+	}
+
+	if (p != end && (*p == 'e' || *p == 'E'))
+	{
+		bool negative_exponent = false;
+
+		if (++p != end && (*p == '+' || *p == '-'))
+		{ negative_exponent = *p++ == '-'; }
+
+		const char* exponent_digits = p;
+		int64_t explicit_exponent = 0;
+
+		for (; p != end && IsDigit(*p); ++p)
+		{
+			if (explicit_exponent < 100000)
+			{ explicit_exponent = explicit_exponent * 10 + (*p - '0'); }
+		}
+
+		if (p == exponent_digits)
+		{ return false; }
+
+		exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+		integer = false;
+	}
+
+	if (p != end)
+	{ return false; }
+
+	// Up to 19 digits can't wrap around 64 bits, past that the mantissa is meaningless.
+	if (integer && digit_count <= 19 && mantissa <= (negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX))
+	{
+		value->type = JSN_TYPE_INTEGER;
+		value->integer_value = negative ? (int64_t)(0 - mantissa) : (int64_t)mantissa;
+		return true;
+	}
+
+	value->type = JSN_TYPE_NUMBER;
+
+	if (digit_count <= 19 && mantissa <= (uint64_t)1 << 53)
+	{
+		// Move excess powers of ten into the mantissa while it remains exact, e.g. 12e30.
+		while (exponent > 22 && mantissa != 0 && mantissa * 10 <= (uint64_t)1 << 53)
+		{ mantissa *= 10; --exponent; }
+
+		if (exponent >= -22 && exponent <= 22)
+		{
+			double number = (double)mantissa;
+			number = exponent < 0 ? number / exact_powers_of_ten[-exponent] : number * exact_powers_of_ten[exponent];
+			value->number_value = negative ? -number : number;
+			return true;
+		}
+	}
+
+	std::from_chars_result result = std::from_chars(start, end, value->number_value);
+
+	if (result.ec == std::errc::result_out_of_range)
+	{
+		// Magnitudes too large overflow to infinity, those too small underflow to zero.
+		double number = (int64_t)digit_count + exponent > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+		value->number_value = negative ? -number : number;
+	}
+
+	return true;
+}
+
+
+/* ==================================================
+	JSON UTF-8 VALIDATION IMPLEMENTATION
+================================================== */
+
+#if !defined(__AVX2__)
+
+/**
+ * @brief Validate a single UTF-8 sequence, rejecting overlong encodings, surrogates & code points past U+10FFFF.
+ * 
+ * @returns the end of the sequence, or NULL if it is malformed.
+ */
+static const uint8_t* JSN_ValidateUTF8Sequence(const uint8_t* p, const uint8_t* end)
+{
+	uint8_t c = *p;
+	uint8_t low = 0x80, high = 0xBF;
+	size_t size;
+
+	if (c < 0x80)
+	{ return p + 1; }
+	else if (c >= 0xC2 && c <= 0xDF)
+	{ size = 2; }
+	else if (c >= 0xE0 && c <= 0xEF)
+	{
+		size = 3;
+		if (c == 0xE0) { low = 0xA0; }
+		else if (c == 0xED) { high = 0x9F; }
+	}
+	else if (c >= 0xF0 && c <= 0xF4)
+	{
+		size = 4;
+		if (c == 0xF0) { low = 0x90; }
+		else if (c == 0xF4) { high = 0x8F; }
+	}
+	else
+	{ return NULL; }
+
+	if ((size_t)(end - p) < size || p[1] < low || p[1] > high)
+	{ return NULL; }
+
+	for (size_t i = 2; i < size; ++i)
+	{
+		if ((p[i] & 0xC0) != 0x80)
+		{ return NULL; }
+	}
+
+	return p + size;
+}
+
+#else
+
+/**
+ * @brief Error bits of the lookup tables, as described in "Validating UTF-8 In Less Than One Instruction Per Byte".
+ */
+enum JSN_UTF8Error : uint8_t
+{
+	JSN_UTF8_TOO_SHORT = 1 << 0,		/**< 11______ 0_______ or 11______ 11______ */
+	JSN_UTF8_TOO_LONG = 1 << 1,			/**< 0_______ 10______ */
+	JSN_UTF8_OVERLONG_3 = 1 << 2,		/**< 11100000 100_____ */
+	JSN_UTF8_TOO_LARGE = 1 << 3,		/**< 11110100 1001____ and above */
+	JSN_UTF8_SURROGATE = 1 << 4,		/**< 11101101 101_____ */
+	JSN_UTF8_OVERLONG_2 = 1 << 5,		/**< 1100000_ 10______ */
+	JSN_UTF8_TOO_LARGE_1000 = 1 << 6,	/**< 11110101 1000____ and above */
+	JSN_UTF8_OVERLONG_4 = 1 << 6,		/**< 11110000 1000____ */
+	JSN_UTF8_TWO_CONTS = 1 << 7,		/**< 10______ 10______ */
+	JSN_UTF8_CARRY = JSN_UTF8_TOO_SHORT|JSN_UTF8_TOO_LONG|JSN_UTF8_TWO_CONTS,
+};
+
+
+alignas(16) static const uint8_t utf8_byte_1_high[16]
+{
+	JSN_UTF8_TOO_LONG, JSN_UTF8_TOO_LONG, JSN_UTF8_TOO_LONG, JSN_UTF8_TOO_LONG,
+	JSN_UTF8_TOO_LONG, JSN_UTF8_TOO_LONG, JSN_UTF8_TOO_LONG, JSN_UTF8_TOO_LONG,
+	JSN_UTF8_TWO_CONTS, JSN_UTF8_TWO_CONTS, JSN_UTF8_TWO_CONTS, JSN_UTF8_TWO_CONTS,
+	JSN_UTF8_TOO_SHORT|JSN_UTF8_OVERLONG_2,
+	JSN_UTF8_TOO_SHORT,
+	JSN_UTF8_TOO_SHORT|JSN_UTF8_OVERLONG_3|JSN_UTF8_SURROGATE,
+	JSN_UTF8_TOO_SHORT|JSN_UTF8_TOO_LARGE|JSN_UTF8_TOO_LARGE_1000|JSN_UTF8_OVERLONG_4,
+};
+
+alignas(16) static const uint8_t utf8_byte_1_low[16]
+{
+	JSN_UTF8_CARRY|JSN_UTF8_OVERLONG_3|JSN_UTF8_OVERLONG_2|JSN_UTF8_OVERLONG_4,
+	JSN_UTF8_CARRY|JSN_UTF8_OVERLONG_2,
+	JSN_UTF8_CARRY,
+	JSN_UTF8_CARRY,
+	JSN_UTF8_CARRY|JSN_UTF8_TOO_LARGE,
+	JSN_UTF8_CARRY|JSN_UTF8_TOO_LARGE|JSN_UTF8_TOO_LARGE_1000,
+	JSN_UTF8_CARRY|JSN_UTF8_TOO_LARGE|JSN_UTF8_TOO_LARGE_1000,
+	JSN_UTF8_CARRY|JSN_UTF8_TOO_LARGE|JSN_UTF8_TOO_LARGE_1000,
+	JSN_UTF8_CARRY|JSN_UTF8_TOO_LARGE|JSN_UTF8_TOO_LARGE_1000,
+	JSN_UTF8_CARRY|JSN_UTF8_TOO_LARGE|JSN_UTF8_TOO_LARGE_1000,
+	JSN_UTF8_CARRY|JSN_UTF8_TOO_LARGE|JSN_UTF8_TOO_LARGE_1000,
+	JSN_UTF8_CARRY|JSN_UTF8_TOO_LARGE|JSN_UTF8_TOO_LARGE_1000,
+	JSN_UTF8_CARRY|JSN_UTF8_TOO_LARGE|JSN_UTF8_TOO_LARGE_1000,
+	JSN_UTF8_CARRY|JSN_UTF8_TOO_LARGE|JSN_UTF8_TOO_LARGE_1000|JSN_UTF8_SURROGATE,
+	JSN_UTF8_CARRY|JSN_UTF8_TOO_LARGE|JSN_UTF8_TOO_LARGE_1000,
+	JSN_UTF8_CARRY|JSN_UTF8_TOO_LARGE|JSN_UTF8_TOO_LARGE_1000,
+};
+
+alignas(16) static const uint8_t utf8_byte_2_high[16]
+{
+	JSN_UTF8_TOO_SHORT, JSN_UTF8_TOO_SHORT, JSN_UTF8_TOO_SHORT, JSN_UTF8_TOO_SHORT,
+	JSN_UTF8_TOO_SHORT, JSN_UTF8_TOO_SHORT, JSN_UTF8_TOO_SHORT, JSN_UTF8_TOO_SHORT,
+	JSN_UTF8_TOO_LONG|JSN_UTF8_OVERLONG_2|JSN_UTF8_TWO_CONTS|JSN_UTF8_OVERLONG_3|JSN_UTF8_TOO_LARGE_1000|JSN_UTF8_OVERLONG_4,
+	JSN_UTF8_TOO_LONG|JSN_UTF8_OVERLONG_2|JSN_UTF8_TWO_CONTS|JSN_UTF8_OVERLONG_3|JSN_UTF8_TOO_LARGE,
+	JSN_UTF8_TOO_LONG|JSN_UTF8_OVERLONG_2|JSN_UTF8_TWO_CONTS|JSN_UTF8_SURROGATE|JSN_UTF8_TOO_LARGE,
+	JSN_UTF8_TOO_LONG|JSN_UTF8_OVERLONG_2|JSN_UTF8_TWO_CONTS|JSN_UTF8_SURROGATE|JSN_UTF8_TOO_LARGE,
+	JSN_UTF8_TOO_SHORT, JSN_UTF8_TOO_SHORT, JSN_UTF8_TOO_SHORT, JSN_UTF8_TOO_SHORT,
+};
+
+
+struct JSN_UTF8Validator
+{
+	__m256i error;
+	__m256i prev_input;
+	__m256i prev_incomplete;
+};
+
+
+/**
+ * @brief Validate 32 bytes of input against the previous 32, using three nibble lookups per byte.
+ */
+static void JSN_ValidateUTF8Block(JSN_UTF8Validator* validator, __m256i input)
+{
+	if (_mm256_movemask_epi8(input) == 0)
+	{
+		// Pure ASCII, only a sequence cut short at the end of the previous block can be an error.
+		validator->error = _mm256_or_si256(validator->error, validator->prev_incomplete);
+		validator->prev_incomplete = _mm256_setzero_si256();
+		validator->prev_input = input;
+		return;
+	}
+
+	const __m256i nibble = _mm256_set1_epi8(0x0F);
+	const __m256i byte_1_high = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)utf8_byte_1_high));
+	const __m256i byte_1_low = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)utf8_byte_1_low));
+	const __m256i byte_2_high = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)utf8_byte_2_high));
+
+	// Bytes preceding each byte of the input, shifted in from the previous block.
+	__m256i carried = _mm256_permute2x128_si256(validator->prev_input, input, 0x21);
+	__m256i prev1 = _mm256_alignr_epi8(input, carried, 15);
+	__m256i prev2 = _mm256_alignr_epi8(input, carried, 14);
+	__m256i prev3 = _mm256_alignr_epi8(input, carried, 13);
+
+	__m256i special = _mm256_and_si256(
+		_mm256_and_si256(
+			_mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+			_mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, nibble))),
+		_mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+
+	// Third & fourth bytes of multibyte sequences must be continuations, and nothing else may be.
+	__m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+	__m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+	__m256i must_continue = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+
+	validator->error = _mm256_or_si256(validator->error, _mm256_xor_si256(must_continue, special));
+
+	// Lead bytes too close to the end of the block to be complete.
+	const __m256i max_value = _mm256_setr_epi8(
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+
+	validator->prev_incomplete = _mm256_subs_epu8(input, max_value);
+	validator->prev_input = input;
+}
+
+#endif
+
+
+/**
+ * @brief Check whether the given data is well-formed UTF-8.
+ * 
+ * @note With AVX2 the whole input is validated 32 bytes at a time. Otherwise runs of ASCII are skipped
+ *  16 bytes at a time, and only multibyte sequences are validated one at a time.
+ */
+static bool JSN_ValidateUTF8(const char* data, size_t length)
+{
+	const uint8_t* p = (const uint8_t*)data;
+	const uint8_t* end = p + length;
+
+#if defined(__AVX2__)
+	JSN_UTF8Validator validator;
+	validator.error = _mm256_setzero_si256();
+	validator.prev_input = _mm256_setzero_si256();
+	validator.prev_incomplete = _mm256_setzero_si256();
+
+	for (; end - p >= 32; p += 32)
+	{ JSN_ValidateUTF8Block(&validator, _mm256_loadu_si256((const __m256i*)p)); }
+
+	if (p != end)
+	{
+		// Pad the tail with ASCII, so that sequences cut short by the end of the data are caught.
+		alignas(32) uint8_t tail[32] {};
+		SDL_memcpy(tail, p, end - p);
+		JSN_ValidateUTF8Block(&validator, _mm256_load_si256((const __m256i*)tail));
+	}
+
+	validator.error = _mm256_or_si256(validator.error, validator.prev_incomplete);
+	return _mm256_testz_si256(validator.error, validator.error);
+#else
+	while (p != end)
+	{
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		while (end - p >= 16)
+		{
+			uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)p));
+			if (mask)
+			{ p += std::countr_zero(mask); break; }
+
+			p += 16;
+		}
+
+		if (p == end)
+		{ break; }
+#endif
+
+		p = JSN_ValidateUTF8Sequence(p, end);
+
+		if (p == NULL)
+		{ return false; }
+	}
+
+	return true;
+#endif
+}
+
+
+/* ==================================================
+	JSON STRUCTURAL INDEX IMPLEMENTATION
+================================================== */
+
+/**
+ * @brief Positions of the structural characters, quotes & scalar starts of a window of memory input.
+ * 
+ * @note The index is built 64 bytes at a time using SIMD comparisons, after which tokens are read
+ *  directly at each indexed position instead of scanning the input one character at a time.
+ */
+struct JSN_StructuralIndex
+{
+	const char* base;			/**< Start of the memory input. */
+	size_t length;				/**< Length of the memory input. */
+	size_t window;				/**< Offset of the current window. */
+	size_t indexed;				/**< Offset up to which the input has been indexed. */
+	size_t count;				/**< Number of positions in the current window. */
+	size_t next;				/**< Next position to be read. */
+	uint64_t prev_escaped;		/**< Whether the first character of the next block is escaped. */
+	uint64_t prev_in_string;	/**< All ones if the next block starts within a string, zero otherwise. */
+	uint64_t prev_scalar;		/**< Whether the last character of the previous block is part of a scalar. */
+	bool backslashes;			/**< Whether the current window contains any backslash. */
+	uint32_t positions[JSN_INDEX_WINDOW];
+};
+
+
+static_assert(sizeof(JSN_StructuralIndex) <= JSN_SCRATCH_BLOCK_SIZE, "structural index must fit in a scratch block");
+
+
+struct JSN_BlockMasks
+{
+	uint64_t quote;
+	uint64_t backslash;
+	uint64_t op;
+	uint64_t space;
+	uint64_t control;
+};
+
+
+#if defined(__AVX2__)
+
+static void ClassifyBlock(const char* block, JSN_BlockMasks* masks)
+{
+	uint64_t quote[2], backslash[2], op[2], space[2], control[2];
+
+	for (int i = 0; i < 2; ++i)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i*)(block + i * 32));
+		auto eq = [v](char c) { return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c)); };
+
+		__m256i ops = _mm256_or_si256(_mm256_or_si256(eq('{'), eq('}')), _mm256_or_si256(eq('['), eq(']')));
+		ops = _mm256_or_si256(ops, _mm256_or_si256(eq(':'), eq(',')));
+		__m256i ws = _mm256_or_si256(_mm256_or_si256(eq(' '), eq('\t')), _mm256_or_si256(eq('\n'), eq('\r')));
+		__m256i ctl = _mm256_cmpeq_epi8(_mm256_max_epu8(v, _mm256_set1_epi8(0x1F)), _mm256_set1_epi8(0x1F));
+
+		quote[i] = (uint32_t)_mm256_movemask_epi8(eq('"'));
+		backslash[i] = (uint32_t)_mm256_movemask_epi8(eq('\\'));
+		op[i] = (uint32_t)_mm256_movemask_epi8(ops);
+		space[i] = (uint32_t)_mm256_movemask_epi8(ws);
+		control[i] = (uint32_t)_mm256_movemask_epi8(ctl);
+	}
+
+	masks->quote = quote[0] | (quote[1] << 32);
+	masks->backslash = backslash[0] | (backslash[1] << 32);
+	masks->op = op[0] | (op[1] << 32);
+	masks->space = space[0] | (space[1] << 32);
+	masks->control = control[0] | (control[1] << 32);
+}
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+static void ClassifyBlock(const char* block, JSN_BlockMasks* masks)
+{
+	SDL_zerop(masks);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(block + i * 16));
+		auto eq = [v](char c) { return _mm_cmpeq_epi8(v, _mm_set1_epi8(c)); };
+
+		__m128i ops = _mm_or_si128(_mm_or_si128(eq('{'), eq('}')), _mm_or_si128(eq('['), eq(']')));
+		ops = _mm_or_si128(ops, _mm_or_si128(eq(':'), eq(',')));
+		__m128i ws = _mm_or_si128(_mm_or_si128(eq(' '), eq('\t')), _mm_or_si128(eq('\n'), eq('\r')));
+		__m128i ctl = _mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F));
+
+		int shift = i * 16;
+		masks->quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(eq('"')) << shift;
+		masks->backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(eq('\\')) << shift;
+		masks->op |= (uint64_t)(uint16_t)_mm_movemask_epi8(ops) << shift;
+		masks->space |= (uint64_t)(uint16_t)_mm_movemask_epi8(ws) << shift;
+		masks->control |= (uint64_t)(uint16_t)_mm_movemask_epi8(ctl) << shift;
+	}
+}
+
+#else
+
+static void ClassifyBlock(const char* block, JSN_BlockMasks* masks)
+{
+	SDL_zerop(masks);
+
+	for (int i = 0; i < 64; ++i)
+	{
+		uint8_t c = block[i];
+		uint64_t bit = (uint64_t)1 << i;
+
+		switch (c)
+		{
+			case '"':  masks->quote |= bit; break;
+			case '\\': masks->backslash |= bit; break;
+			case '{': case '}': case '[': case ']': case ':': case ',': masks->op |= bit; break;
+			case ' ': case '\t': case '\n': case '\r': masks->space |= bit; break;
+		}
+
+		if (c < 0x20)
+		{ masks->control |= bit; }
+	}
+}
+
+#endif
+
+
+/**
+ * @brief Turn a mask of quotes into a mask of the characters between each pair of quotes, opening quotes included.
+ */
+static uint64_t PrefixXor(uint64_t mask)
+{
+	mask ^= mask << 1;
+	mask ^= mask << 2;
+	mask ^= mask << 4;
+	mask ^= mask << 8;
+	mask ^= mask << 16;
+	mask ^= mask << 32;
+	return mask;
+}
+
+
+/**
+ * @brief Find the characters of a block escaped by a backslash, carrying over to the next block.
+ */
+static uint64_t FindEscaped(uint64_t backslash, uint64_t* prev_escaped)
+{
+	uint64_t escaped = *prev_escaped;
+	backslash &= ~escaped;
+	*prev_escaped = 0;
+
+	while (backslash)
+	{
+		int i = std::countr_zero(backslash);
+
+		if (i == 63)
+		{
+			*prev_escaped = 1;
+			break;
+		}
+
+		// The character following a backslash is escaped, and cannot itself escape another.
+		escaped |= (uint64_t)2 << i;
+		backslash &= ~((uint64_t)3 << i);
+	}
+
+	return escaped;
+}
+
+
+static JSN_StructuralIndex* JSN_CreateStructuralIndex(const char* mem, size_t length)
+{
+	JSN_StructuralIndex* index = (JSN_StructuralIndex*)JSN_AcquireScratch();
+
+	if (index)
+	{
+		SDL_zerop(index);
+		index->base = mem;
+		index->length = length;
+	}
+
+	return index;
+}
+
+
+/**
+ * @brief Index the next window of input, starting at the given cursor if the last token went past the indexed input.
+ * 
+ * @returns false at the end of the input or on failure.
+ */
+static bool JSN_IndexWindow(JSN_Tokenizer* tokenizer, JSN_StructuralIndex* index)
+{
+	size_t cursor = tokenizer->cursor - index->base;
+
+	// Tokens read past the indexed input always end outside of strings & scalars.
+	if (cursor > index->indexed)
+	{
+		index->indexed = cursor;
+		index->prev_escaped = index->prev_in_string = index->prev_scalar = 0;
+	}
+
+	if (index->indexed >= index->length)
+	{ return false; }
+
+	index->window = index->indexed;
+	index->count = index->next = 0;
+	index->backslashes = false;
+
+	size_t end = SDL_min(index->window + JSN_INDEX_WINDOW, index->length);
+
+	for (size_t offset = index->window; offset < end; offset += 64)
+	{
+		JSN_BlockMasks masks;
+
+		if (end - offset >= 64)
+		{
+			ClassifyBlock(index->base + offset, &masks);
+		}
+		else
+		{
+			// Pad the last block with whitespace, which is never indexed.
+			char block[64];
+			SDL_memset(block, ' ', sizeof(block));
+			SDL_memcpy(block, index->base + offset, end - offset);
+			ClassifyBlock(block, &masks);
+		}
+
+		uint64_t escaped = FindEscaped(masks.backslash, &index->prev_escaped);
+		uint64_t quote = masks.quote & ~escaped;
+		uint64_t in_string = PrefixXor(quote) ^ index->prev_in_string;
+		index->prev_in_string = (uint64_t)((int64_t)in_string >> 63);
+
+		if (masks.control & in_string)
+		{ return JSN_TokenizerFail(tokenizer, "control character encountered in string"); }
+
+		uint64_t op = masks.op & ~in_string;
+		uint64_t scalar = ~(op | masks.space | quote | in_string);
+		uint64_t scalar_start = scalar & ~((scalar << 1) | index->prev_scalar);
+		index->prev_scalar = scalar >> 63;
+		index->backslashes |= masks.backslash != 0;
+
+		uint32_t base = (uint32_t)(offset - index->window);
+
+		for (uint64_t bits = op | quote | scalar_start; bits; bits &= bits - 1)
+		{ index->positions[index->count++] = base + std::countr_zero(bits); }
+	}
+
+	index->indexed = end;
+	return true;
+}
+
+
+static JSN_TokenType ScanToken(JSN_Tokenizer* tokenizer, const char** start, size_t* length);
+
+
+/**
+ * @brief Read the next token at the next indexed position.
+ */
+static JSN_TokenType NextIndexedToken(JSN_Tokenizer* tokenizer, JSN_StructuralIndex* index, const char** start, size_t* length)
+{
+	const char* window = index->base + index->window;
+
+	for (;;)
+	{
+		// Skip positions already consumed by the previous token.
+		while (index->next < index->count && window + index->positions[index->next] < tokenizer->cursor)
+		{ ++index->next; }
+
+		if (index->next < index->count)
+		{ break; }
+
+		if (!JSN_IndexWindow(tokenizer, index))
+		{
+			tokenizer->cursor = tokenizer->end;
+			return JSN_TOKEN_NONE;
+		}
+
+		window = index->base + index->window;
+	}
+
+	const char* p = window + index->positions[index->next++];
+
+	if (*p == '"')
+	{
+		// The closing quote is the next position, unless the string ends past this window.
+		if (index->next < index->count)
+		{
+			const char* close = window + index->positions[index->next];
+
+			if (!index->backslashes || !std::memchr(p + 1, '\\', close - p - 1))
+			{
+				if (tokenizer->insitu)
+				{ *(char*)close = '\0'; }
+
+				*start = p + 1;
+				*length = close - p - 1;
+				tokenizer->cursor = close + 1;
+				++index->next;
+				return JSN_TOKEN_STRING;
+			}
+		}
+
+		tokenizer->cursor = p + 1;
+		return JSN_TokenizerString(tokenizer, start, length) ? JSN_TOKEN_STRING : JSN_TOKEN_NONE;
+	}
+
+	tokenizer->cursor = p;
+	JSN_TokenType token = ScanToken(tokenizer, start, length);
+
+	// Scalars must be followed by a delimiter, as characters past them aren't indexed.
+	if (token >= JSN_TOKEN_NULL && token <= JSN_TOKEN_NUMBER && tokenizer->cursor != tokenizer->end &&
+		!(char_table.classes[(uint8_t)*tokenizer->cursor] & JSN_CLASS_DELIMITER))
+	{
+		SDL_SetError("unexpected character encountered while reading JSON stream: %c", *tokenizer->cursor);
+		tokenizer->failed = true;
+		return JSN_TOKEN_NONE;
+	}
+
+	return token;
+}
+
+
+static JSN_TokenType NextToken(JSN_Tokenizer* tokenizer, const char** start, size_t* length)
+{
+	JSN_TokenType token = tokenizer->index
+		? NextIndexedToken(tokenizer, tokenizer->index, start, length)
+		: ScanToken(tokenizer, start, length);
+
+	if (token == JSN_TOKEN_STRING && !JSN_ValidateUTF8(*start, *length))
+	{
+		SDL_SetError("invalid UTF-8 sequence encountered in string while reading JSON stream");
+		tokenizer->failed = true;
+		return JSN_TOKEN_NONE;
+	}
+
+	return token;
+}
+
+
+/* ==================================================
+	JSON GRAMMAR IMPLEMENTATION
+================================================== */
+
+enum JSN_GrammarState : uint8_t
+{
+	JSN_EXPECT_VALUE,
+	JSN_EXPECT_VALUE_OR_CLOSE,
+	JSN_EXPECT_KEY,
+	JSN_EXPECT_KEY_OR_CLOSE,
+	JSN_EXPECT_COLON,
+	JSN_EXPECT_COMMA_OR_CLOSE,
+	JSN_EXPECT_END,
+};
+
+
+struct JSN_Scope
+{
+	size_t count;		/**< Number of values in this container so far. */
+	bool object;		/**< Whether this container is an object or an array. */
+};
+
+
+/**
+ * @brief Validates a sequence of tokens, keeping track of open containers.
+ */
+struct JSN_Grammar
+{
+	JSN_GrammarState state;
+	size_t depth;
+	size_t closed_count;	/**< Number of values in the last closed container. */
+	JSN_Scope scopes[JSN_MAX_DEPTH];
+};
+
+
+static void JSN_GrammarInit(JSN_Grammar* grammar)
+{
+	// Scopes are left uninitialized until they're opened.
+	grammar->state = JSN_EXPECT_VALUE;
+	grammar->depth = 0;
+	grammar->closed_count = 0;
+}
+
+
+/**
+ * @brief Whether the next string token is the key of a property.
+ */
+static bool JSN_GrammarExpectsKey(const JSN_Grammar* grammar)
+{
+	return grammar->state == JSN_EXPECT_KEY || grammar->state == JSN_EXPECT_KEY_OR_CLOSE;
+}
+
+
+static void JSN_GrammarEndValue(JSN_Grammar* grammar)
+{
+	if (grammar->depth == 0)
+	{
+		grammar->state = JSN_EXPECT_END;
+	}
+	else
+	{
+		grammar->scopes[grammar->depth - 1].count++;
+		grammar->state = JSN_EXPECT_COMMA_OR_CLOSE;
+	}
+}
+
+
+static bool JSN_GrammarAccept(JSN_Grammar* grammar, JSN_TokenType token)
+{
+	JSN_Scope* top = grammar->depth ? &grammar->scopes[grammar->depth - 1] : NULL;
+
+	switch (token)
+	{
+		case JSN_TOKEN_COMMA:
+			if (grammar->state != JSN_EXPECT_COMMA_OR_CLOSE)
+			{ break; }
+
+			grammar->state = top->object ? JSN_EXPECT_KEY : JSN_EXPECT_VALUE;
+			return true;
+
+		case JSN_TOKEN_COLON:
+			if (grammar->state != JSN_EXPECT_COLON)
+			{ break; }
+
+			grammar->state = JSN_EXPECT_VALUE;
+			return true;
+
+		case JSN_TOKEN_ARRAY_CLOSE:
+		case JSN_TOKEN_OBJECT_CLOSE:
+		{
+			bool object = token == JSN_TOKEN_OBJECT_CLOSE;
+			bool empty = grammar->state == (object ? JSN_EXPECT_KEY_OR_CLOSE : JSN_EXPECT_VALUE_OR_CLOSE);
+
+			if (!top || top->object != object || (grammar->state != JSN_EXPECT_COMMA_OR_CLOSE && !empty))
+			{ break; }
+
+			grammar->closed_count = top->count;
+			grammar->depth--;
+			JSN_GrammarEndValue(grammar);
+			return true;
+		}
+
+		case JSN_TOKEN_STRING:
+			if (JSN_GrammarExpectsKey(grammar))
+			{
+				grammar->state = JSN_EXPECT_COLON;
+				return true;
+			}
+			[[fallthrough]];
+
+		default:
+			if (grammar->state != JSN_EXPECT_VALUE && grammar->state != JSN_EXPECT_VALUE_OR_CLOSE)
+			{ break; }
+
+			if (token == JSN_TOKEN_ARRAY_OPEN || token == JSN_TOKEN_OBJECT_OPEN)
+			{
+				if (grammar->depth == JSN_MAX_DEPTH)
+				{ return SDL_SetError("nesting deeper than %d levels encountered while reading JSON stream", JSN_MAX_DEPTH); }
+
+				bool object = token == JSN_TOKEN_OBJECT_OPEN;
+				grammar->scopes[grammar->depth++] = JSN_Scope{ 0, object };
+				grammar->state = object ? JSN_EXPECT_KEY_OR_CLOSE : JSN_EXPECT_VALUE_OR_CLOSE;
+				return true;
+			}
+
+			JSN_GrammarEndValue(grammar);
+			return true;
+	}
+
+	return SDL_SetError("unexpected %s encountered while reading JSON stream", token_names[token]);
+}
+
+
+/**
+ * @brief Check that the input ended at a valid point, an empty input being valid.
+ */
+static bool JSN_GrammarFinish(const JSN_Grammar* grammar)
+{
+	if (grammar->depth == 0 && (grammar->state == JSN_EXPECT_END || grammar->state == JSN_EXPECT_VALUE))
+	{ return true; }
+
+	return SDL_SetError("unexpected end of input encountered while reading JSON stream");
+}
+
+
+/* ==================================================
+	JSON READER INTERFACE API
+================================================== */
+
+static bool JSN_ReadTokens(JSN_Tokenizer* tokenizer, JSN_Grammar* grammar, const JSN_ReaderInterface* iface, void* userdata)
+{
+	const char* token_data;
+	size_t token_size;
+
+	JSN_Value value;
+	SDL_zero(value);
+
+	for (;;)
+	{
+		tokenizer->mark = tokenizer->cursor;
+		JSN_TokenType token = NextToken(tokenizer, &token_data, &token_size);
+
+		// Partial input is only checked to be complete once all of it has been fed.
+		if (token == JSN_TOKEN_NONE)
+		{ return !tokenizer->failed && (tokenizer->starved || JSN_GrammarFinish(grammar)); }
+
+		bool key = token == JSN_TOKEN_STRING && JSN_GrammarExpectsKey(grammar);
+
+		if (!JSN_GrammarAccept(grammar, token))
+		{ return false; }
+
+		switch (token)
+		{
+			case JSN_TOKEN_NULL:
+				value.type = JSN_TYPE_NULL;
+				if (!iface->value(userdata, &value))
+				{ return false; }
+				break;
+
+			case JSN_TOKEN_BOOL:
+				value.type = JSN_TYPE_BOOL;
+				value.bool_value = token_data[0] == 't';
+				if (!iface->value(userdata, &value))
+				{ return false; }
+				break;
+
+			case JSN_TOKEN_NUMBER:
+				if (!JSN_ParseNumber(token_data, token_size, &value))
+				{ return SDL_SetError("invalid number encountered while reading JSON stream: %.*s", (int)token_size, token_data); }
+				if (!iface->value(userdata, &value))
+				{ return false; }
+				break;
+
+			case JSN_TOKEN_STRING:
+				if (key)
+				{
+					if (!iface->key(userdata, token_data, token_size))
+					{ return false; }
+				}
+				else
+				{
+					value.type = JSN_TYPE_STRING;
+					value.string_value = token_data;
+					value.string_length = (uint32_t)token_size;
+					if (!iface->value(userdata, &value))
+					{ return false; }
+					value.string_length = 0;
+				}
+				break;
+
+			case JSN_TOKEN_ARRAY_OPEN:
+				if (!iface->open_array(userdata))
+				{ return false; }
+				break;
+
+			case JSN_TOKEN_ARRAY_CLOSE:
+				if (!iface->close_array(userdata, grammar->closed_count))
+				{ return false; }
+				break;
+
+			case JSN_TOKEN_OBJECT_OPEN:
+				if (!iface->open_object(userdata))
+				{ return false; }
+				break;
+
+			case JSN_TOKEN_OBJECT_CLOSE:
+				if (!iface->close_object(userdata, grammar->closed_count))
+				{ return false; }
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+
+static bool JSN_ReadTokens(JSN_Tokenizer* tokenizer, const JSN_ReaderInterface* iface, void* userdata)
+{
+	JSN_Grammar grammar;
+	JSN_GrammarInit(&grammar);
+
+	bool success = JSN_ReadTokens(tokenizer, &grammar, iface, userdata);
+
+	JSN_TokenizerQuit(tokenizer);
+
+	return success;
+}
+
+
+bool JSN_Read(SDL_IOStream* stream, const JSN_ReaderInterface* iface, void* userdata, bool closeio)
+{
+	if (stream == NULL)
+	{ return false; }
+
+	JSN_Tokenizer tokenizer;
+	JSN_TokenizerInit(&tokenizer, stream);
+
+	bool success = JSN_ReadTokens(&tokenizer, iface, userdata);
+
+	if (closeio)
+	{ SDL_CloseIO(stream); }
+
+	return success;
+}
+
+
+bool JSN_ReadMem(const void* mem, size_t length, const JSN_ReaderInterface* iface, void* userdata)
+{
+	JSN_Tokenizer tokenizer;
+	JSN_TokenizerInitMem(&tokenizer, mem, length);
+
+	return JSN_ReadTokens(&tokenizer, iface, userdata);
+}
+
+
+/**
+ * @brief Read JSON data from a mutable memory buffer, decoding strings & keys in place.
+ */
+static bool JSN_ReadInSitu(void* mem, size_t length, const JSN_ReaderInterface* iface, void* userdata)
+{
+	JSN_Tokenizer tokenizer;
+	JSN_TokenizerInitMem(&tokenizer, mem, length);
+	tokenizer.insitu = true;
+
+	return JSN_ReadTokens(&tokenizer, iface, userdata);
+}
+
+
+/**
+ * @brief State of an incremental read, kept across calls to JSN_Feed().
+ */
+struct JSN_Parser
+{
+	const JSN_ReaderInterface* iface;
+	void* userdata;
+	JSN_Tokenizer tokenizer;
+	JSN_Grammar grammar;
+	char* carry;		/**< Input fed after the start of the last incomplete token. */
+	size_t carry_size;
+	size_t carry_cap;
+	size_t retry_size;	/**< Size the carried input must reach before the incomplete token is read again. */
+	bool failed;
+	bool finished;
+};
+
+
+static void JSN_ParserCarry(JSN_Parser* parser, const char* data, size_t size)
+{
+	if (parser->carry_size + size > parser->carry_cap)
+	{
+		size_t cap = SDL_max(parser->carry_cap * 2, parser->carry_size + size);
+		parser->carry = (char*)SDL_realloc(parser->carry, cap * sizeof(char));
+		parser->carry_cap = cap;
+	}
+
+	SDL_memmove(parser->carry + parser->carry_size, data, size);
+	parser->carry_size += size;
+}
+
+
+/**
+ * @brief Read as many complete tokens as possible from the given input, carrying over the incomplete one.
+ */
+static bool JSN_ParserRun(JSN_Parser* parser, const char* mem, size_t length, bool partial)
+{
+	JSN_Tokenizer* tokenizer = &parser->tokenizer;
+	tokenizer->cursor = tokenizer->mark = mem;
+	tokenizer->end = mem + length;
+	tokenizer->partial = partial;
+	tokenizer->starved = false;
+
+	if (!JSN_ReadTokens(tokenizer, &parser->grammar, parser->iface, parser->userdata))
+	{
+		parser->failed = true;
+		return false;
+	}
+
+	const char* rest = tokenizer->starved ? tokenizer->mark : tokenizer->end;
+	size_t rest_size = tokenizer->end - rest;
+
+	parser->carry_size = 0;
+
+	if (rest_size > 0)
+	{ JSN_ParserCarry(parser, rest, rest_size); }
+
+	// Wait for the carried input to double before reading a long token from its start again.
+	parser->retry_size = rest_size * 2;
+	return true;
+}
+
+
+JSN_Parser* JSN_CreateParser(const JSN_ReaderInterface* iface, void* userdata)
+{
+	JSN_Parser* parser = (JSN_Parser*)SDL_calloc(1, sizeof(JSN_Parser));
+
+	if (parser == NULL)
+	{ return NULL; }
+
+	parser->iface = iface;
+	parser->userdata = userdata;
+	JSN_GrammarInit(&parser->grammar);
+	return parser;
+}
+
+
+void JSN_DestroyParser(JSN_Parser* parser)
+{
+	if (parser == NULL)
+	{ return; }
+
+	JSN_TokenizerQuit(&parser->tokenizer);
+	SDL_free(parser->carry);
+	SDL_free(parser);
+}
+
+
+bool JSN_Feed(JSN_Parser* parser, const void* data, size_t length)
+{
+	if (parser->failed || parser->finished)
+	{ return SDL_SetError("JSON parser can't be fed after it has failed or finished"); }
+
+	// Without an incomplete token to resume, the input is read in place.
+	if (parser->carry_size == 0)
+	{ return JSN_ParserRun(parser, (const char*)data, length, true); }
+
+	JSN_ParserCarry(parser, (const char*)data, length);
+
+	if (parser->carry_size < parser->retry_size)
+	{ return true; }
+
+	return JSN_ParserRun(parser, parser->carry, parser->carry_size, true);
+}
+
+
+bool JSN_Finish(JSN_Parser* parser)
+{
+	if (parser->failed || parser->finished)
+	{ return SDL_SetError("JSON parser can't be finished after it has failed or finished"); }
+
+	parser->finished = true;
+	return JSN_ParserRun(parser, parser->carry, parser->carry_size, false);
+}
+
+
+bool JSN_ParseMem(JSN_Parser* parser, const void* mem, size_t length)
+{
+	if (parser == NULL)
+	{ return SDL_InvalidParamError("parser"); }
+
+	if (parser->failed || parser->finished || parser->tokenizer.end)
+	{ return SDL_SetError("JSON parser can't read memory after it has been fed"); }
+
+	// The tokenizer is only released by JSN_DestroyParser(), which the reader interface may never return to.
+	parser->finished = true;
+	JSN_TokenizerInitMem(&parser->tokenizer, mem, length);
+
+	if (!JSN_ReadTokens(&parser->tokenizer, &parser->grammar, parser->iface, parser->userdata))
+	{
+		parser->failed = true;
+		return false;
+	}
+
+	return true;
+}
+
+
+/* ==================================================
+	JSON WRITER API
+================================================== */
+
+/**
+ * @brief Buffered output of a sequence of JSON events, validated by the same grammar as the readers.
+ */
+struct JSN_Writer
+{
+	SDL_IOStream* stream;
+	bool pretty;
+	bool closeio;
+	bool failed;
+	JSN_Grammar grammar;
+	size_t size;				/**< Number of bytes waiting in the buffer. */
+	char buffer[JSN_BLOCK_SIZE];
+};
+
+
+/**
+ * @brief Maximum number of bytes reserved at once, enough for any number or escape sequence.
+ */
+constexpr size_t JSN_WRITER_RESERVE = 64;
+
+
+static bool JSN_WriterFlush(JSN_Writer* writer)
+{
+	if (writer->size && SDL_WriteIO(writer->stream, writer->buffer, writer->size) != writer->size)
+	{ writer->failed = true; }
+
+	writer->size = 0;
+	return !writer->failed;
+}
+
+
+static char* JSN_WriterReserve(JSN_Writer* writer, size_t size)
+{
+	if (writer->size + size > sizeof(writer->buffer))
+	{ JSN_WriterFlush(writer); }
+
+	return writer->buffer + writer->size;
+}
+
+
+static void JSN_WriterPut(JSN_Writer* writer, const char* data, size_t size)
+{
+	if (writer->size + size > sizeof(writer->buffer))
+	{
+		JSN_WriterFlush(writer);
+
+		// Large runs bypass the buffer entirely.
+		if (size > sizeof(writer->buffer))
+		{
+			if (SDL_WriteIO(writer->stream, data, size) != size)
+			{ writer->failed = true; }
+
+			return;
+		}
+	}
+
+	SDL_memcpy(writer->buffer + writer->size, data, size);
+	writer->size += size;
+}
+
+
+static void JSN_WriterIndent(JSN_Writer* writer, size_t depth)
+{
+	char* out = JSN_WriterReserve(writer, 1);
+	*out = '\n';
+	writer->size++;
+
+	while (depth > 0)
+	{
+		size_t count = SDL_min(depth, JSN_WRITER_RESERVE);
+		out = JSN_WriterReserve(writer, count);
+		SDL_memset(out, '\t', count);
+		writer->size += count;
+		depth -= count;
+	}
+}
+
+
+/**
+ * @brief Validate the next token, writing the separators & whitespace preceding it.
+ * 
+ * @note Keys & string values are told apart by the caller rather than by the grammar, unlike when reading.
+ */
+static bool JSN_WriterBegin(JSN_Writer* writer, JSN_TokenType token, bool key)
+{
+	JSN_Grammar* grammar = &writer->grammar;
+
+	if (writer->failed)
+	{ return SDL_SetError("JSON writer can't be written to after it has failed"); }
+
+	bool close = token == JSN_TOKEN_ARRAY_CLOSE || token == JSN_TOKEN_OBJECT_CLOSE;
+	bool separate = grammar->state == JSN_EXPECT_COMMA_OR_CLOSE;
+	bool after_key = grammar->state == JSN_EXPECT_VALUE && grammar->depth && grammar->scopes[grammar->depth - 1].object;
+
+	if (separate && !close)
+	{ JSN_GrammarAccept(grammar, JSN_TOKEN_COMMA); }
+
+	size_t depth = grammar->depth;
+
+	if (JSN_GrammarExpectsKey(grammar) != key && !close)
+	{
+		writer->failed = true;
+		return SDL_SetError("unexpected %s written to JSON stream", key ? "key" : "value");
+	}
+
+	if (!JSN_GrammarAccept(grammar, token))
+	{
+		writer->failed = true;
+		return SDL_SetError("unexpected %s written to JSON stream", token_names[token]);
+	}
+
+	if (separate && !close)
+	{ JSN_WriterPut(writer, ",", 1); }
+
+	if (writer->pretty)
+	{
+		if (close && separate)
+		{ JSN_WriterIndent(writer, depth - 1); }
+		else if (!close && !after_key && depth > 0)
+		{ JSN_WriterIndent(writer, depth); }
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Write a quoted string, escaping quotes, backslashes & control characters.
+ */
+static void JSN_WriterString(JSN_Writer* writer, const char* data, size_t length)
+{
+	static const char hex[] = "0123456789abcdef";
+
+	const char* end = data + length;
+	JSN_WriterPut(writer, "\"", 1);
+
+	for (;;)
+	{
+		const char* p = JSN_SkipPlain(data, end);
+		JSN_WriterPut(writer, data, p - data);
+
+		if (p == end)
+		{ break; }
+
+		char* out = JSN_WriterReserve(writer, 6);
+		uint8_t c = (uint8_t)*p;
+
+		switch (c)
+		{
+			case '"':  SDL_memcpy(out, "\\\"", 2); writer->size += 2; break;
+			case '\\': SDL_memcpy(out, "\\\\", 2); writer->size += 2; break;
+			case '\b': SDL_memcpy(out, "\\b", 2); writer->size += 2; break;
+			case '\f': SDL_memcpy(out, "\\f", 2); writer->size += 2; break;
+			case '\n': SDL_memcpy(out, "\\n", 2); writer->size += 2; break;
+			case '\r': SDL_memcpy(out, "\\r", 2); writer->size += 2; break;
+			case '\t': SDL_memcpy(out, "\\t", 2); writer->size += 2; break;
+
+			default:
+				SDL_memcpy(out, "\\u00", 4);
+				out[4] = hex[c >> 4];
+				out[5] = hex[c & 0xF];
+				writer->size += 6;
+				break;
+		}
+
+		data = p + 1;
+	}
+
+	JSN_WriterPut(writer, "\"", 1);
+}
+
+
+/**
+ * @brief Write a number in the shortest form that reads back as the exact same double.
+ * 
+ * @note Numbers without a fraction or exponent are given one, so that they aren't read back as integers.
+ *  Infinities are written as out of range numbers & NaN as null, JSON having no representation for them.
+ */
+static void JSN_WriterNumber(JSN_Writer* writer, double number)
+{
+	if (number != number)
+	{
+		JSN_WriterPut(writer, "null", 4);
+		return;
+	}
+
+	if (number == std::numeric_limits<double>::infinity() || number == -std::numeric_limits<double>::infinity())
+	{
+		JSN_WriterPut(writer, number > 0 ? "1e999" : "-1e999", number > 0 ? 5 : 6);
+		return;
+	}
+
+	char* out = JSN_WriterReserve(writer, JSN_WRITER_RESERVE);
+	char* end = std::to_chars(out, out + JSN_WRITER_RESERVE - 2, number).ptr;
+
+	if (!std::memchr(out, '.', end - out) && !std::memchr(out, 'e', end - out))
+	{
+		*end++ = '.';
+		*end++ = '0';
+	}
+
+	writer->size += end - out;
+}
+
+
+static void JSN_WriterScalar(JSN_Writer* writer, const JSN_Value* value)
+{
+	switch (value->type)
+	{
+		case JSN_TYPE_BOOL:
+			JSN_WriterPut(writer, value->bool_value ? "true" : "false", value->bool_value ? 4 : 5);
+			break;
+
+		case JSN_TYPE_INTEGER:
+		{
+			char* out = JSN_WriterReserve(writer, JSN_WRITER_RESERVE);
+			writer->size += std::to_chars(out, out + JSN_WRITER_RESERVE, value->integer_value).ptr - out;
+			break;
+		}
+
+		case JSN_TYPE_NUMBER:
+			JSN_WriterNumber(writer, value->number_value);
+			break;
+
+		case JSN_TYPE_STRING:
+			JSN_WriterString(writer, value->string_value, value->string_length);
+			break;
+
+		default:
+			JSN_WriterPut(writer, "null", 4);
+			break;
+	}
+}
+
+
+JSN_Writer* JSN_CreateWriter(SDL_IOStream* stream, bool pretty, bool closeio)
+{
+	if (stream == NULL)
+	{ return NULL; }
+
+	JSN_Writer* writer = (JSN_Writer*)SDL_malloc(sizeof(JSN_Writer));
+
+	if (writer == NULL)
+	{
+		if (closeio)
+		{ SDL_CloseIO(stream); }
+
+		return NULL;
+	}
+
+	writer->stream = stream;
+	writer->pretty = pretty;
+	writer->closeio = closeio;
+	writer->failed = false;
+	writer->size = 0;
+	JSN_GrammarInit(&writer->grammar);
+
+	return writer;
+}
+
+
+bool JSN_CloseWriter(JSN_Writer* writer)
+{
+	if (writer == NULL)
+	{ return false; }
+
+	bool success = !writer->failed;
+
+	if (success && !JSN_GrammarFinish(&writer->grammar))
+	{ success = SDL_SetError("incomplete JSON written to stream"); }
+
+	if (success && writer->pretty && writer->grammar.state == JSN_EXPECT_END)
+	{ JSN_WriterPut(writer, "\n", 1); }
+
+	if (success && !JSN_WriterFlush(writer))
+	{ success = false; }
+
+	if (writer->closeio && !SDL_CloseIO(writer->stream))
+	{ success = false; }
+
+	SDL_free(writer);
+
+	return success;
+}
+
+
+bool JSN_FlushWriter(JSN_Writer* writer)
+{
+	return JSN_WriterFlush(writer) && SDL_FlushIO(writer->stream);
+}
+
+
+bool JSN_WriteKey(JSN_Writer* writer, const char* key, size_t length)
+{
+	if (!JSN_WriterBegin(writer, JSN_TOKEN_STRING, true))
+	{ return false; }
+
+	JSN_WriterString(writer, key, length);
+	JSN_GrammarAccept(&writer->grammar, JSN_TOKEN_COLON);
+	JSN_WriterPut(writer, ": ", writer->pretty ? 2 : 1);
+
+	return !writer->failed;
+}
+
+
+bool JSN_WriteValue(JSN_Writer* writer, const JSN_Value* value)
+{
+	if (!JSN_LoadContainer(value))
+	{
+		writer->failed = true;
+		return false;
+	}
+
+	switch (value->type)
+	{
+		case JSN_TYPE_ARRAY:
+		{
+			if (!JSN_WriteOpenArray(writer))
+			{ return false; }
+
+			const JSN_Array* array = value->array_value;
+
+			for (size_t i = 0; i < array->count; ++i)
+			{
+				if (!JSN_WriteValue(writer, &array->values[i]))
+				{ return false; }
+			}
+
+			return JSN_WriteCloseArray(writer);
+		}
+
+		case JSN_TYPE_OBJECT:
+		{
+			if (!JSN_WriteOpenObject(writer))
+			{ return false; }
+
+			const JSN_Object* object = value->object_value;
+
+			for (size_t i = 0; i < object->count; ++i)
+			{
+				const JSN_Property* prop = &object->properties[i];
+
+				if (!JSN_WriteKey(writer, prop->key, prop->key_length) || !JSN_WriteValue(writer, &prop->value))
+				{ return false; }
+			}
+
+			return JSN_WriteCloseObject(writer);
+		}
+
+		default:
+		{
+			JSN_TokenType token = value->type == JSN_TYPE_STRING ? JSN_TOKEN_STRING : JSN_TOKEN_NUMBER;
+
+			if (!JSN_WriterBegin(writer, token, false))
+			{ return false; }
+
+			JSN_WriterScalar(writer, value);
+			return !writer->failed;
+		}
+	}
+}
+
+
+bool JSN_WriteOpenArray(JSN_Writer* writer)
+{
+	if (!JSN_WriterBegin(writer, JSN_TOKEN_ARRAY_OPEN, false))
+	{ return false; }
+
+	JSN_WriterPut(writer, "[", 1);
+	return !writer->failed;
+}
+
+
+bool JSN_WriteCloseArray(JSN_Writer* writer)
+{
+	if (!JSN_WriterBegin(writer, JSN_TOKEN_ARRAY_CLOSE, false))
+	{ return false; }
+
+	JSN_WriterPut(writer, "]", 1);
+	return !writer->failed;
+}
+
+
+bool JSN_WriteOpenObject(JSN_Writer* writer)
+{
+	if (!JSN_WriterBegin(writer, JSN_TOKEN_OBJECT_OPEN, false))
+	{ return false; }
+
+	JSN_WriterPut(writer, "{", 1);
+	return !writer->failed;
+}
+
+
+bool JSN_WriteCloseObject(JSN_Writer* writer)
+{
+	if (!JSN_WriterBegin(writer, JSN_TOKEN_OBJECT_CLOSE, false))
+	{ return false; }
+
+	JSN_WriterPut(writer, "}", 1);
+	return !writer->failed;
+}
+
+
+static bool JSN_WriterKeyEvent(void* userdata, const char* key, size_t length)
+{ return JSN_WriteKey((JSN_Writer*)userdata, key, length); }
+
+static bool JSN_WriterValueEvent(void* userdata, JSN_Value* value)
+{ return JSN_WriteValue((JSN_Writer*)userdata, value); }
+
+static bool JSN_WriterOpenArrayEvent(void* userdata)
+{ return JSN_WriteOpenArray((JSN_Writer*)userdata); }
+
+static bool JSN_WriterCloseArrayEvent(void* userdata, size_t)
+{ return JSN_WriteCloseArray((JSN_Writer*)userdata); }
+
+static bool JSN_WriterOpenObjectEvent(void* userdata)
+{ return JSN_WriteOpenObject((JSN_Writer*)userdata); }
+
+static bool JSN_WriterCloseObjectEvent(void* userdata, size_t)
+{ return JSN_WriteCloseObject((JSN_Writer*)userdata); }
+
+
+static const JSN_ReaderInterface writer_iface
+{
+	.version = sizeof(JSN_ReaderInterface),
+	.key = JSN_WriterKeyEvent,
+	.value = JSN_WriterValueEvent,
+	.open_array = JSN_WriterOpenArrayEvent,
+	.close_array = JSN_WriterCloseArrayEvent,
+	.open_object = JSN_WriterOpenObjectEvent,
+	.close_object = JSN_WriterCloseObjectEvent,
+};
+
+
+const JSN_ReaderInterface* JSN_GetWriterInterface()
+{
+	return &writer_iface;
+}
+
+
+bool JSN_Write(SDL_IOStream* stream, const JSN_Value* value, bool pretty, bool closeio)
+{
+	JSN_Writer* writer = JSN_CreateWriter(stream, pretty, closeio);
+
+	if (writer == NULL)
+	{ return false; }
+
+	bool success = value->type == JSN_TYPE_EMPTY || JSN_WriteValue(writer, value);
+	return JSN_CloseWriter(writer) && success;
+}
+
+
+/* ==================================================
+	JSON BINARY IMAGE API
+================================================== */
+
+/**
+ * @brief Version of the binary image layout, to be bumped whenever JSN_Value or its containers change.
+ */
+constexpr uint16_t JSN_IMAGE_VERSION = 3;
+
+
+/**
+ * @brief Header of a binary image of a chunk.
+ * 
+ * @note Images are a single block holding the header followed by every node & string of the chunk.
+ *  Pointers within the block are stored as offsets from its start, zero standing for NULL.
+ *  The layout depends on the size of pointers & the byte order, images from other platforms are rejected.
+ */
+struct JSN_ImageHeader
+{
+	char magic[4];
+	uint16_t version;
+	uint8_t pointer_size;
+	uint8_t little_endian;
+	uint32_t reserved;
+	uint64_t source_hash;		/**< Hash of the JSON source the image was built from, if any. */
+	uint64_t checksum;			/**< Hash of the image past its header. */
+	uint64_t source_size;		/**< Size of the JSON source the image was built from, if any. */
+	uint64_t size;				/**< Size of the whole image, header included. */
+	JSN_Value root;
+};
+
+
+/**
+ * @brief Hash a buffer 32 bytes at a time, in four independent lanes of 64-bit multiply & rotate rounds.
+ * 
+ * @note Images are hashed whole on every load, for which SDL_crc32() & SDL_murmur3_32() are much too slow.
+ */
+static uint64_t JSN_HashBytes(const void* data, size_t size)
+{
+	constexpr uint64_t P1 = 0x9E3779B185EBCA87, P2 = 0xC2B2AE3D27D4EB4F, P3 = 0x165667B19E3779F9;
+
+	const uint8_t* p = (const uint8_t*)data;
+	const uint8_t* end = p + size;
+	uint64_t lanes[4] { P1 + P2, P2, 0, (uint64_t)0 - P1 };
+
+	for (; end - p >= 32; p += 32)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			uint64_t word;
+			SDL_memcpy(&word, p + i * 8, 8);
+			lanes[i] = std::rotl(lanes[i] + word * P2, 31) * P1;
+		}
+	}
+
+	uint64_t hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+	hash += size;
+
+	for (; p != end; ++p)
+	{ hash = std::rotl(hash ^ (*p * P3), 11) * P1; }
+
+	hash ^= hash >> 33;
+	hash *= P2;
+	hash ^= hash >> 29;
+	hash *= P3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+
+static bool IsLittleEndian()
+{
+	const uint16_t value = 1;
+	return *(const uint8_t*)&value == 1;
+}
+
+
+struct JSN_ImageBuilder
+{
+	char* data;
+	size_t size;
+	size_t cap;
+};
+
+
+/**
+ * @brief Reserve room for a record at the end of the image, returning its offset.
+ */
+static size_t JSN_ImageAlloc(JSN_ImageBuilder* builder, size_t size, size_t align)
+{
+	size_t offset = (builder->size + align - 1) & ~(align - 1);
+
+	if (offset + size > builder->cap)
+	{
+		size_t cap = SDL_max(builder->cap * 2, offset + size);
+		builder->data = (char*)SDL_realloc(builder->data, cap);
+		builder->cap = cap;
+	}
+
+	SDL_memset(builder->data + builder->size, 0, offset + size - builder->size);
+	builder->size = offset + size;
+	return offset;
+}
+
+
+static size_t JSN_ImageString(JSN_ImageBuilder* builder, const char* data, size_t length)
+{
+	size_t offset = JSN_ImageAlloc(builder, length + 1, 1);
+	SDL_memcpy(builder->data + offset, data, length);
+	return offset;
+}
+
+
+template<typename T>
+static T* JSN_ImageAt(JSN_ImageBuilder* builder, size_t offset)
+{
+	return (T*)(builder->data + offset);
+}
+
+
+template<typename T>
+static T JSN_ImageOffset(size_t offset)
+{
+	return (T)(uintptr_t)offset;
+}
+
+
+/**
+ * @brief Copy a value into the image at the given offset, appending its children after it.
+ * 
+ * @note Records are always appended after the one referencing them, the image being re-fetched after every append.
+ */
+static void JSN_ImageValue(JSN_ImageBuilder* builder, size_t offset, const JSN_Value* value)
+{
+	*JSN_ImageAt<JSN_Value>(builder, offset) = *value;
+
+	switch (value->type)
+	{
+		case JSN_TYPE_STRING:
+		{
+			size_t string = JSN_ImageString(builder, value->string_value, value->string_length);
+			JSN_ImageAt<JSN_Value>(builder, offset)->string_value = JSN_ImageOffset<const char*>(string);
+			break;
+		}
+
+		case JSN_TYPE_ARRAY:
+		{
+			const JSN_Array* src = value->array_value;
+			size_t array = JSN_ImageAlloc(builder, sizeof(JSN_Array), alignof(JSN_Array));
+			size_t values = JSN_ImageAlloc(builder, src->count * sizeof(JSN_Value), alignof(JSN_Value));
+
+			JSN_Array* dest = JSN_ImageAt<JSN_Array>(builder, array);
+			dest->values = src->count ? JSN_ImageOffset<JSN_Value*>(values) : NULL;
+			dest->count = dest->capacity = src->count;
+			JSN_ImageAt<JSN_Value>(builder, offset)->array_value = JSN_ImageOffset<JSN_Array*>(array);
+
+			for (size_t i = 0; i < src->count; ++i)
+			{ JSN_ImageValue(builder, values + i * sizeof(JSN_Value), &src->values[i]); }
+			break;
+		}
+
+		case JSN_TYPE_OBJECT:
+		{
+			const JSN_Object* src = value->object_value;
+			size_t object = JSN_ImageAlloc(builder, sizeof(JSN_Object), alignof(JSN_Object));
+			size_t props = JSN_ImageAlloc(builder, src->count * sizeof(JSN_Property), alignof(JSN_Property));
+			size_t index = src->index ? JSN_ImageAlloc(builder, src->index_capacity * sizeof(uint32_t), alignof(uint32_t)) : 0;
+
+			if (src->index)
+			{ SDL_memcpy(JSN_ImageAt<uint32_t>(builder, index), src->index, src->index_capacity * sizeof(uint32_t)); }
+
+			JSN_Object* dest = JSN_ImageAt<JSN_Object>(builder, object);
+			dest->properties = src->count ? JSN_ImageOffset<JSN_Property*>(props) : NULL;
+			dest->count = dest->capacity = src->count;
+			dest->index = JSN_ImageOffset<uint32_t*>(index);
+			dest->index_capacity = src->index ? src->index_capacity : 0;
+			JSN_ImageAt<JSN_Value>(builder, offset)->object_value = JSN_ImageOffset<JSN_Object*>(object);
+
+			for (size_t i = 0; i < src->count; ++i)
+			{
+				const JSN_Property* prop = &src->properties[i];
+				size_t dest_prop = props + i * sizeof(JSN_Property);
+				size_t key = JSN_ImageString(builder, prop->key, prop->key_length);
+
+				JSN_ImageAt<JSN_Property>(builder, dest_prop)->key = JSN_ImageOffset<const char*>(key);
+				JSN_ImageAt<JSN_Property>(builder, dest_prop)->key_length = prop->key_length;
+				JSN_ImageValue(builder, dest_prop + offsetof(JSN_Property, value), &prop->value);
+			}
+			break;
+		}
+
+		default:
+			break;
+	}
+}
+
+
+static bool JSN_SaveImage(JSN_Chunk* chunk, SDL_IOStream* stream, uint64_t source_hash, uint64_t source_size)
+{
+	// Images hold every value, so lazy chunks are read whole first.
+	if (!JSN_LoadValue(&chunk->root, true))
+	{ return false; }
+
+	JSN_ImageBuilder builder;
+	SDL_zero(builder);
+
+	size_t header = JSN_ImageAlloc(&builder, sizeof(JSN_ImageHeader), alignof(JSN_ImageHeader));
+	JSN_ImageValue(&builder, header + offsetof(JSN_ImageHeader, root), &chunk->root);
+
+	JSN_ImageHeader* image = JSN_ImageAt<JSN_ImageHeader>(&builder, header);
+	SDL_memcpy(image->magic, "JSNB", 4);
+	image->version = JSN_IMAGE_VERSION;
+	image->pointer_size = sizeof(void*);
+	image->little_endian = IsLittleEndian();
+	image->source_hash = source_hash;
+	image->source_size = source_size;
+	image->size = builder.size;
+	image->checksum = JSN_HashBytes(builder.data + sizeof(JSN_ImageHeader), builder.size - sizeof(JSN_ImageHeader));
+
+	bool success = SDL_WriteIO(stream, builder.data, builder.size) == builder.size;
+
+	SDL_free(builder.data);
+	return success;
+}
+
+
+/**
+ * @brief Check that a range of the image lies past the record referencing it, returning its address.
+ */
+static void* JSN_ImageRange(char* base, size_t size, const void* offset_value, size_t min, size_t count, size_t stride, size_t align)
+{
+	uintptr_t offset = (uintptr_t)offset_value;
+
+	if (offset < min || offset >= size || offset % align != 0 || (size - offset) / stride < count)
+	{ return NULL; }
+
+	return base + offset;
+}
+
+
+/**
+ * @brief Turn the offsets of a value & of its children back into pointers, checking that they remain within the image.
+ */
+static bool JSN_RelocateValue(JSN_Chunk* chunk, char* base, size_t size, JSN_Value* value)
+{
+	size_t min = (char*)value - base + sizeof(JSN_Value);
+
+	switch (value->type)
+	{
+		case JSN_TYPE_EMPTY:
+		case JSN_TYPE_NULL:
+		case JSN_TYPE_BOOL:
+		case JSN_TYPE_INTEGER:
+		case JSN_TYPE_NUMBER:
+			return true;
+
+		case JSN_TYPE_STRING:
+		{
+			char* string = (char*)JSN_ImageRange(base, size, value->string_value, min, (size_t)value->string_length + 1, 1, 1);
+
+			if (string == NULL || string[value->string_length] != '\0')
+			{ return false; }
+
+			value->string_value = string;
+			return true;
+		}
+
+		case JSN_TYPE_ARRAY:
+		{
+			JSN_Array* array = (JSN_Array*)JSN_ImageRange(base, size, value->array_value, min, 1, sizeof(JSN_Array), alignof(JSN_Array));
+
+			if (array == NULL)
+			{ return false; }
+
+			value->array_value = array;
+			array->chunk = chunk;
+			array->lazy = NULL;
+			SDL_SetAtomicInt(&array->shares, 0);
+			array->detached = false;
+
+			if (array->count == 0)
+			{ array->values = NULL; return true; }
+
+			min = (char*)array - base + sizeof(JSN_Array);
+			array->values = (JSN_Value*)JSN_ImageRange(base, size, array->values, min, array->count, sizeof(JSN_Value), alignof(JSN_Value));
+
+			if (array->values == NULL)
+			{ return false; }
+
+			for (size_t i = 0; i < array->count; ++i)
+			{
+				if (!JSN_RelocateValue(chunk, base, size, &array->values[i]))
+				{ return false; }
+			}
+
+			return true;
+		}
+
+		case JSN_TYPE_OBJECT:
+		{
+			JSN_Object* object = (JSN_Object*)JSN_ImageRange(base, size, value->object_value, min, 1, sizeof(JSN_Object), alignof(JSN_Object));
+
+			if (object == NULL)
+			{ return false; }
+
+			value->object_value = object;
+			object->chunk = chunk;
+			object->lazy = NULL;
+			SDL_SetAtomicInt(&object->shares, 0);
+			object->detached = false;
+			min = (char*)object - base + sizeof(JSN_Object);
+
+			if (object->index)
+			{
+				// The index must be a power of two larger than the number of properties, or lookups would never end.
+				object->index = (uint32_t*)JSN_ImageRange(base, size, object->index, min, object->index_capacity, sizeof(uint32_t), alignof(uint32_t));
+
+				if (object->index == NULL || object->index_capacity <= object->count || !std::has_single_bit(object->index_capacity))
+				{ return false; }
+
+				for (size_t i = 0; i < object->index_capacity; ++i)
+				{
+					if (object->index[i] > object->count)
+					{ return false; }
+				}
+			}
+
+			if (object->count == 0)
+			{ object->properties = NULL; return true; }
+
+			object->properties = (JSN_Property*)JSN_ImageRange(base, size, object->properties, min, object->count, sizeof(JSN_Property), alignof(JSN_Property));
+
+			if (object->properties == NULL)
+			{ return false; }
+
+			for (size_t i = 0; i < object->count; ++i)
+			{
+				JSN_Property* prop = &object->properties[i];
+				min = (char*)(prop + 1) - base;
+
+				char* key = (char*)JSN_ImageRange(base, size, prop->key, min, prop->key_length + 1, 1, 1);
+
+				if (key == NULL || key[prop->key_length] != '\0' || !JSN_RelocateValue(chunk, base, size, &prop->value))
+				{ return false; }
+
+				prop->key = key;
+			}
+
+			return true;
+		}
+
+		default:
+			return false;
+	}
+}
+
+
+/**
+ * @brief Load a binary image into a new chunk with a single read, after which only its pointers are fixed up.
+ * 
+ * @note Images built from a different source, when source_size isn't zero, are rejected without setting an error.
+ */
+static JSN_Chunk* JSN_LoadImage(SDL_IOStream* stream, uint64_t source_hash, uint64_t source_size)
+{
+	JSN_ImageHeader header;
+
+	if (SDL_ReadIO(stream, &header, sizeof(header)) != sizeof(header))
+	{
+		SDL_SetError("truncated header encountered while loading JSON image");
+		return NULL;
+	}
+
+	if (SDL_memcmp(header.magic, "JSNB", 4) != 0 || header.version != JSN_IMAGE_VERSION ||
+		header.pointer_size != sizeof(void*) || header.little_endian != IsLittleEndian() ||
+		header.size < sizeof(header) || header.size > SIZE_MAX)
+	{
+		SDL_SetError("incompatible header encountered while loading JSON image");
+		return NULL;
+	}
+
+	if (source_size && (header.source_hash != source_hash || header.source_size != source_size))
+	{ return NULL; }
+
+	JSN_Chunk* chunk = JSN_CreateChunk();
+	char* base = (char*)JSN_ChunkAlloc(chunk, (size_t)header.size, alignof(std::max_align_t));
+
+	if (base == NULL)
+	{
+		JSN_DestroyChunk(chunk);
+		return NULL;
+	}
+
+	SDL_memcpy(base, &header, sizeof(header));
+	size_t rest = (size_t)header.size - sizeof(header);
+
+	if (SDL_ReadIO(stream, base + sizeof(header), rest) != rest ||
+		JSN_HashBytes(base + sizeof(header), rest) != header.checksum ||
+		!JSN_RelocateValue(chunk, base, (size_t)header.size, &((JSN_ImageHeader*)base)->root))
+	{
+		SDL_SetError("corrupted data encountered while loading JSON image");
+		JSN_DestroyChunk(chunk);
+		return NULL;
+	}
+
+	chunk->root = ((JSN_ImageHeader*)base)->root;
+	return chunk;
+}
+
+
+bool JSN_SaveBinary(JSN_Chunk* chunk, SDL_IOStream* stream, bool closeio)
+{
+	if (stream == NULL)
+	{ return false; }
+
+	bool success = JSN_SaveImage(chunk, stream, 0, 0);
+
+	if (closeio && !SDL_CloseIO(stream))
+	{ success = false; }
+
+	return success;
+}
+
+
+JSN_Chunk* JSN_LoadBinary(SDL_IOStream* stream, bool closeio)
+{
+	if (stream == NULL)
+	{ return NULL; }
+
+	JSN_Chunk* chunk = JSN_LoadImage(stream, 0, 0);
+
+	if (closeio)
+	{ SDL_CloseIO(stream); }
+
+	return chunk;
+}
+
+
+static struct
+{
+	bool save;
+	char* directory;
+} binary_cache;
+
+
+void JSN_SetBinaryCache(bool save, const char* directory)
+{
+	SDL_free(binary_cache.directory);
+	binary_cache.save = save;
+	binary_cache.directory = directory ? SDL_strdup(directory) : NULL;
+}
+
+
+/**
+ * @brief Get the path of the binary image cached for a JSON file, which must be freed with SDL_free().
+ */
+static char* JSN_GetBinaryCachePath(const char* file)
+{
+	char* path = NULL;
+
+	if (binary_cache.directory)
+	{ SDL_asprintf(&path, "%s/%08x.jsnb", binary_cache.directory, (unsigned)SDL_murmur3_32(file, SDL_strlen(file), 0)); }
+	else
+	{ SDL_asprintf(&path, "%s.jsnb", file); }
+
+	return path;
+}
+
+
+/**
+ * @brief Save the binary image of a chunk read from a file, replacing its cached image at once.
+ *
+ * @note The image is written to a file of its own, then renamed over the cache,
+ *  so that readers of the same cache never see it partially written, even if saving is interrupted.
+ *  Failing to save, e.g. to a read-only directory, only costs the next load a parse.
+ */
+static void JSN_SaveCachedImage(JSN_Chunk* chunk, const char* cache, uint64_t source_hash, uint64_t source_size)
+{
+	char* temporary = NULL;
+	SDL_asprintf(&temporary, "%s.%" SDL_PRIu64 ".%" SDL_PRIu64 ".tmp", cache, (Uint64)SDL_GetCurrentThreadID(), SDL_GetPerformanceCounter());
+
+	if (temporary == NULL)
+	{ return; }
+
+	if (SDL_IOStream* stream = SDL_IOFromFile(temporary, "wb"))
+	{
+		bool saved = JSN_SaveImage(chunk, stream, source_hash, source_size);
+
+		if (!SDL_CloseIO(stream) || !saved || !SDL_RenamePath(temporary, cache))
+		{ SDL_RemovePath(temporary); }
+	}
+
+	SDL_free(temporary);
+}
+
+
+/* ==================================================
+	JSON QUERY API
+================================================== */
+
+struct JSN_QuerySegment
+{
+	const char* key;		/**< Key matched within objects, also matching array indices when numeric. */
+	size_t key_length;
+	size_t index;			/**< Index matched within arrays, or SIZE_MAX if the key isn't numeric. */
+	bool wildcard;			/**< Whether any property or element is matched. */
+};
+
+
+struct JSN_Query
+{
+	JSN_QuerySegment* segments;
+	size_t count;
+};
+
+
+static bool JSN_QueryAddSegment(JSN_QuerySegment* segment, char* key, size_t length, bool wildcard)
+{
+	segment->key = key;
+	segment->key_length = length;
+	segment->wildcard = wildcard;
+	segment->index = SIZE_MAX;
+
+	// Array indices are written without leading zeros, as in JSON Pointer.
+	if (!wildcard && length > 0 && length <= 19 && (key[0] != '0' || length == 1))
+	{
+		size_t index = 0;
+		size_t i = 0;
+
+		for (; i < length && IsDigit(key[i]); ++i)
+		{ index = index * 10 + (key[i] - '0'); }
+
+		if (i == length)
+		{ segment->index = index; }
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Split a JSON Pointer into segments, unescaping "~0" & "~1" in place.
+ */
+static bool JSN_CompilePointer(JSN_Query* query, char* path)
+{
+	char* p = path;
+
+	while (*p == '/')
+	{
+		char* key = ++p;
+		char* write = key;
+
+		for (; *p && *p != '/'; ++p)
+		{
+			if (*p == '~')
+			{
+				if (p[1] != '0' && p[1] != '1')
+				{ return SDL_SetError("invalid escape sequence in JSON query: %s", path); }
+
+				*write++ = *++p == '0' ? '~' : '/';
+			}
+			else
+			{
+				*write++ = *p;
+			}
+		}
+
+		size_t length = write - key;
+		JSN_QueryAddSegment(&query->segments[query->count++], key, length, length == 1 && key[0] == '*');
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Split a path of dotted keys & bracketed indices into segments, such as "monsters[*].stats.hp".
+ */
+static bool JSN_CompileDotted(JSN_Query* query, char* path)
+{
+	char* p = path;
+
+	while (*p)
+	{
+		if (*p == '[')
+		{
+			char* key = ++p;
+
+			while (*p && *p != ']')
+			{ ++p; }
+
+			if (*p != ']' || p == key)
+			{ return SDL_SetError("unterminated or empty brackets in JSON query: %s", path); }
+
+			size_t length = p++ - key;
+			JSN_QueryAddSegment(&query->segments[query->count++], key, length, length == 1 && key[0] == '*');
+		}
+		else
+		{
+			if (*p == '.' && p != path)
+			{ ++p; }
+
+			char* key = p;
+
+			while (*p && *p != '.' && *p != '[')
+			{ ++p; }
+
+			if (p == key)
+			{ return SDL_SetError("empty key in JSON query: %s", path); }
+
+			size_t length = p - key;
+			JSN_QueryAddSegment(&query->segments[query->count++], key, length, length == 1 && key[0] == '*');
+		}
+
+		if (*p && *p != '.' && *p != '[')
+		{ return SDL_SetError("unexpected character in JSON query: %s", path); }
+	}
+
+	return true;
+}
+
+
+JSN_Query* JSN_CompileQuery(const char* path)
+{
+	// Segments & their keys are stored in a single block after the query, keys being views into a copy of the path.
+	size_t length = SDL_strlen(path);
+	size_t max_segments = length + 1;
+	size_t size = sizeof(JSN_Query) + max_segments * sizeof(JSN_QuerySegment) + length + 1;
+
+	JSN_Query* query = (JSN_Query*)SDL_malloc(size);
+
+	if (query == NULL)
+	{ return NULL; }
+
+	query->segments = (JSN_QuerySegment*)(query + 1);
+	query->count = 0;
+
+	char* copy = (char*)(query->segments + max_segments);
+	SDL_memcpy(copy, path, length + 1);
+
+	bool success = copy[0] == '/' || copy[0] == '\0' ? JSN_CompilePointer(query, copy) : JSN_CompileDotted(query, copy);
+
+	if (!success)
+	{
+		SDL_free(query);
+		return NULL;
+	}
+
+	return query;
+}
+
+
+void JSN_DestroyQuery(JSN_Query* query)
+{
+	SDL_free(query);
+}
+
+
+static bool JSN_SegmentMatchesKey(const JSN_QuerySegment* segment, const char* key, size_t length)
+{
+	return segment->wildcard || (segment->key_length == length && SDL_memcmp(segment->key, key, length) == 0);
+}
+
+
+static bool JSN_SegmentMatchesIndex(const JSN_QuerySegment* segment, size_t index)
+{
+	return segment->wildcard || segment->index == index;
+}
+
+
+/**
+ * @brief Visit the values matching the segments of a query from the given one onwards, stopping when the callback fails.
+ */
+static bool JSN_QueryWalk(const JSN_Query* query, size_t i, JSN_Value* value, JSN_QueryCallback callback, void* userdata, size_t* matches)
+{
+	if (i == query->count)
+	{
+		++*matches;
+		return callback == NULL || callback(userdata, value);
+	}
+
+	const JSN_QuerySegment* segment = &query->segments[i];
+
+	// Lazy containers which can't be read are left unmatched.
+	if (!JSN_LoadContainer(value))
+	{ return true; }
+
+	if (value->type == JSN_TYPE_ARRAY)
+	{
+		JSN_Array* array = value->array_value;
+
+		if (!segment->wildcard)
+		{ return segment->index >= array->count || JSN_QueryWalk(query, i + 1, &array->values[segment->index], callback, userdata, matches); }
+
+		for (size_t j = 0; j < array->count; ++j)
+		{
+			if (!JSN_QueryWalk(query, i + 1, &array->values[j], callback, userdata, matches))
+			{ return false; }
+		}
+	}
+	else if (value->type == JSN_TYPE_OBJECT)
+	{
+		JSN_Object* object = value->object_value;
+
+		if (!segment->wildcard)
+		{
+			JSN_Property* prop = JSN_ObjectFind(object, segment->key, segment->key_length);
+			return prop == NULL || JSN_QueryWalk(query, i + 1, &prop->value, callback, userdata, matches);
+		}
+
+		for (size_t j = 0; j < object->count; ++j)
+		{
+			if (!JSN_QueryWalk(query, i + 1, &object->properties[j].value, callback, userdata, matches))
+			{ return false; }
+		}
+	}
+
+	return true;
+}
+
+
+size_t JSN_QueryValue(const JSN_Query* query, JSN_Value* value, JSN_QueryCallback callback, void* userdata)
+{
+	size_t matches = 0;
+	JSN_QueryWalk(query, 0, value, callback, userdata, &matches);
+	return matches;
+}
+
+
+static bool JSN_QueryFirstCallback(void* userdata, JSN_Value* value)
+{
+	*(JSN_Value**)userdata = value;
+	return false;
+}
+
+
+JSN_Value* JSN_QueryFirst(const JSN_Query* query, JSN_Value* value)
+{
+	JSN_Value* first = NULL;
+	JSN_QueryValue(query, value, JSN_QueryFirstCallback, &first);
+	return first;
+}
+
+
+struct JSN_QueryLevel
+{
+	size_t index;				/**< Index of the next element, if the container is an array. */
+	bool array;
+};
+
+
+/**
+ * @brief Reader interface forwarding the events of matching values to another reader interface.
+ * 
+ * @note Only the containers along the path of a possible match are tracked, anything else being skipped without being forwarded.
+ */
+struct JSN_QueryFilter
+{
+	const JSN_Query* query;
+	const JSN_ReaderInterface* iface;
+	void* userdata;
+	size_t depth;				/**< Number of open containers. */
+	size_t matched;				/**< Number of open containers matching the leading segments of the query. */
+	size_t forward_depth;		/**< Depth of the match being forwarded, or zero if none. */
+	bool key_matches;			/**< Whether the last key of the innermost matching object matches. */
+	JSN_QueryLevel* levels;		/**< State of each matching container, indexed by depth. */
+};
+
+
+enum JSN_FilterMatch
+{
+	JSN_FILTER_SKIP,			/**< The value can't contain any match. */
+	JSN_FILTER_DESCEND,			/**< The value matches the leading segments of the query. */
+	JSN_FILTER_MATCH,			/**< The value matches the whole query. */
+};
+
+
+/**
+ * @brief Match the next value against the query, knowing that no match is being forwarded.
+ */
+static JSN_FilterMatch JSN_QueryFilterMatch(JSN_QueryFilter* filter)
+{
+	size_t depth = filter->depth;
+
+	if (depth != filter->matched)
+	{ return JSN_FILTER_SKIP; }
+
+	// The root is matched by an empty query, and its children by the first segment.
+	if (depth > 0)
+	{
+		JSN_QueryLevel* level = &filter->levels[depth];
+		bool matches = level->array ? JSN_SegmentMatchesIndex(&filter->query->segments[depth - 1], level->index++) : filter->key_matches;
+
+		if (!matches)
+		{ return JSN_FILTER_SKIP; }
+	}
+
+	return depth == filter->query->count ? JSN_FILTER_MATCH : JSN_FILTER_DESCEND;
+}
+
+
+static bool JSN_QueryFilterKey(void* userdata, const char* key, size_t length)
+{
+	JSN_QueryFilter* filter = (JSN_QueryFilter*)userdata;
+
+	if (filter->forward_depth)
+	{ return filter->iface->key(filter->userdata, key, length); }
+
+	// Keys are only views during this call, so they are matched right away.
+	if (filter->depth == filter->matched && filter->depth > 0)
+	{ filter->key_matches = JSN_SegmentMatchesKey(&filter->query->segments[filter->depth - 1], key, length); }
+
+	return true;
+}
+
+
+static bool JSN_QueryFilterValue(void* userdata, JSN_Value* value)
+{
+	JSN_QueryFilter* filter = (JSN_QueryFilter*)userdata;
+
+	if (filter->forward_depth || JSN_QueryFilterMatch(filter) == JSN_FILTER_MATCH)
+	{ return filter->iface->value(filter->userdata, value); }
+
+	return true;
+}
+
+
+static bool JSN_QueryFilterOpen(JSN_QueryFilter* filter, bool array)
+{
+	if (filter->forward_depth)
+	{
+		++filter->depth;
+		return array ? filter->iface->open_array(filter->userdata) : filter->iface->open_object(filter->userdata);
+	}
+
+	JSN_FilterMatch match = JSN_QueryFilterMatch(filter);
+	++filter->depth;
+
+	if (match == JSN_FILTER_MATCH)
+	{
+		filter->forward_depth = filter->depth;
+		return array ? filter->iface->open_array(filter->userdata) : filter->iface->open_object(filter->userdata);
+	}
+
+	if (match == JSN_FILTER_DESCEND)
+	{
+		filter->matched = filter->depth;
+		filter->levels[filter->depth] = { 0, array };
+		filter->key_matches = false;
+	}
+
+	return true;
+}
+
+
+static bool JSN_QueryFilterClose(JSN_QueryFilter* filter, bool array, size_t length)
+{
+	if (filter->forward_depth)
+	{
+		if (filter->depth-- == filter->forward_depth)
+		{ filter->forward_depth = 0; }
+
+		return array ? filter->iface->close_array(filter->userdata, length) : filter->iface->close_object(filter->userdata, length);
+	}
+
+	if (filter->matched == filter->depth)
+	{ --filter->matched; }
+
+	--filter->depth;
+	return true;
+}
+
+
+static bool JSN_QueryFilterOpenArray(void* userdata)
+{ return JSN_QueryFilterOpen((JSN_QueryFilter*)userdata, true); }
+
+static bool JSN_QueryFilterCloseArray(void* userdata, size_t length)
+{ return JSN_QueryFilterClose((JSN_QueryFilter*)userdata, true, length); }
+
+static bool JSN_QueryFilterOpenObject(void* userdata)
+{ return JSN_QueryFilterOpen((JSN_QueryFilter*)userdata, false); }
+
+static bool JSN_QueryFilterCloseObject(void* userdata, size_t length)
+{ return JSN_QueryFilterClose((JSN_QueryFilter*)userdata, false, length); }
+
+
+static const JSN_ReaderInterface query_filter_iface
+{
+	.version = sizeof(JSN_ReaderInterface),
+	.key = JSN_QueryFilterKey,
+	.value = JSN_QueryFilterValue,
+	.open_array = JSN_QueryFilterOpenArray,
+	.close_array = JSN_QueryFilterCloseArray,
+	.open_object = JSN_QueryFilterOpenObject,
+	.close_object = JSN_QueryFilterCloseObject,
+};
+
+
+JSN_QueryFilter* JSN_CreateQueryFilter(const JSN_Query* query, const JSN_ReaderInterface* iface, void* userdata)
+{
+	// Only containers matching the query up to its last segment have their state kept.
+	JSN_QueryFilter* filter = (JSN_QueryFilter*)SDL_calloc(1, sizeof(JSN_QueryFilter) + (query->count + 1) * sizeof(JSN_QueryLevel));
+
+	if (filter == NULL)
+	{ return NULL; }
+
+	filter->query = query;
+	filter->iface = iface;
+	filter->userdata = userdata;
+	filter->levels = (JSN_QueryLevel*)(filter + 1);
+	return filter;
+}
+
+
+void JSN_DestroyQueryFilter(JSN_QueryFilter* filter)
+{
+	SDL_free(filter);
+}
+
+
+const JSN_ReaderInterface* JSN_GetQueryFilterInterface()
+{
+	return &query_filter_iface;
+}
+
+
+/* ==================================================
+	JSON UTILITY API
+================================================== */
+
+struct JSN_ReaderFrame
+{
+	size_t base;				/**< Index of this container's first pending child. */
+	const char* key;			/**< Key of this container within its parent object, if any. */
+	size_t key_length;
+};
+
+
+/**
+ * @brief Reader interface implementation that builds a chunk.
+ * 
+ * @note Children of open containers are kept on a stack until the container is closed,
+ *  at which point they are moved into the chunk in exactly sized storage.
+ */
+struct JSN_ChunkReader
+{
+	JSN_Chunk* result;
+	JSN_Value* target;			/**< Value receiving the top-level value, the root of the chunk by default. */
+	const char* key;
+	size_t key_length;
+	bool insitu;				/**< Whether strings & keys outlive the chunk, in which case they're referenced rather than copied. */
+
+	JSN_Property* pending;
+	size_t pending_count;
+	size_t pending_cap;
+
+	size_t depth;
+	JSN_ReaderFrame frames[JSN_MAX_DEPTH];
+};
+
+
+static void JSN_ChunkReaderInit(JSN_ChunkReader* reader)
+{
+	// Frames are left uninitialized until they're pushed.
+	SDL_memset(reader, 0, offsetof(JSN_ChunkReader, frames));
+	reader->result = JSN_CreateChunk();
+	reader->target = &reader->result->root;
+}
+
+
+static JSN_Chunk* JSN_ChunkReaderQuit(JSN_ChunkReader* reader, bool success)
+{
+	SDL_free(reader->pending);
+
+	if (success)
+	{ return reader->result; }
+
+	JSN_DestroyChunk(reader->result);
+	return NULL;
+}
+
+
+static bool JSN_ChunkReaderEmit(JSN_ChunkReader* reader, const JSN_Value* value)
+{
+	if (reader->depth == 0)
+	{
+		*reader->target = *value;
+		return true;
+	}
+
+	if (reader->pending_count == reader->pending_cap)
+	{
+		size_t cap = SDL_max(reader->pending_cap * 2, (size_t)64);
+		JSN_Property* pending = (JSN_Property*)SDL_realloc(reader->pending, cap * sizeof(JSN_Property));
+
+		if (pending == NULL)
+		{ return false; }
+
+		reader->pending = pending;
+		reader->pending_cap = cap;
+	}
+
+	JSN_Property* prop = &reader->pending[reader->pending_count++];
+	prop->value = *value;
+	prop->key = reader->key;
+	prop->key_length = reader->key_length;
+
+	return true;
+}
+
+
+static bool JSN_ChunkReaderPush(JSN_ChunkReader* reader)
+{
+	if (reader->depth == JSN_MAX_DEPTH)
+	{ return SDL_SetError("nesting deeper than %d levels encountered while reading JSON stream", JSN_MAX_DEPTH); }
+
+	JSN_ReaderFrame* frame = &reader->frames[reader->depth++];
+	frame->base = reader->pending_count;
+	frame->key = reader->key;
+	frame->key_length = reader->key_length;
+
+	return true;
+}
+
+
+static JSN_Property* JSN_ChunkReaderPop(JSN_ChunkReader* reader, size_t* count)
+{
+	JSN_ReaderFrame* top = &reader->frames[--reader->depth];
+	JSN_Property* children = &reader->pending[top->base];
+	*count = reader->pending_count - top->base;
+
+	reader->pending_count = top->base;
+	reader->key = top->key;
+	reader->key_length = top->key_length;
+
+	return children;
+}
+
+
+static bool JSN_ChunkReaderKey(void* userdata, const char* key, size_t length)
+{
+	JSN_ChunkReader* reader = (JSN_ChunkReader*)userdata;
+
+	reader->key = reader->insitu ? key : JSN_ChunkNewString(reader->result, key, length);
+	reader->key_length = length;
+
+	return true;
+}
+
+
+static bool JSN_ChunkReaderValue(void* userdata, JSN_Value* value)
+{
+	JSN_ChunkReader* reader = (JSN_ChunkReader*)userdata;
+
+	JSN_Value copy = *value;
+
+	if (copy.type == JSN_TYPE_STRING && !reader->insitu)
+	{ copy.string_value = JSN_ChunkNewString(reader->result, value->string_value, value->string_length); }
+
+	return JSN_ChunkReaderEmit(reader, &copy);
+}
+
+
+static bool JSN_ChunkReaderOpenArray(void* userdata)
+{
+	JSN_ChunkReader* reader = (JSN_ChunkReader*)userdata;
+	return JSN_ChunkReaderPush(reader);
+}
+
+
+static bool JSN_ChunkReaderCloseArray(void* userdata, size_t)
+{
+	JSN_ChunkReader* reader = (JSN_ChunkReader*)userdata;
+
+	size_t count;
+	JSN_Property* children = JSN_ChunkReaderPop(reader, &count);
+
+	JSN_Value value;
+	SDL_zero(value);
+	JSN_ChunkSetArray(reader->result, &value);
+
+	JSN_Array* array = value.array_value;
+	array->values = JSN_ChunkNewArray<JSN_Value>(reader->result, count);
+	array->count = array->capacity = count;
+
+	for (size_t i = 0; i < count; ++i)
+	{ array->values[i] = children[i].value; }
+
+	return JSN_ChunkReaderEmit(reader, &value);
+}
 
-	const char* token_data;
-	size_t token_size;
+
+static bool JSN_ChunkReaderOpenObject(void* userdata)
+{
+	JSN_ChunkReader* reader = (JSN_ChunkReader*)userdata;
+	return JSN_ChunkReaderPush(reader);
+}
+
+
+static bool JSN_ChunkReaderCloseObject(void* userdata, size_t)
+{
+	JSN_ChunkReader* reader = (JSN_ChunkReader*)userdata;
+
+	size_t count;
+	JSN_Property* children = JSN_ChunkReaderPop(reader, &count);
 
 	JSN_Value value;
 	SDL_zero(value);
+	JSN_ChunkSetObject(reader->result, &value);
+
+	JSN_Object* object = value.object_value;
+	object->properties = JSN_ChunkNewArray<JSN_Property>(reader->result, count);
+	object->count = object->capacity = count;
+
+	if (count)
+	{ SDL_memcpy(object->properties, children, count * sizeof(JSN_Property)); }
+
+	if (count > JSN_OBJECT_INDEX_THRESHOLD)
+	{ JSN_ChunkIndexObject(reader->result, object); }
+
+	return JSN_ChunkReaderEmit(reader, &value);
+}
+
+
+static const JSN_ReaderInterface chunk_reader_iface
+{
+	.version = sizeof(JSN_ReaderInterface),
+	.key = JSN_ChunkReaderKey,
+	.value = JSN_ChunkReaderValue,
+	.open_array = JSN_ChunkReaderOpenArray,
+	.close_array = JSN_ChunkReaderCloseArray,
+	.open_object = JSN_ChunkReaderOpenObject,
+	.close_object = JSN_ChunkReaderCloseObject,
+};
+
+
+JSN_Chunk* JSN_ReadChunkFromIO(SDL_IOStream* stream, bool closeio)
+{
+	JSN_ChunkReader reader;
+	JSN_ChunkReaderInit(&reader);
+
+	bool success = JSN_Read(stream, &chunk_reader_iface, &reader, closeio);
+
+	return JSN_ChunkReaderQuit(&reader, success);
+}
+
+
+JSN_Chunk* JSN_ReadChunkFromFile(const char* file)
+{
+	size_t length;
+	void* source = SDL_LoadFile(file, &length);
 
-	for (bool running = true; running;)
+	if (source == NULL)
+	{ return NULL; }
+
+	// Images built from this exact source are loaded instead of parsing it, any other image is rebuilt.
+	uint64_t hash = JSN_HashBytes(source, length);
+	char* cache = JSN_GetBinaryCachePath(file);
+	JSN_Chunk* chunk = NULL;
+
+	if (SDL_IOStream* stream = SDL_IOFromFile(cache, "rb"))
+	{
+		chunk = JSN_LoadImage(stream, hash, length);
+		SDL_CloseIO(stream);
+	}
+
+	if (chunk == NULL)
+	{
+		chunk = JSN_ReadChunkFromMem(source, length);
+
+		if (chunk && binary_cache.save)
+		{ JSN_SaveCachedImage(chunk, cache, hash, length); }
+	}
+
+	SDL_free(cache);
+	SDL_free(source);
+	return chunk;
+}
+
+
+/**
+ * @brief Maximum number of threads started by JSN_ReadChunksFromFiles(), on top of the calling thread.
+ */
+constexpr int JSN_MAX_READER_THREADS = 63;
+
+
+/**
+ * @brief Files read concurrently, handed out one at a time so that big files don't hold up the rest.
+ */
+struct JSN_FileBatch
+{
+	const char* const* files;
+	JSN_Chunk** chunks;
+	char** errors;
+	int count;
+	SDL_AtomicInt next;
+	SDL_AtomicInt failures;
+};
+
+
+static int SDLCALL JSN_FileBatchWorker(void* userdata)
+{
+	JSN_FileBatch* batch = (JSN_FileBatch*)userdata;
+
+	for (int i; (i = SDL_AddAtomicInt(&batch->next, 1)) < batch->count;)
 	{
-		switch (NextToken(&tokenizer, stream, &token_data, &token_size))
+		batch->chunks[i] = JSN_ReadChunkFromFile(batch->files[i]);
+		batch->errors[i] = NULL;
+
+		// Errors are thread-local, so they're captured before the next file overwrites them.
+		if (batch->chunks[i] == NULL)
 		{
-			case JSN_TOKEN_NONE:
-				running = false;
-				break;
+			batch->errors[i] = SDL_strdup(SDL_GetError());
+			SDL_AddAtomicInt(&batch->failures, 1);
+		}
+	}
 
-			case JSN_TOKEN_NULL:
-				value.type = JSN_TYPE_NULL;
-				if (!iface->value(userdata, &value))
-				{ return false; }
-				break;
+	return 0;
+}
 
-			case JSN_TOKEN_BOOL:
-				value.type = JSN_TYPE_BOOL;
-				value.bool_value = token_data[0] == 't';
-				if (!iface->value(userdata, &value))
-				{ return false; }
-				break;
 
-			case JSN_TOKEN_INTEGER:
-				value.type = JSN_TYPE_INTEGER;
-				value.integer_value = SDL_strtol(token_data, NULL, 10);
-				if (!iface->value(userdata, &value))
-				{ return false; }
-				break;
+bool JSN_ReadChunksFromFiles(const char* const* files, size_t count, JSN_Chunk** chunks, char** errors)
+{
+	if (count == 0)
+	{ return true; }
+
+	if (count > (size_t)SDL_MAX_SINT32)
+	{ return SDL_SetError("too many JSON files to read at once"); }
+
+	JSN_FileBatch batch;
+	SDL_zero(batch);
+	batch.files = files;
+	batch.chunks = chunks;
+	batch.errors = errors ? errors : (char**)SDL_calloc(count, sizeof(char*));
+	batch.count = (int)count;
+
+	if (batch.errors == NULL)
+	{ return false; }
+
+	// The calling thread works alongside one thread per other core, only as many as there are files to go around.
+	SDL_Thread* threads[JSN_MAX_READER_THREADS];
+	int num_threads = SDL_min(SDL_GetNumLogicalCPUCores(), batch.count) - 1;
+	num_threads = SDL_clamp(num_threads, 0, JSN_MAX_READER_THREADS);
+
+	for (int i = 0; i < num_threads; ++i)
+	{
+		// Failing to create a thread only means fewer workers.
+		if ((threads[i] = SDL_CreateThread(JSN_FileBatchWorker, "JSN_ReadChunksFromFiles", &batch)) == NULL)
+		{
+			num_threads = i;
+			break;
+		}
+	}
+
+	JSN_FileBatchWorker(&batch);
+
+	for (int i = 0; i < num_threads; ++i)
+	{ SDL_WaitThread(threads[i], NULL); }
+
+	int failures = SDL_GetAtomicInt(&batch.failures);
+
+	if (failures > 0)
+	{
+		int first = 0;
+
+		while (batch.chunks[first])
+		{ ++first; }
+
+		SDL_SetError("failed to read %d of %d JSON files, first %s: %s", failures, batch.count, files[first], batch.errors[first]);
+	}
+
+	if (errors == NULL)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{ SDL_free(batch.errors[i]); }
+
+		SDL_free(batch.errors);
+	}
+
+	return failures == 0;
+}
+
+
+JSN_Chunk* JSN_ReadChunkFromMem(const void* mem, size_t length)
+{
+	JSN_ChunkReader reader;
+	JSN_ChunkReaderInit(&reader);
+
+	// Copy the input into the chunk once so that strings & keys may be decoded & referenced in place.
+	void* copy = JSN_ChunkAlloc(reader.result, length, 1);
+	SDL_memcpy(copy, mem, length);
+	reader.insitu = true;
+
+	bool success = JSN_ReadInSitu(copy, length, &chunk_reader_iface, &reader);
+
+	return JSN_ChunkReaderQuit(&reader, success);
+}
+
+
+JSN_Chunk* JSN_ReadChunkInSitu(void* mem, size_t length)
+{
+	JSN_ChunkReader reader;
+	JSN_ChunkReaderInit(&reader);
+	reader.insitu = true;
+
+	bool success = JSN_ReadInSitu(mem, length, &chunk_reader_iface, &reader);
+
+	return JSN_ChunkReaderQuit(&reader, success);
+}
+
+
+/**
+ * @brief Reader interface implementation that builds the top level of a lazy chunk's container,
+ *  leaving the containers nested within it to be read later.
+ */
+struct JSN_LazyReader
+{
+	JSN_ChunkReader builder;
+	const JSN_Tokenizer* tokenizer;
+	Sint64 base;				/**< Offset of the tokenizer's input within the source of the chunk. */
+	Sint64 skip_offset;			/**< Offset of the nested container being skipped. */
+	size_t skip_depth;			/**< Depth within the nested container being skipped, zero when not skipping. */
+};
+
+
+static bool JSN_LazyReaderKey(void* userdata, const char* key, size_t length)
+{
+	JSN_LazyReader* reader = (JSN_LazyReader*)userdata;
+	return reader->skip_depth || JSN_ChunkReaderKey(&reader->builder, key, length);
+}
+
+
+static bool JSN_LazyReaderValue(void* userdata, JSN_Value* value)
+{
+	JSN_LazyReader* reader = (JSN_LazyReader*)userdata;
+	return reader->skip_depth || JSN_ChunkReaderValue(&reader->builder, value);
+}
+
+
+static bool JSN_LazyReaderOpen(JSN_LazyReader* reader)
+{
+	if (reader->skip_depth == 0 && reader->builder.depth == 0)
+	{ return JSN_ChunkReaderPush(&reader->builder); }
+
+	// The opening bracket was just read.
+	if (reader->skip_depth++ == 0)
+	{ reader->skip_offset = reader->base + JSN_TokenizerTell(reader->tokenizer) - 1; }
+
+	return true;
+}
+
+
+static bool JSN_LazyReaderClose(JSN_LazyReader* reader, bool array, size_t count)
+{
+	if (reader->skip_depth == 0)
+	{ return array ? JSN_ChunkReaderCloseArray(&reader->builder, count) : JSN_ChunkReaderCloseObject(&reader->builder, count); }
+
+	if (--reader->skip_depth)
+	{ return true; }
+
+	JSN_Chunk* chunk = reader->builder.result;
+
+	JSN_Value value;
+	SDL_zero(value);
+
+	if (array)
+	{ JSN_ChunkSetArray(chunk, &value); }
+	else
+	{ JSN_ChunkSetObject(chunk, &value); }
+
+	// Empty containers are as good as read already.
+	if (count)
+	{
+		JSN_Lazy* lazy = JSN_ChunkNew<JSN_Lazy>(chunk);
+		lazy->offset = reader->skip_offset;
+		lazy->length = (size_t)(reader->base + JSN_TokenizerTell(reader->tokenizer) - reader->skip_offset);
+
+		if (array)
+		{ value.array_value->lazy = lazy; }
+		else
+		{ value.object_value->lazy = lazy; }
+	}
+
+	return JSN_ChunkReaderEmit(&reader->builder, &value);
+}
+
+
+static bool JSN_LazyReaderOpenArray(void* userdata)
+{ return JSN_LazyReaderOpen((JSN_LazyReader*)userdata); }
+
+static bool JSN_LazyReaderCloseArray(void* userdata, size_t count)
+{ return JSN_LazyReaderClose((JSN_LazyReader*)userdata, true, count); }
+
+static bool JSN_LazyReaderOpenObject(void* userdata)
+{ return JSN_LazyReaderOpen((JSN_LazyReader*)userdata); }
+
+static bool JSN_LazyReaderCloseObject(void* userdata, size_t count)
+{ return JSN_LazyReaderClose((JSN_LazyReader*)userdata, false, count); }
+
+
+static const JSN_ReaderInterface lazy_reader_iface
+{
+	.version = sizeof(JSN_ReaderInterface),
+	.key = JSN_LazyReaderKey,
+	.value = JSN_LazyReaderValue,
+	.open_array = JSN_LazyReaderOpenArray,
+	.close_array = JSN_LazyReaderCloseArray,
+	.open_object = JSN_LazyReaderOpenObject,
+	.close_object = JSN_LazyReaderCloseObject,
+};
+
+
+/**
+ * @brief Build the top level of the JSON data read by a tokenizer into a value of a lazy chunk.
+ */
+static bool JSN_ReadLazyLevel(JSN_Chunk* chunk, JSN_Value* target, JSN_Tokenizer* tokenizer, Sint64 base)
+{
+	JSN_LazyReader reader;
+	SDL_memset(&reader.builder, 0, offsetof(JSN_ChunkReader, frames));
+	reader.builder.result = chunk;
+	reader.builder.target = target;
+	reader.tokenizer = tokenizer;
+	reader.base = base;
+	reader.skip_offset = 0;
+	reader.skip_depth = 0;
+
+	bool success = JSN_ReadTokens(tokenizer, &lazy_reader_iface, &reader);
+
+	SDL_free(reader.builder.pending);
+	return success;
+}
+
+
+static bool JSN_LoadLazy(JSN_Lazy* lazy, const JSN_Value* value)
+{
+	if (lazy->shared.type != JSN_TYPE_EMPTY)
+	{ return JSN_LoadShared(lazy, value); }
+
+	JSN_Chunk* chunk = value->type == JSN_TYPE_ARRAY ? value->array_value->chunk : value->object_value->chunk;
+	char* data = (char*)SDL_malloc(lazy->length);
+
+	if (data == NULL)
+	{ return false; }
+
+	if (SDL_SeekIO(chunk->source, lazy->offset, SDL_IO_SEEK_SET) != lazy->offset || SDL_ReadIO(chunk->source, data, lazy->length) != lazy->length)
+	{
+		SDL_free(data);
+		return SDL_SetError("failed to read back container of lazy JSON chunk");
+	}
+
+	JSN_Tokenizer tokenizer;
+	JSN_TokenizerInitMem(&tokenizer, data, lazy->length);
+
+	JSN_Value loaded;
+	SDL_zero(loaded);
+	bool success = JSN_ReadLazyLevel(chunk, &loaded, &tokenizer, lazy->offset);
+
+	SDL_free(data);
+
+	if (success && loaded.type != value->type)
+	{ success = SDL_SetError("source of lazy JSON chunk changed since it was read"); }
+
+	// Children are moved into the existing container, so that pointers to it stay valid, leaving its share count as is.
+	if (success && value->type == JSN_TYPE_ARRAY)
+	{
+		JSN_Array* array = value->array_value;
+		array->values = loaded.array_value->values;
+		array->count = loaded.array_value->count;
+		array->capacity = loaded.array_value->capacity;
+		array->lazy = NULL;
+	}
+	else if (success)
+	{
+		JSN_Object* object = value->object_value;
+		object->properties = loaded.object_value->properties;
+		object->count = loaded.object_value->count;
+		object->capacity = loaded.object_value->capacity;
+		object->index = loaded.object_value->index;
+		object->index_capacity = loaded.object_value->index_capacity;
+		object->lazy = NULL;
+	}
+
+	return success;
+}
+
+
+JSN_Chunk* JSN_ReadLazyChunkFromIO(SDL_IOStream* stream, bool closeio)
+{
+	if (stream == NULL)
+	{ return NULL; }
+
+	if (SDL_TellIO(stream) < 0)
+	{
+		SDL_SetError("lazy JSON chunks must be read from seekable streams");
+
+		if (closeio)
+		{ SDL_CloseIO(stream); }
+
+		return NULL;
+	}
+
+	JSN_Chunk* chunk = JSN_CreateChunk();
+
+	JSN_Tokenizer tokenizer;
+	JSN_TokenizerInit(&tokenizer, stream);
+
+	if (!JSN_ReadLazyLevel(chunk, &chunk->root, &tokenizer, 0))
+	{
+		if (closeio)
+		{ SDL_CloseIO(stream); }
+
+		JSN_DestroyChunk(chunk);
+		return NULL;
+	}
 
-			case JSN_TOKEN_NUMBER:
-				value.type = JSN_TYPE_NUMBER;
-				value.number_value = SDL_strtod(token_data, NULL);
-				if (!iface->value(userdata, &value))
-				{ return false; }
-				break;
+	chunk->source = stream;
+	chunk->closeio = closeio;
+	return chunk;
+}
 
-			case JSN_TOKEN_ARRAY_OPEN:
-				if (!iface->open_array(userdata))
-				{ return false; }
-				break;
 
-			case JSN_TOKEN_ARRAY_CLOSE:
-				if (!iface->close_array(userdata, 0))
-				{ return false; }
-				break;
+JSN_Chunk* JSN_ReadLazyChunkFromFile(const char* file)
+{
+	return JSN_ReadLazyChunkFromIO(SDL_IOFromFile(file, "rb"), true);
+}
 
-			case JSN_TOKEN_OBJECT_OPEN:
-				if (!iface->open_object(userdata))
-				{ return false; }
-				break;
 
-			case JSN_TOKEN_OBJECT_CLOSE:
-				if (!iface->close_object(userdata, 0))
-				{ return false; }
-				break;
+bool JSN_WriteChunkToFile(JSN_Chunk* chunk, const char* file, bool pretty)
+{
+	return JSN_Write(SDL_IOFromFile(file, "wb"), JSN_GetChunkRoot(chunk), pretty, true);
+}
 
-			default:
-				running = false;
-				break;
-		}
-	}
 
-	JSN_TokenizerQuit(&tokenizer);
+JSN_Chunk* JSN_ReadQueryFromIO(SDL_IOStream* stream, const JSN_Query* query, bool closeio)
+{
+	JSN_ChunkReader reader;
+	JSN_ChunkReaderInit(&reader);
 
-	bool success = SDL_GetIOStatus(stream) == SDL_IO_STATUS_EOF;
+	// Matches are gathered as the elements of the root array.
+	JSN_QueryFilter* filter = JSN_CreateQueryFilter(query, &chunk_reader_iface, &reader);
 
-	if (closeio)
-	{ SDL_CloseIO(stream); }
+	if (filter == NULL || !JSN_ChunkReaderOpenArray(&reader))
+	{
+		if (closeio)
+		{ SDL_CloseIO(stream); }
 
-	return success;
+		JSN_DestroyQueryFilter(filter);
+		return JSN_ChunkReaderQuit(&reader, false);
+	}
+
+	bool success = JSN_Read(stream, &query_filter_iface, filter, closeio) && JSN_ChunkReaderCloseArray(&reader, 0);
+
+	JSN_DestroyQueryFilter(filter);
+	return JSN_ChunkReaderQuit(&reader, success);
 }
 
 
 /* ==================================================
-	JSON UTILITY API
+	JSON HOT RELOAD API
 ================================================== */
 
-struct JSN_ReaderFrame
+/**
+ * @brief Number of elements looked ahead of a mismatch when patching arrays, to tell insertions & removals from modifications.
+ */
+constexpr size_t JSN_PATCH_LOOKAHEAD = 32;
+
+/**
+ * @brief Hash of a value & of its descendants, mirroring its structure.
+ */
+struct JSN_HashNode
 {
-	JSN_Value* value;
-	JSN_ReaderFrame* parent;
+	uint64_t hash;
+	JSN_HashNode* children;		/**< Hashes of the elements or properties of a container, in the same order. */
 };
 
 
-struct JSN_ChunkReader
+struct JSN_Patcher
 {
-	JSN_Chunk* result;
-	JSN_ReaderFrame* top;
-	const char* key;
-	size_t key_length;
+	JSN_Chunk* chunk;			/**< Chunk of the patched value. */
+	JSN_Chunk* scratch;			/**< Chunk holding hashes, paths & changes until the patch is done. */
+	char* path;					/**< JSON Pointer to the value being patched. */
+	size_t path_length;
+	size_t path_capacity;
+	JSN_Change* changes;
+	size_t change_count;
+	size_t change_capacity;
+};
+
+
+struct JSN_ReloadSubscriber
+{
+	char* path;
+	JSN_ChangeCallback callback;
+	void* userdata;
+};
+
+
+struct JSN_Reloader
+{
+	char* file;
+	JSN_Chunk* chunk;
+	SDL_Time modify_time;		/**< Modification time of the file when it was last read. */
+	JSN_ReloadSubscriber* subscribers;
+	size_t subscriber_count;
+	size_t subscriber_capacity;
 };
 
 
-static JSN_ReaderFrame* JSN_ChunkReaderPush(JSN_ChunkReader* reader)
+static uint64_t JSN_HashMix(uint64_t hash, uint64_t value)
+{
+	constexpr uint64_t P1 = 0x9E3779B185EBCA87, P2 = 0xC2B2AE3D27D4EB4F;
+
+	hash = std::rotl(hash ^ (value * P2), 31) * P1;
+	return hash ^ (hash >> 29);
+}
+
+
+/**
+ * @brief Hash a value & each of its descendants, reading containers of lazy chunks & copies along the way.
+ */
+static bool JSN_HashTree(JSN_Chunk* scratch, const JSN_Value* value, JSN_HashNode* node)
 {
-	JSN_ReaderFrame* frame = (JSN_ReaderFrame*)SDL_malloc(sizeof(JSN_ReaderFrame));
-	SDL_zerop(frame);
+	if (!JSN_LoadContainer(value))
+	{ return false; }
 
-	if (reader->top)
+	uint64_t hash = JSN_HashMix(0, value->type);
+	node->children = NULL;
+
+	switch (value->type)
 	{
-		switch (reader->top->value->type)
+		case JSN_TYPE_BOOL:
+			hash = JSN_HashMix(hash, value->bool_value);
+			break;
+
+		case JSN_TYPE_INTEGER:
+			hash = JSN_HashMix(hash, (uint64_t)value->integer_value);
+			break;
+
+		case JSN_TYPE_NUMBER:
 		{
-			case JSN_TYPE_ARRAY:
-				frame->value = JSN_ChunkAddElement(reader->result, reader->top->value, NULL, NULL);
-				break;
+			uint64_t bits;
+			SDL_memcpy(&bits, &value->number_value, sizeof(bits));
+			hash = JSN_HashMix(hash, bits);
+			break;
+		}
 
-			case JSN_TYPE_OBJECT:
-				frame->value = JSN_ChunkAddProperty(reader->result, reader->top->value, NULL, NULL, reader->key, reader->key_length);
-				break;
+		case JSN_TYPE_STRING:
+			hash = JSN_HashMix(hash, JSN_HashBytes(value->string_value, value->string_length));
+			break;
+
+		case JSN_TYPE_ARRAY:
+		{
+			const JSN_Array* array = value->array_value;
+			node->children = JSN_ChunkNewArray<JSN_HashNode>(scratch, array->count);
+
+			for (size_t i = 0; i < array->count; ++i)
+			{
+				if (!JSN_HashTree(scratch, &array->values[i], &node->children[i]))
+				{ return false; }
+
+				hash = JSN_HashMix(hash, node->children[i].hash);
+			}
+			break;
+		}
+
+		case JSN_TYPE_OBJECT:
+		{
+			const JSN_Object* object = value->object_value;
+			node->children = JSN_ChunkNewArray<JSN_HashNode>(scratch, object->count);
+
+			// Properties are summed up, so that objects whose properties were merely reordered hash the same.
+			uint64_t sum = 0;
+
+			for (size_t i = 0; i < object->count; ++i)
+			{
+				const JSN_Property* prop = &object->properties[i];
+
+				if (!JSN_HashTree(scratch, &prop->value, &node->children[i]))
+				{ return false; }
+
+				sum += JSN_HashMix(JSN_HashBytes(prop->key, prop->key_length), node->children[i].hash);
+			}
+
+			hash = JSN_HashMix(hash, sum);
+			break;
 		}
 
-		frame->parent = reader->top;
-		reader->top = frame;
+		default:
+			break;
 	}
-	else
+
+	node->hash = hash;
+	return true;
+}
+
+
+/**
+ * @brief Append a segment to the path of the value being patched, escaping it as a JSON Pointer.
+ * 
+ * @returns the length of the path beforehand, to be restored once done with the segment.
+ */
+static size_t JSN_PatcherPush(JSN_Patcher* patcher, const char* segment, size_t length)
+{
+	size_t previous = patcher->path_length;
+
+	// Escaped characters take two, plus the separator & the terminator.
+	while (patcher->path_capacity < previous + length * 2 + 2)
+	{ patcher->path = JSN_ChunkGrowArray(patcher->scratch, patcher->path, previous, &patcher->path_capacity); }
+
+	char* out = patcher->path + previous;
+	*out++ = '/';
+
+	for (size_t i = 0; i < length; ++i)
 	{
-		frame->value = &reader->result->root;
-		reader->top = frame;
+		if (segment[i] == '~' || segment[i] == '/')
+		{
+			*out++ = '~';
+			*out++ = segment[i] == '~' ? '0' : '1';
+		}
+		else
+		{ *out++ = segment[i]; }
 	}
 
-	return frame;
+	patcher->path_length = out - patcher->path;
+	return previous;
 }
 
 
-static void JSN_ChunkReaderPop(JSN_ChunkReader* reader)
+static size_t JSN_PatcherPushIndex(JSN_Patcher* patcher, size_t index)
 {
-	JSN_ReaderFrame* top = reader->top;
-	reader->top = top->parent;
-	SDL_free(top);
+	char segment[24];
+	int length = SDL_snprintf(segment, sizeof(segment), "%zu", index);
+	return JSN_PatcherPush(patcher, segment, length);
 }
 
 
-static bool JSN_ChunkReaderKey(void* userdata, const char* key, size_t length)
+static void JSN_PatcherRecord(JSN_Patcher* patcher, JSN_ChangeType type, const JSN_Value* old_value, JSN_Value* value)
 {
-	JSN_ChunkReader* reader = (JSN_ChunkReader*)userdata;
+	if (patcher->change_count == patcher->change_capacity)
+	{ patcher->changes = JSN_ChunkGrowArray(patcher->scratch, patcher->changes, patcher->change_count, &patcher->change_capacity); }
 
-	char* copy = (char*)SDL_calloc(length + 1, sizeof(char));
-	SDL_strlcpy(copy, key, length);
-	reader->key = copy;
-	reader->key_length = length;
+	JSN_Change* change = &patcher->changes[patcher->change_count++];
+	change->type = type;
+	change->path = JSN_ChunkNewString(patcher->scratch, patcher->path, patcher->path_length);
+	change->value = value;
 
-	return true;
+	if (old_value)
+	{ change->old_value = *old_value; }
+	else
+	{ SDL_zero(change->old_value); }
 }
 
 
-static bool JSN_ChunkReaderValue(void* userdata, JSN_Value* value)
+static void JSN_PatchValue(JSN_Patcher* patcher, JSN_Value* value, const JSN_HashNode* node, const JSN_Value* target, const JSN_HashNode* target_node);
+
+
+/**
+ * @brief Look for a hash among the next few nodes, getting its distance or 0 if it isn't found.
+ */
+static size_t JSN_HashLookahead(const JSN_HashNode* nodes, size_t count, uint64_t hash)
 {
-	JSN_ChunkReader* reader = (JSN_ChunkReader*)userdata;
+	count = SDL_min(count, JSN_PATCH_LOOKAHEAD);
+
+	for (size_t k = 1; k < count; ++k)
+	{
+		if (nodes[k].hash == hash)
+		{ return k; }
+	}
+
+	return 0;
+}
+
+
+static void JSN_PatchArray(JSN_Patcher* patcher, JSN_Value* value, const JSN_HashNode* node, const JSN_Value* target, const JSN_HashNode* target_node)
+{
+	if (JSN_IsShared(value))
+	{ JSN_DetachContainer(patcher->chunk, value); }
+
+	JSN_Array* array = value->array_value;
+	const JSN_Array* target_array = target->array_value;
+	const JSN_HashNode* nodes = node->children;
+	const JSN_HashNode* target_nodes = target_node->children;
+	size_t count = array->count;
+	size_t target_count = target_array->count;
+
+	// Matching elements at the end are set aside first, so that runs of insertions or removals longer than the lookahead still line up.
+	size_t suffix = 0;
+	while (suffix < SDL_min(count, target_count) && nodes[count - 1 - suffix].hash == target_nodes[target_count - 1 - suffix].hash)
+	{ ++suffix; }
+
+	// Each element of the target is given the element of the array it comes from, or SIZE_MAX if it's inserted.
+	// Elements found a little further in the other array are taken to be inserted or removed, the others to be modified.
+	size_t* sources = JSN_ChunkNewArray<size_t>(patcher->scratch, target_count);
+	size_t i = 0;
+	size_t j = 0;
+	size_t added = 0;
+
+	while (i < count - suffix && j < target_count - suffix)
+	{
+		if (nodes[i].hash == target_nodes[j].hash)
+		{
+			sources[j++] = i++;
+			continue;
+		}
+
+		size_t insertion = JSN_HashLookahead(&target_nodes[j], target_count - suffix - j, nodes[i].hash);
+		size_t removal = JSN_HashLookahead(&nodes[i], count - suffix - i, target_nodes[j].hash);
+
+		if (insertion && (removal == 0 || insertion <= removal))
+		{
+			for (size_t k = 0; k < insertion; ++k)
+			{ sources[j++] = SIZE_MAX; }
+
+			added += insertion;
+		}
+		else if (removal)
+		{ i += removal; }
+		else
+		{ sources[j++] = i++; }
+	}
+
+	for (; j < target_count - suffix; ++j, ++added)
+	{ sources[j] = SIZE_MAX; }
+
+	for (size_t k = 0; k < suffix; ++k)
+	{ sources[target_count - suffix + k] = count - suffix + k; }
 
-	if (reader->top)
+	if (added || count != target_count)
 	{
-		switch (reader->top->value->type)
+		JSN_Value* values = JSN_ChunkNewArray<JSN_Value>(patcher->chunk, target_count);
+		size_t next = 0;
+
+		for (j = 0; j < target_count; ++j)
 		{
-			case JSN_TYPE_ARRAY:
-				return JSN_ChunkCopy(reader->result, JSN_ChunkAddElement(reader->result, reader->top->value, NULL, NULL), value);
+			if (sources[j] == SIZE_MAX)
+			{ continue; }
 
-			case JSN_TYPE_OBJECT:
-				return JSN_ChunkCopy(reader->result, JSN_ChunkAddProperty(reader->result, reader->top->value, NULL, NULL, reader->key, reader->key_length), value);
+			// Elements skipped since the last one kept were removed.
+			for (; next < sources[j]; ++next)
+			{
+				size_t previous = JSN_PatcherPushIndex(patcher, next);
+				JSN_PatcherRecord(patcher, JSN_CHANGE_REMOVED, &array->values[next], NULL);
+				patcher->path_length = previous;
+			}
 
-			default:
-				return false;
+			values[j] = array->values[next++];
+		}
+
+		for (; next < count; ++next)
+		{
+			size_t previous = JSN_PatcherPushIndex(patcher, next);
+			JSN_PatcherRecord(patcher, JSN_CHANGE_REMOVED, &array->values[next], NULL);
+			patcher->path_length = previous;
+		}
+
+		for (j = 0; j < target_count; ++j)
+		{
+			if (sources[j] != SIZE_MAX)
+			{ continue; }
+
+			SDL_zero(values[j]);
+			JSN_CopyValue(patcher->chunk, &values[j], &target_array->values[j]);
+
+			size_t previous = JSN_PatcherPushIndex(patcher, j);
+			JSN_PatcherRecord(patcher, JSN_CHANGE_ADDED, NULL, &values[j]);
+			patcher->path_length = previous;
+		}
+
+		array->values = values;
+		array->count = array->capacity = target_count;
+	}
+
+	for (j = 0; j < target_count; ++j)
+	{
+		if (sources[j] == SIZE_MAX)
+		{ continue; }
+
+		size_t previous = JSN_PatcherPushIndex(patcher, j);
+		JSN_PatchValue(patcher, &array->values[j], &nodes[sources[j]], &target_array->values[j], &target_nodes[j]);
+		patcher->path_length = previous;
+	}
+}
+
+
+static void JSN_PatchObject(JSN_Patcher* patcher, JSN_Value* value, const JSN_HashNode* node, const JSN_Value* target, const JSN_HashNode* target_node)
+{
+	if (JSN_IsShared(value))
+	{ JSN_DetachContainer(patcher->chunk, value); }
+
+	JSN_Object* object = value->object_value;
+	const JSN_Object* target_object = target->object_value;
+
+	// Properties are matched by key, each one of the object being kept if the target has it.
+	const JSN_HashNode* nodes = node->children;
+	size_t* matches = JSN_ChunkNewArray<size_t>(patcher->scratch, object->count);
+	size_t kept = 0;
+	size_t added = 0;
+
+	for (size_t i = 0; i < object->count; ++i)
+	{
+		const JSN_Property* prop = &object->properties[i];
+		const JSN_Property* match = JSN_ObjectFind(target_object, prop->key, prop->key_length);
+		matches[i] = match ? match - target_object->properties : SIZE_MAX;
+		kept += match != NULL;
+	}
+
+	for (size_t i = 0; i < target_object->count; ++i)
+	{
+		const JSN_Property* prop = &target_object->properties[i];
+		added += JSN_ObjectFind(object, prop->key, prop->key_length) == NULL;
+	}
+
+	if (kept != object->count || added)
+	{
+		size_t count = kept + added;
+		JSN_Property* properties = JSN_ChunkNewArray<JSN_Property>(patcher->chunk, count);
+		JSN_HashNode* kept_nodes = JSN_ChunkNewArray<JSN_HashNode>(patcher->scratch, kept);
+		size_t* kept_matches = JSN_ChunkNewArray<size_t>(patcher->scratch, kept);
+		size_t k = 0;
+
+		for (size_t i = 0; i < object->count; ++i)
+		{
+			const JSN_Property* prop = &object->properties[i];
+
+			if (matches[i] == SIZE_MAX)
+			{
+				size_t previous = JSN_PatcherPush(patcher, prop->key, prop->key_length);
+				JSN_PatcherRecord(patcher, JSN_CHANGE_REMOVED, &prop->value, NULL);
+				patcher->path_length = previous;
+				continue;
+			}
+
+			properties[k] = *prop;
+			kept_nodes[k] = nodes[i];
+			kept_matches[k++] = matches[i];
+		}
+
+		// New properties are appended, in the order of the target.
+		for (size_t i = 0; i < target_object->count; ++i)
+		{
+			const JSN_Property* source = &target_object->properties[i];
+
+			if (JSN_ObjectFind(object, source->key, source->key_length))
+			{ continue; }
+
+			JSN_Property* prop = &properties[k++];
+			SDL_zerop(prop);
+			prop->key = JSN_ChunkNewString(patcher->chunk, source->key, source->key_length);
+			prop->key_length = source->key_length;
+			JSN_CopyValue(patcher->chunk, &prop->value, &source->value);
+
+			size_t previous = JSN_PatcherPush(patcher, prop->key, prop->key_length);
+			JSN_PatcherRecord(patcher, JSN_CHANGE_ADDED, NULL, &prop->value);
+			patcher->path_length = previous;
 		}
+
+		object->properties = properties;
+		object->count = object->capacity = count;
+		object->index = NULL;
+		object->index_capacity = 0;
+
+		if (count > JSN_OBJECT_INDEX_THRESHOLD)
+		{ JSN_ChunkIndexObject(patcher->chunk, object); }
+
+		nodes = kept_nodes;
+		matches = kept_matches;
 	}
+
+	for (size_t i = 0; i < kept; ++i)
+	{
+		JSN_Property* prop = &object->properties[i];
+		size_t previous = JSN_PatcherPush(patcher, prop->key, prop->key_length);
+		JSN_PatchValue(patcher, &prop->value, &nodes[i], &target_object->properties[matches[i]].value, &target_node->children[matches[i]]);
+		patcher->path_length = previous;
+	}
+}
+
+
+static void JSN_PatchValue(JSN_Patcher* patcher, JSN_Value* value, const JSN_HashNode* node, const JSN_Value* target, const JSN_HashNode* target_node)
+{
+	if (node->hash == target_node->hash)
+	{ return; }
+
+	if (value->type == JSN_TYPE_ARRAY && target->type == JSN_TYPE_ARRAY)
+	{ JSN_PatchArray(patcher, value, node, target, target_node); }
+	else if (value->type == JSN_TYPE_OBJECT && target->type == JSN_TYPE_OBJECT)
+	{ JSN_PatchObject(patcher, value, node, target, target_node); }
 	else
 	{
-		return JSN_ChunkCopy(reader->result, &reader->result->root, value);
+		JSN_Value old_value = *value;
+		JSN_CopyValue(patcher->chunk, value, target);
+		JSN_PatcherRecord(patcher, JSN_CHANGE_MODIFIED, &old_value, value);
 	}
 }
 
 
-static bool JSN_ChunkReaderOpenArray(void* userdata)
+bool JSN_ChunkPatch(JSN_Chunk* chunk, JSN_Value* value, const JSN_Value* target, JSN_ChangeCallback callback, void* userdata)
 {
-	JSN_ChunkReader* reader = (JSN_ChunkReader*)userdata;
+	JSN_Patcher patcher;
+	SDL_zero(patcher);
+	patcher.chunk = chunk;
+	patcher.scratch = JSN_CreateChunk();
+	patcher.path = JSN_ChunkGrowArray<char>(patcher.scratch, NULL, 0, &patcher.path_capacity);
+
+	// Every container is read while hashing, so that nothing can fail once the value starts being patched.
+	JSN_HashNode node;
+	JSN_HashNode target_node;
+	bool success = JSN_HashTree(patcher.scratch, value, &node) && JSN_HashTree(patcher.scratch, target, &target_node);
+
+	if (success)
+	{
+		// Containers shared with other chunks are detached before being patched, starting with the ones leading to the value.
+		if (node.hash != target_node.hash)
+		{ value = JSN_ChunkUnshare(chunk, value); }
 
-	JSN_ReaderFrame* top = JSN_ChunkReaderPush(reader);
-	JSN_ChunkSetArray(reader->result, top->value);
+		JSN_PatchValue(&patcher, value, &node, target, &target_node);
 
-	return true;
+		if (callback && patcher.change_count)
+		{ callback(userdata, patcher.changes, patcher.change_count); }
+	}
+
+	JSN_DestroyChunk(patcher.scratch);
+	return success;
 }
 
 
-static bool JSN_ChunkReaderCloseArray(void* userdata, size_t)
+JSN_Reloader* JSN_CreateReloader(const char* file)
 {
-	JSN_ChunkReader* reader = (JSN_ChunkReader*)userdata;
-	JSN_ChunkReaderPop(reader);
-	return true;
+	// The file is checked before being read, so that changes made meanwhile are read again by the next reload.
+	SDL_PathInfo info;
+
+	if (!SDL_GetPathInfo(file, &info))
+	{ return NULL; }
+
+	JSN_Chunk* chunk = JSN_ReadChunkFromFile(file);
+
+	if (chunk == NULL)
+	{ return NULL; }
+
+	JSN_Reloader* reloader = (JSN_Reloader*)SDL_calloc(1, sizeof(JSN_Reloader));
+	reloader->file = SDL_strdup(file);
+	reloader->chunk = chunk;
+	reloader->modify_time = info.modify_time;
+	return reloader;
 }
 
 
-static bool JSN_ChunkReaderOpenObject(void* userdata)
+void JSN_DestroyReloader(JSN_Reloader* reloader)
 {
-	JSN_ChunkReader* reader = (JSN_ChunkReader*)userdata;
+	if (reloader == NULL)
+	{ return; }
 
-	JSN_ReaderFrame* top = JSN_ChunkReaderPush(reader);
-	JSN_ChunkSetObject(reader->result, top->value);
+	for (size_t i = 0; i < reloader->subscriber_count; ++i)
+	{ SDL_free(reloader->subscribers[i].path); }
 
-	return true;
+	SDL_free(reloader->subscribers);
+	JSN_DestroyChunk(reloader->chunk);
+	SDL_free(reloader->file);
+	SDL_free(reloader);
 }
 
 
-static bool JSN_ChunkReaderCloseObject(void* userdata, size_t)
+JSN_Chunk* JSN_GetReloaderChunk(JSN_Reloader* reloader)
 {
-	JSN_ChunkReader* reader = (JSN_ChunkReader*)userdata;
-	JSN_ChunkReaderPop(reader);
+	return reloader->chunk;
+}
+
+
+bool JSN_SubscribeReloader(JSN_Reloader* reloader, const char* path, JSN_ChangeCallback callback, void* userdata)
+{
+	if (*path != '\0' && *path != '/')
+	{ return SDL_SetError("invalid JSON Pointer to subscribe to: %s", path); }
+
+	if (reloader->subscriber_count == reloader->subscriber_capacity)
+	{
+		size_t cap = SDL_max(reloader->subscriber_capacity * 2, (size_t)4);
+		JSN_ReloadSubscriber* subscribers = (JSN_ReloadSubscriber*)SDL_realloc(reloader->subscribers, cap * sizeof(JSN_ReloadSubscriber));
+
+		if (subscribers == NULL)
+		{ return false; }
+
+		reloader->subscribers = subscribers;
+		reloader->subscriber_capacity = cap;
+	}
+
+	char* copy = SDL_strdup(path);
+
+	if (copy == NULL)
+	{ return false; }
+
+	reloader->subscribers[reloader->subscriber_count++] = { copy, callback, userdata };
 	return true;
 }
 
 
-JSN_Chunk* JSN_ReadChunkFromIO(SDL_IOStream* stream, bool closeio)
+void JSN_UnsubscribeReloader(JSN_Reloader* reloader, JSN_ChangeCallback callback, void* userdata)
 {
-	static const JSN_ReaderInterface iface
+	size_t count = 0;
+
+	for (size_t i = 0; i < reloader->subscriber_count; ++i)
 	{
-		.version = sizeof(JSN_ReaderInterface),
-		.key = JSN_ChunkReaderKey,
-		.value = JSN_ChunkReaderValue,
-		.open_array = JSN_ChunkReaderOpenArray,
-		.close_array = JSN_ChunkReaderCloseArray,
-		.open_object = JSN_ChunkReaderOpenObject,
-		.close_object = JSN_ChunkReaderCloseObject,
-	};
+		JSN_ReloadSubscriber* subscriber = &reloader->subscribers[i];
 
-	JSN_ChunkReader reader;
-	SDL_zero(reader);
-	reader.result = JSN_CreateChunk();
+		if (subscriber->callback == callback && subscriber->userdata == userdata)
+		{ SDL_free(subscriber->path); }
+		else
+		{ reloader->subscribers[count++] = *subscriber; }
+	}
+
+	reloader->subscriber_count = count;
+}
 
-	if (JSN_Read(stream, &iface, &reader, closeio))
-	{ return reader.result; }
 
-	return NULL;
+/**
+ * @brief Check whether either of two JSON Pointers leads to the other or to one of its descendants.
+ */
+static bool JSN_PathsOverlap(const char* path, const char* other)
+{
+	size_t length = SDL_strlen(path);
+	size_t other_length = SDL_strlen(other);
+	size_t shortest = SDL_min(length, other_length);
+	const char* longest = length > other_length ? path : other;
+
+	return SDL_memcmp(path, other, shortest) == 0 && (longest[shortest] == '\0' || longest[shortest] == '/');
 }
 
 
-JSN_Chunk* JSN_ReadChunkFromFile(const char* file)
+static void JSN_NotifySubscribers(void* userdata, const JSN_Change* changes, size_t count)
 {
-	return JSN_ReadChunkFromIO(SDL_IOFromFile(file, "rt"), true);
+	JSN_Reloader* reloader = (JSN_Reloader*)userdata;
+	JSN_Change* relevant = (JSN_Change*)SDL_malloc(count * sizeof(JSN_Change));
+
+	if (relevant == NULL)
+	{ return; }
+
+	for (size_t i = 0; i < reloader->subscriber_count; ++i)
+	{
+		const JSN_ReloadSubscriber* subscriber = &reloader->subscribers[i];
+		size_t relevant_count = 0;
+
+		for (size_t j = 0; j < count; ++j)
+		{
+			if (JSN_PathsOverlap(subscriber->path, changes[j].path))
+			{ relevant[relevant_count++] = changes[j]; }
+		}
+
+		if (relevant_count)
+		{ subscriber->callback(subscriber->userdata, relevant, relevant_count); }
+	}
+
+	SDL_free(relevant);
 }
 
 
-JSN_Chunk* JSN_ReadChunkFromMem(const void* mem, size_t length)
+bool JSN_Reload(JSN_Reloader* reloader, bool force)
 {
-	return JSN_ReadChunkFromIO(SDL_IOFromConstMem(mem, length), true);
-}
\ No newline at end of file
+	SDL_PathInfo info;
+
+	if (!SDL_GetPathInfo(reloader->file, &info))
+	{ return false; }
+
+	if (!force && info.modify_time == reloader->modify_time)
+	{ return true; }
+
+	JSN_Chunk* update = JSN_ReadChunkFromFile(reloader->file);
+
+	if (update == NULL)
+	{ return false; }
+
+	bool success = JSN_ChunkPatch(reloader->chunk, JSN_GetChunkRoot(reloader->chunk), JSN_GetChunkRoot(update), JSN_NotifySubscribers, reloader);
+
+	if (success)
+	{ reloader->modify_time = info.modify_time; }
+
+	JSN_DestroyChunk(update);
+	return success;
+}
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <cstddef>
 
+#include <SDL3/SDL_atomic.h>
 #include <SDL3/SDL_iostream.h>
 
 
@@ -31,60 +32,91 @@ enum JSN_Type
 
 struct JSN_Array;
 struct JSN_Object;
+struct JSN_Lazy;
+struct JSN_Chunk;
 
 
 struct JSN_Value
 {
 	JSN_Type type;
+	uint32_t string_length;		/**< Length of the string value in bytes, excluding any null terminator. */
 	union
 	{
 		bool			bool_value;
 		int64_t			integer_value;
 		double			number_value;
-		const char*		string_value;
+		const char*		string_value;	/**< Null-terminated within chunks, but only a view of string_length bytes when passed to a JSN_ReaderInterface. */
 		JSN_Array*		array_value;
 		JSN_Object*		object_value;
 	};
 };
 
 
-struct JSN_Element
-{
-	JSN_Value value;
-	size_t index;
-	JSN_Array* parent;
-	JSN_Element* next;
-};
-
-
+/**
+ * @brief A key/value pair of an object value.
+ */
 struct JSN_Property
 {
 	JSN_Value value;
 	const char* key;
-	size_t index;
-	JSN_Object* parent;
-	JSN_Property* next;
+	size_t key_length;
 };
 
 
+/**
+ * @brief Contiguous storage of the elements of an array value.
+ */
 struct JSN_Array
 {
-	JSN_Element* first;
-	JSN_Element* last;
+	JSN_Value* values;
 	size_t count;
+	size_t capacity;
+	JSN_Chunk* chunk;		/**< Chunk this array belongs to. */
+	JSN_Lazy* lazy;			/**< Source of the elements of a lazy or shared array until they're built, NULL afterwards. */
+	SDL_AtomicInt shares;	/**< Containers of other chunks still to be built from this array, which is left unmodified until then. */
+	bool detached;			/**< Whether the array was replaced in its chunk by a copy, having been modified while shared. */
 };
 
 
+/**
+ * @brief Contiguous storage of the properties of an object value.
+ * 
+ * @note Objects with more than JSN_OBJECT_INDEX_THRESHOLD properties are also given a hash index of their keys.
+ */
 struct JSN_Object
 {
-	JSN_Property* first;
-	JSN_Property* last;
+	JSN_Property* properties;
 	size_t count;
+	size_t capacity;
+	uint32_t* index;		/**< Open-addressed table of property indices plus one, zero for empty slots. May be NULL. */
+	size_t index_capacity;	/**< Size of the index table, always a power of two. */
+	JSN_Chunk* chunk;		/**< Chunk this object belongs to. */
+	JSN_Lazy* lazy;			/**< Source of the properties of a lazy or shared object until they're built, NULL afterwards. */
+	SDL_AtomicInt shares;	/**< Containers of other chunks still to be built from this object, which is left unmodified until then. */
+	bool detached;			/**< Whether the object was replaced in its chunk by a copy, having been modified while shared. */
 };
 
 
+/**
+ * @brief Number of properties past which objects maintain a hash index of their keys.
+ */
+#define JSN_OBJECT_INDEX_THRESHOLD 8
+
+/**
+ * @brief Maximum number of nested arrays & objects, past which JSON data is rejected when read or written.
+ */
+#define JSN_MAX_DEPTH 1024
+
+/**
+ * @brief Position passed to JSN_ChunkAddElement() & JSN_ChunkAddProperty() to insert at the end.
+ */
+#define JSN_APPEND SIZE_MAX
+
+
 /**
  * @brief Opaque handle to a JSON chunk.
+ * 
+ * @note All values, keys & strings of a chunk are allocated from arenas owned by the chunk.
  */
 typedef struct JSN_Chunk JSN_Chunk;
 
@@ -97,12 +129,26 @@ typedef struct JSN_Chunk JSN_Chunk;
 JSN_Chunk* JSN_CreateChunk();
 
 /**
- * @brief Destroy a JSON chunk.
+ * @brief Destroy a JSON chunk, releasing all of its arenas at once.
+ * 
+ * @note Arenas holding values shared with copies in other chunks are only released once those chunks are destroyed too.
  * 
  * @param chunk The JSON chunk to destroy.
  */
 void JSN_DestroyChunk(JSN_Chunk* chunk);
 
+/**
+ * @brief Reclaim the memory left unused by overwritten values of a JSON chunk.
+ * 
+ * @note This invalidates every pointer into the chunk other than its root value.
+ *  Values shared from other chunks are copied, after which the chunk no longer depends on them,
+ *  while arenas holding values that other chunks still share are kept until the chunk is destroyed.
+ * 
+ * @param chunk The JSON chunk to compact.
+ * @returns true on success or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_ChunkCompact(JSN_Chunk* chunk);
+
 
 /**
  * @brief Copy a given JSON value into another one.
@@ -114,6 +160,24 @@ void JSN_DestroyChunk(JSN_Chunk* chunk);
  */
 bool JSN_ChunkCopy(JSN_Chunk* chunk, JSN_Value* dest, const JSN_Value* src);
 
+/**
+ * @brief Copy a given JSON value into another one, sharing the children of arrays & objects with the source.
+ * 
+ * @note Arrays & objects are copied in constant time, the source being left untouched.
+ *  Each container of the copy only copies the children of its source when it's first accessed, a level at a time,
+ *  while the containers it still shares are left unmodified: modifying a value of either chunk first replaces
+ *  the shared containers leading to it by copies, which invalidates pointers to their children.
+ *  The chunk of the source is kept alive for as long as the copy shares any of its values.
+ *  Values are copied as JSN_ChunkCopy() would when the source belongs to the same chunk,
+ *  or when values of this chunk are themselves shared by other chunks.
+ * 
+ * @param chunk The JSON chunk from which the destination value originates.
+ * @param dest The JSON value to be overwritten by another.
+ * @param src The JSON value to overwrite the destination with.
+ * @returns true on success or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_ChunkShare(JSN_Chunk* chunk, JSN_Value* dest, const JSN_Value* src);
+
 
 /**
  * @brief Get the root JSON value of the given JSON chunk.
@@ -189,26 +253,67 @@ void JSN_ChunkSetObject(JSN_Chunk* chunk, JSN_Value* value);
 /**
  * @brief Add an element to the given array value.
  * 
+ * @note Adding an element may move the array's existing elements, invalidating pointers to them.
+ * 
  * @param chunk The JSON chunk from which the array value originates.
  * @param array_value The array value to which an element will be added.
- * @param whence Existing element before which the element will be inserted. May be NULL, in which case the element will be inserted at the end.
+ * @param whence Index of the existing element before which the element will be inserted. May be JSN_APPEND, in which case the element will be inserted at the end.
  * @param index A pointer filled with the index of the newly created element, may be NULL.
  * @returns a pointer to the newly created element's JSON value.
  */
-JSN_Value* JSN_ChunkAddElement(JSN_Chunk* chunk, JSN_Value* array_value, JSN_Element* whence, size_t* index);
+JSN_Value* JSN_ChunkAddElement(JSN_Chunk* chunk, JSN_Value* array_value, size_t whence, size_t* index);
 
 /**
  * @brief Add a property to the given object value.
  * 
+ * @note Adding a property may move the object's existing properties, invalidating pointers to them.
+ * 
  * @param chunk The JSON chunk from which the object value originates.
  * @param object_value The object value to which a property will be added.
- * @param whence Existing property before which the property will be inserted. May be NULL, in which case the property will be inserted at the end.
+ * @param whence Index of the existing property before which the property will be inserted. May be JSN_APPEND, in which case the property will be inserted at the end.
  * @param index A pointer filled with the index of the newly created property, may be NULL.
  * @param key The newly created property's key string. A copy of this string is made & stored by this function.
  * @param length The length of the newly created property's key.
  * @returns a pointer to the newly created property's JSON value.
  */
-JSN_Value* JSN_ChunkAddProperty(JSN_Chunk* chunk, JSN_Value* object_value, JSN_Property* whence, size_t* index, const char* key, size_t length);
+JSN_Value* JSN_ChunkAddProperty(JSN_Chunk* chunk, JSN_Value* object_value, size_t whence, size_t* index, const char* key, size_t length);
+
+
+/**
+ * @brief Read the elements or properties of a container of a lazy chunk, if they haven't been read yet.
+ * 
+ * @note Containers of lazy chunks or shared by JSN_ChunkShare() must be read before their storage is accessed directly,
+ *  which JSN_ArrayGet(), JSN_ObjectGet() & every other function of this API do on their own.
+ * 
+ * @param value The value to read, which may be of any type.
+ * @param recursive true to also read every container nested within the value, false to read only its own children.
+ * @returns true on success or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_LoadValue(const JSN_Value* value, bool recursive);
+
+/**
+ * @brief Get an element of the given array value by index.
+ * 
+ * @note Arrays of lazy chunks are read on first access, NULL also being returned if that fails.
+ * 
+ * @param array_value The array value whose element to get.
+ * @param index The index of the element to get.
+ * @returns a pointer to the element's JSON value, or NULL if the value isn't an array or the index is out of bounds.
+ */
+JSN_Value* JSN_ArrayGet(const JSN_Value* array_value, size_t index);
+
+/**
+ * @brief Get a property of the given object value by key.
+ * 
+ * @note If an object has several properties with the same key, the first one is returned.
+ *  Objects of lazy chunks are read on first access, NULL also being returned if that fails.
+ * 
+ * @param object_value The object value whose property to get.
+ * @param key The key of the property to get.
+ * @param length The length of the key.
+ * @returns a pointer to the property's JSON value, or NULL if the value isn't an object or has no such property.
+ */
+JSN_Value* JSN_ObjectGet(const JSN_Value* object_value, const char* key, size_t length);
 
 
 /* ==================================================
@@ -252,6 +357,300 @@ struct JSN_ReaderInterface
  */
 bool JSN_Read(SDL_IOStream* stream, const JSN_ReaderInterface* iface, void* userdata, bool closeio);
 
+/**
+ * @brief Read JSON data directly from a memory buffer using the given reader interface.
+ * 
+ * @note Streams created with SDL_IOFromMem() or SDL_IOFromConstMem() are also read in place by JSN_Read().
+ * 
+ * @param mem A pointer to a buffer containing JSON data.
+ * @param length The length of the buffer in bytes.
+ * @param iface Pointer to an implementation of the JSN_ReaderInterface interface.
+ * @param userdata Opaque pointer passed to interface functions for state management.
+ * @returns true on success or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_ReadMem(const void* mem, size_t length, const JSN_ReaderInterface* iface, void* userdata);
+
+
+/**
+ * @brief Opaque handle to an incremental JSON parser.
+ * 
+ * @note Parsers keep their state across arbitrary boundaries in the input, including within tokens.
+ *  Their memory is bounded by the nesting depth & the longest token rather than by the length of the input.
+ */
+typedef struct JSN_Parser JSN_Parser;
+
+/**
+ * @brief Create an incremental JSON parser, which reads JSON data as it is fed using the given reader interface.
+ * 
+ * @param iface Pointer to an implementation of the JSN_ReaderInterface interface.
+ * @param userdata Opaque pointer passed to interface functions for state management.
+ * @returns a newly created JSON parser, or NULL on failure; call SDL_GetError() for more information.
+ */
+JSN_Parser* JSN_CreateParser(const JSN_ReaderInterface* iface, void* userdata);
+
+/**
+ * @brief Destroy an incremental JSON parser.
+ * 
+ * @param parser The JSON parser to destroy.
+ */
+void JSN_DestroyParser(JSN_Parser* parser);
+
+/**
+ * @brief Feed the next bytes of JSON data to an incremental parser.
+ * 
+ * @note Events are emitted for every token completed by these bytes. The bytes don't need to outlive the call.
+ * 
+ * @param parser The JSON parser to feed.
+ * @param data A pointer to the next bytes of JSON data.
+ * @param length The number of bytes to feed.
+ * @returns true on success or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_Feed(JSN_Parser* parser, const void* data, size_t length);
+
+/**
+ * @brief Signal the end of the JSON data fed to an incremental parser.
+ * 
+ * @param parser The JSON parser to finish.
+ * @returns true if all of the JSON data fed was well-formed, or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_Finish(JSN_Parser* parser);
+
+/**
+ * @brief Read complete JSON data from memory with a parser, as JSN_ReadMem() would, then finish it.
+ * 
+ * @note Unlike JSN_ReadMem(), everything allocated while reading belongs to the parser,
+ *  so that it's still freed by JSN_DestroyParser() if an interface function never returns, e.g. by raising a Lua error.
+ * 
+ * @param parser A JSON parser which hasn't been fed yet.
+ * @param mem A pointer to a buffer containing JSON data.
+ * @param length The length of the buffer in bytes.
+ * @returns true if the JSON data was well-formed, or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_ParseMem(JSN_Parser* parser, const void* mem, size_t length);
+
+
+/* ==================================================
+	JSON WRITER API
+================================================== */
+
+/**
+ * @brief Opaque handle to a JSON writer.
+ * 
+ * @note Writers accumulate their output in a large buffer, which is only written to their stream once full or flushed.
+ */
+typedef struct JSN_Writer JSN_Writer;
+
+/**
+ * @brief Create a JSON writer outputting to a stream.
+ * 
+ * @param stream An SDL_IOStream to which JSON data will be written.
+ * @param pretty true to indent the output with tabs & break it into lines, false to write it compactly.
+ * @param closeio true to close/free the SDL_IOStream once the writer is closed, false to leave it open.
+ * @returns a newly created JSON writer, or NULL on failure; call SDL_GetError() for more information.
+ */
+JSN_Writer* JSN_CreateWriter(SDL_IOStream* stream, bool pretty, bool closeio);
+
+/**
+ * @brief Flush & destroy a JSON writer, checking that a complete JSON value was written.
+ * 
+ * @param writer The JSON writer to close.
+ * @returns true on success or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_CloseWriter(JSN_Writer* writer);
+
+/**
+ * @brief Write the buffered output of a JSON writer to its stream.
+ * 
+ * @param writer The JSON writer to flush.
+ * @returns true on success or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_FlushWriter(JSN_Writer* writer);
+
+/**
+ * @brief Write the key of the next property of the innermost open object.
+ * 
+ * @param writer The JSON writer to write to.
+ * @param key The key to write, which doesn't need to be null-terminated.
+ * @param length The length of the key in bytes.
+ * @returns true on success or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_WriteKey(JSN_Writer* writer, const char* key, size_t length);
+
+/**
+ * @brief Write a JSON value, along with all of its elements or properties.
+ * 
+ * @note Strings are written up to their string_length, so they don't need to be null-terminated.
+ * 
+ * @param writer The JSON writer to write to.
+ * @param value The JSON value to write.
+ * @returns true on success or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_WriteValue(JSN_Writer* writer, const JSN_Value* value);
+
+/**
+ * @brief Open an array, to which the following values are added until it is closed.
+ */
+bool JSN_WriteOpenArray(JSN_Writer* writer);
+
+/**
+ * @brief Close the innermost open array.
+ */
+bool JSN_WriteCloseArray(JSN_Writer* writer);
+
+/**
+ * @brief Open an object, to which the following key/value pairs are added until it is closed.
+ */
+bool JSN_WriteOpenObject(JSN_Writer* writer);
+
+/**
+ * @brief Close the innermost open object.
+ */
+bool JSN_WriteCloseObject(JSN_Writer* writer);
+
+/**
+ * @brief Get a reader interface that writes every event it receives, its userdata being a JSN_Writer.
+ * 
+ * @note This allows JSON data to be reformatted as it is read, e.g. by passing it to JSN_Read().
+ */
+const JSN_ReaderInterface* JSN_GetWriterInterface();
+
+/**
+ * @brief Write a JSON value to a stream.
+ * 
+ * @note Numbers are written in the shortest form which reads back as the exact same double.
+ * 
+ * @param stream An SDL_IOStream to which JSON data will be written.
+ * @param value The JSON value to write, empty values writing nothing.
+ * @param pretty true to indent the output with tabs & break it into lines, false to write it compactly.
+ * @param closeio true to close/free the SDL_IOStream before returning, false to leave it open.
+ * @returns true on success or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_Write(SDL_IOStream* stream, const JSN_Value* value, bool pretty, bool closeio);
+
+
+/* ==================================================
+	JSON BINARY IMAGE API
+================================================== */
+
+/**
+ * @brief Save a binary image of a JSON chunk, which can later be loaded without parsing.
+ * 
+ * @note Images store pointers as offsets, and are only compatible with platforms of the same pointer size & byte order.
+ * 
+ * @param chunk The JSON chunk to save.
+ * @param stream An SDL_IOStream to which the image will be written.
+ * @param closeio true to close/free the SDL_IOStream before returning, false to leave it open.
+ * @returns true on success or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_SaveBinary(JSN_Chunk* chunk, SDL_IOStream* stream, bool closeio);
+
+/**
+ * @brief Load a JSON chunk from a binary image saved by JSN_SaveBinary().
+ * 
+ * @note The image is read into the chunk at once, after which its offsets are checked & turned back into pointers.
+ *  No node of the chunk is allocated on its own.
+ * 
+ * @param stream An SDL_IOStream from which the image will be read.
+ * @param closeio true to close/free the SDL_IOStream before returning, false to leave it open.
+ * @returns a newly created JSON chunk, or NULL on failure; call SDL_GetError() for more information.
+ */
+JSN_Chunk* JSN_LoadBinary(SDL_IOStream* stream, bool closeio);
+
+/**
+ * @brief Configure the binary images cached by JSN_ReadChunkFromFile().
+ * 
+ * @note This isn't thread-safe, and should be called before loading any file.
+ *  Images are always looked up, but only saved once enabled here, so that reading files never writes beside them by default.
+ * 
+ * @param save Whether binary images should be saved after parsing a file, which they aren't by default.
+ * @param directory The directory in which to cache binary images, e.g. the pref path, or NULL to cache them next to their JSON files.
+ */
+void JSN_SetBinaryCache(bool save, const char* directory);
+
+
+/* ==================================================
+	JSON QUERY API
+================================================== */
+
+/**
+ * @brief A path compiled into a reusable matcher of the values it leads to.
+ */
+struct JSN_Query;
+
+/**
+ * @brief Reader interface passing on the values matched by a query to another reader interface.
+ */
+struct JSN_QueryFilter;
+
+
+/**
+ * @brief Callback invoked for each value matched by a query.
+ * 
+ * @returns true to keep looking for matches, false to stop.
+ */
+typedef bool (*JSN_QueryCallback)(void* userdata, JSN_Value* value);
+
+
+/**
+ * @brief Compile a path into a query.
+ * 
+ * @note Paths are either JSON Pointers, such as "/monsters/0/stats/hp", or dotted keys & bracketed indices,
+ *  such as "monsters[*].stats.hp". In both forms, a "*" segment matches every property or element of a value,
+ *  and numeric segments match array elements as well as object properties. An empty path matches the root.
+ * 
+ * @param path The path to compile, which isn't referenced by the query.
+ * @returns a newly created query, or NULL on failure; call SDL_GetError() for more information.
+ */
+JSN_Query* JSN_CompileQuery(const char* path);
+
+/**
+ * @brief Destroy a query.
+ */
+void JSN_DestroyQuery(JSN_Query* query);
+
+/**
+ * @brief Find the values matched by a query within a JSON value, in document order.
+ * 
+ * @note Objects with duplicate keys only have their first matching property looked into, unless matched by a wildcard.
+ * 
+ * @param query The query to run.
+ * @param value The JSON value to run the query against, such as the root of a chunk.
+ * @param callback A function to call for each match, or NULL to only count them.
+ * @param userdata Opaque pointer passed to the callback.
+ * @returns the number of values matched, including the one on which the callback stopped.
+ */
+size_t JSN_QueryValue(const JSN_Query* query, JSN_Value* value, JSN_QueryCallback callback, void* userdata);
+
+/**
+ * @brief Find the first value matched by a query within a JSON value.
+ * 
+ * @returns the first match, or NULL if there's none.
+ */
+JSN_Value* JSN_QueryFirst(const JSN_Query* query, JSN_Value* value);
+
+/**
+ * @brief Create a filter passing on the values matched by a query to another reader interface.
+ * 
+ * @note Each match is passed on as a separate root value, in document order. Subtrees which can't contain
+ *  a match are skipped without being passed on, so that they're never built. Filters can only be used once.
+ * 
+ * @param query The query to run, which must outlive the filter.
+ * @param iface Pointer to the reader interface to which matches are passed on.
+ * @param userdata Opaque pointer passed to the functions of that interface.
+ * @returns a newly created filter, to be used as the userdata of JSN_GetQueryFilterInterface(), or NULL on failure.
+ */
+JSN_QueryFilter* JSN_CreateQueryFilter(const JSN_Query* query, const JSN_ReaderInterface* iface, void* userdata);
+
+/**
+ * @brief Destroy a query filter.
+ */
+void JSN_DestroyQueryFilter(JSN_QueryFilter* filter);
+
+/**
+ * @brief Get the reader interface of query filters, its userdata being a JSN_QueryFilter.
+ */
+const JSN_ReaderInterface* JSN_GetQueryFilterInterface();
+
 
 /* ==================================================
 	JSON UTILITY API
@@ -259,9 +658,205 @@ bool JSN_Read(SDL_IOStream* stream, const JSN_ReaderInterface* iface, void* user
 
 JSN_Chunk* JSN_ReadChunkFromIO(SDL_IOStream* stream, bool closeio);
 
+/**
+ * @brief Read a JSON chunk from a file.
+ * 
+ * @note If a binary image of the chunk was cached along with a hash of the file, as enabled with JSN_SetBinaryCache(),
+ *  the file is loaded from its image for as long as its contents remain the same.
+ * 
+ * @param file The path of the JSON file to read.
+ * @returns a newly created JSON chunk, or NULL on failure; call SDL_GetError() for more information.
+ */
 JSN_Chunk* JSN_ReadChunkFromFile(const char* file);
 
+/**
+ * @brief Read a lazy JSON chunk from a seekable stream, whose nested arrays & objects are only read on first access.
+ * 
+ * @note The whole stream is checked to be valid JSON, but only the values of the root are built.
+ *  Nested containers keep the range of the stream they span, which is read back & built a level at a time
+ *  when they're first accessed, so that the chunk only grows with the parts of the data actually used.
+ *  The stream must be left untouched until the chunk is destroyed, and accessing the chunk isn't thread-safe.
+ * 
+ * @param stream A seekable SDL_IOStream from which JSON data will be read from.
+ * @param closeio true for the chunk to close/free the SDL_IOStream when destroyed, or right away on failure,
+ *  false to leave it open.
+ * @returns a newly created JSON chunk, or NULL on failure; call SDL_GetError() for more information.
+ */
+JSN_Chunk* JSN_ReadLazyChunkFromIO(SDL_IOStream* stream, bool closeio);
+
+/**
+ * @brief Read a lazy JSON chunk from a file, which is kept open until the chunk is destroyed.
+ * 
+ * @note Binary images are neither loaded nor cached for lazy chunks.
+ * 
+ * @see JSN_ReadLazyChunkFromIO()
+ * 
+ * @param file The path of the JSON file to read.
+ * @returns a newly created JSON chunk, or NULL on failure; call SDL_GetError() for more information.
+ */
+JSN_Chunk* JSN_ReadLazyChunkFromFile(const char* file);
+
+/**
+ * @brief Read JSON chunks from many files at once, spreading them across a thread per core.
+ * 
+ * @note Files are read as if by JSN_ReadChunkFromFile(), and their results are stored in the same order as their paths,
+ *  whichever thread read them. Files which can't be read get a NULL chunk, while the others are still read.
+ * 
+ * @param files The paths of the JSON files to read.
+ * @param count The number of files to read.
+ * @param chunks An array of count chunks, filled with newly created chunks or NULL for files which couldn't be read.
+ * @param errors An optional array of count strings, filled with the error of each file which couldn't be read,
+ *  to be freed with SDL_free(), or NULL for the others.
+ * @returns true if every file was read or false otherwise; call SDL_GetError() for more information.
+ */
+bool JSN_ReadChunksFromFiles(const char* const* files, size_t count, JSN_Chunk** chunks, char** errors);
+
+/**
+ * @brief Read a JSON chunk from a memory buffer.
+ * 
+ * @note The buffer is copied into the chunk once, after which strings & keys are decoded in place & referenced by the chunk.
+ * 
+ * @param mem A pointer to a buffer containing JSON data.
+ * @param length The length of the buffer in bytes.
+ * @returns a newly created JSON chunk, or NULL on failure; call SDL_GetError() for more information.
+ */
 JSN_Chunk* JSN_ReadChunkFromMem(const void* mem, size_t length);
 
+/**
+ * @brief Read a JSON chunk from a mutable memory buffer without copying it.
+ * 
+ * @note Strings & keys are decoded in place within the buffer & referenced by the chunk, so the buffer must outlive the chunk.
+ * 
+ * @param mem A pointer to a buffer containing JSON data, which is overwritten while reading.
+ * @param length The length of the buffer in bytes.
+ * @returns a newly created JSON chunk, or NULL on failure; call SDL_GetError() for more information.
+ */
+JSN_Chunk* JSN_ReadChunkInSitu(void* mem, size_t length);
+
+/**
+ * @brief Write a JSON chunk to a file.
+ * 
+ * @param chunk The JSON chunk to write.
+ * @param file The path of the file to write to, which is overwritten.
+ * @param pretty true to indent the output with tabs & break it into lines, false to write it compactly.
+ * @returns true on success or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_WriteChunkToFile(JSN_Chunk* chunk, const char* file, bool pretty);
+
+/**
+ * @brief Read the values matched by a query from a stream into a JSON chunk.
+ * 
+ * @note Only matches are built, as the elements of the root array of the chunk.
+ * 
+ * @param stream An SDL_IOStream from which JSON data will be read from.
+ * @param query The query to run.
+ * @param closeio true to close/free the SDL_IOStream before returning, false to leave it open.
+ * @returns a newly created JSON chunk, or NULL on failure; call SDL_GetError() for more information.
+ */
+JSN_Chunk* JSN_ReadQueryFromIO(SDL_IOStream* stream, const JSN_Query* query, bool closeio);
+
+
+/* ==================================================
+	JSON HOT RELOAD API
+================================================== */
+
+/**
+ * @brief Keeps a JSON chunk in sync with the file it was read from, patching it in place whenever the file changes.
+ */
+struct JSN_Reloader;
+
+
+enum JSN_ChangeType
+{
+	JSN_CHANGE_ADDED,		/**< Value was added to an array or object. */
+	JSN_CHANGE_REMOVED,		/**< Value was removed from an array or object. */
+	JSN_CHANGE_MODIFIED,	/**< Value was replaced by another one, of the same type or not. */
+};
+
+
+struct JSN_Change
+{
+	JSN_ChangeType type;
+	const char* path;		/**< JSON Pointer to the changed value, such as "/monsters/2/stats/hp". */
+	JSN_Value old_value;	/**< Value before the change, of type JSN_TYPE_EMPTY for added values. */
+	JSN_Value* value;		/**< Value after the change, NULL for removed values. */
+};
+
+
+/**
+ * @brief Callback invoked with the changes made to a JSON value.
+ * 
+ * @note Changes & their paths are only valid during the call.
+ */
+typedef void (*JSN_ChangeCallback)(void* userdata, const JSN_Change* changes, size_t count);
+
+
+/**
+ * @brief Patch a value of a JSON chunk in place so that it matches another, leaving the parts that didn't change untouched.
+ * 
+ * @note Subtrees are compared by hash, and only the values which differ are added, removed or replaced.
+ *  Properties are matched by key, whatever their order, while elements inserted into or removed from an array
+ *  are told apart from the ones shifted by them. Indices of removed elements are those they had before the patch.
+ *  Pointers to unchanged values remain valid, except for elements & properties of containers which gained or lost some,
+ *  or which were modified while shared with another chunk by JSN_ChunkShare().
+ *  Replaced values are left in the chunk's arena until it is compacted, so that old values remain readable.
+ * 
+ * @param chunk The JSON chunk from which the patched value originates.
+ * @param value The JSON value to patch, such as the root of a chunk.
+ * @param target The JSON value to match, which is copied into the chunk where needed.
+ * @param callback A function called once with every change made if there's any, or NULL.
+ * @param userdata Opaque pointer passed to the callback.
+ * @returns true on success or false on failure, the value being left untouched; call SDL_GetError() for more information.
+ */
+bool JSN_ChunkPatch(JSN_Chunk* chunk, JSN_Value* value, const JSN_Value* target, JSN_ChangeCallback callback, void* userdata);
+
+/**
+ * @brief Read a JSON file into a chunk to be kept in sync with it by JSN_Reload().
+ * 
+ * @param file The path of the JSON file to read.
+ * @returns a newly created reloader, or NULL on failure; call SDL_GetError() for more information.
+ */
+JSN_Reloader* JSN_CreateReloader(const char* file);
+
+/**
+ * @brief Destroy a reloader along with its chunk.
+ */
+void JSN_DestroyReloader(JSN_Reloader* reloader);
+
+/**
+ * @brief Get the chunk kept in sync by a reloader, which remains the same across reloads.
+ */
+JSN_Chunk* JSN_GetReloaderChunk(JSN_Reloader* reloader);
+
+/**
+ * @brief Subscribe to the changes made by a reloader to a value of its chunk.
+ * 
+ * @note Subscribers are notified of changes to the value, to its descendants, and to its ancestors,
+ *  in the order they subscribed in. They mustn't subscribe nor unsubscribe from within their callback.
+ * 
+ * @param reloader The reloader to subscribe to.
+ * @param path JSON Pointer to the value to watch, such as "/monsters", or "" to watch the whole chunk.
+ * @param callback The function to call with the changes made by each reload.
+ * @param userdata Opaque pointer passed to the callback.
+ * @returns true on success or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_SubscribeReloader(JSN_Reloader* reloader, const char* path, JSN_ChangeCallback callback, void* userdata);
+
+/**
+ * @brief Remove the subscriptions made with the given callback & userdata.
+ */
+void JSN_UnsubscribeReloader(JSN_Reloader* reloader, JSN_ChangeCallback callback, void* userdata);
+
+/**
+ * @brief Read the file of a reloader again if it was modified since, patching its chunk & notifying subscribers.
+ * 
+ * @note The chunk is left untouched if the file can't be read, such as while it's being saved, so that it can be tried again later.
+ * 
+ * @param reloader The reloader to update.
+ * @param force true to read the file even if it wasn't modified.
+ * @returns true if the chunk is up to date or false on failure; call SDL_GetError() for more information.
+ */
+bool JSN_Reload(JSN_Reloader* reloader, bool force);
+
 
 #endif // GAME_JSON_HEADER
\ No newline at end of file
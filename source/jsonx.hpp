@@ -0,0 +1,517 @@
+#ifndef GAME_JSONX_HEADER
+#define GAME_JSONX_HEADER
+
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "json.hpp"
+#include "perfecthash.hpp"
+
+
+/* ==================================================
+	Typed JSON reading, straight into C++ objects without building a chunk.
+
+	Structs list their fields with a static constexpr json_fields() member function:
+
+		struct Monster
+		{
+			std::string name;
+			int hp;
+			std::vector<std::string> tags;
+			std::optional<Stats> stats;
+			Element element;
+
+			static constexpr auto json_fields()
+			{
+				return Game::JsonFields(
+					Game::JsonField<&Monster::name>("name"),
+					Game::JsonField<&Monster::hp>("hp"),
+					Game::JsonField<&Monster::tags>("tags"),
+					Game::JsonField<&Monster::stats>("stats"),
+					Game::JsonField<&Monster::element>("element"));
+			}
+		};
+
+	Enums are read from strings listed by a json_values() function found by ADL:
+
+		constexpr auto json_values(Element)
+		{ return Game::JsonValues(std::pair{ "fire", Element::Fire }, std::pair{ "ice", Element::Ice }); }
+
+	Fields missing from the input are left untouched, and properties without a field are skipped.
+================================================== */
+
+namespace Game
+{
+	inline namespace Detail
+	{
+		/**
+		 * @brief Functions reading JSON values of a given type into a type-erased target.
+		 */
+		struct JsonSink
+		{
+			const char* expected;	/**< What the sink expects, for error messages. */
+
+			/** @brief Read a scalar into the target. */
+			bool (*value)(void* target, const JSN_Value* value);
+
+			/** @brief Prepare the target for the children of a container, possibly redirecting to another target & sink. */
+			bool (*open)(void** target, const JsonSink** sink, bool array);
+
+			/** @brief Get the target & sink of a property of an object, a NULL sink skipping it. */
+			void (*key)(void* object, const char* key, size_t length, void** child, const JsonSink** sink);
+
+			/** @brief Get the target & sink of the next element of an array. */
+			void (*element)(void* array, void** child, const JsonSink** sink);
+		};
+
+
+		template<typename T>
+		struct JsonSinkOf;
+
+
+		template<typename C, typename T>
+		C JsonClassOf(T C::*);
+
+		template<typename C, typename T>
+		T JsonTypeOf(T C::*);
+
+		template<auto M>
+		using JsonMemberType = decltype(JsonTypeOf(M));
+
+		template<auto M>
+		void* JsonMemberOf(void* object)
+		{ return &(((decltype(JsonClassOf(M))*)object)->*M); }
+
+
+		template<typename T>
+		concept JsonStruct = requires { T::json_fields(); };
+
+		template<typename T>
+		concept JsonEnum = std::is_enum_v<T> && requires(T value) { json_values(value); };
+	}
+
+
+	/**
+	 * @brief A field of a struct read from the JSON property of the same name.
+	 *
+	 * @tparam M Pointer to the member holding the field.
+	 */
+	template<auto M>
+	struct JsonField
+	{
+		std::string_view name;
+
+		constexpr JsonField(std::string_view name) : name(name)
+		{}
+	};
+
+
+	/**
+	 * @brief Table of the fields of a struct, returned by its json_fields() member function.
+	 */
+	template<size_t N>
+	struct JsonFieldTable
+	{
+		struct Entry
+		{
+			void* (*member)(void* object);
+			const JsonSink* sink;
+		};
+
+		PerfectHash<N> names;
+		std::array<Entry, N> entries;
+	};
+
+
+	template<auto... M>
+	constexpr auto JsonFields(JsonField<M>... fields)
+	{
+		return JsonFieldTable<sizeof...(M)>
+		{
+			PerfectHash<sizeof...(M)>({ fields.name... }),
+			{ typename JsonFieldTable<sizeof...(M)>::Entry{ Detail::JsonMemberOf<M>, &JsonSinkOf<Detail::JsonMemberType<M>>::sink }... },
+		};
+	}
+
+
+	/**
+	 * @brief Table of the values of an enum and their names, returned by its json_values() function.
+	 */
+	template<typename E, size_t N>
+	struct JsonValueTable
+	{
+		PerfectHash<N> names;
+		std::array<E, N> values;
+	};
+
+
+	template<typename E, typename... P>
+	constexpr auto JsonValues(std::pair<const char*, E> first, P... rest)
+	{
+		constexpr size_t N = sizeof...(P) + 1;
+		return JsonValueTable<E, N>
+		{
+			PerfectHash<N>({ std::string_view(first.first), std::string_view(rest.first)... }),
+			{ first.second, rest.second... },
+		};
+	}
+
+
+	inline namespace Detail
+	{
+		inline bool JsonMismatch(const char* expected, const char* found)
+		{ return SDL_SetError("expected %s but found %s while reading JSON stream", expected, found); }
+
+		inline bool JsonMismatch(const char* expected, const JSN_Value* value)
+		{
+			static const char* const names[] { "nothing", "null", "boolean", "integer", "number", "string", "array", "object" };
+			return JsonMismatch(expected, names[value->type]);
+		}
+
+		inline bool JsonNoContainer(void**, const JsonSink**, bool)
+		{ return false; }
+
+		inline void JsonNoKey(void*, const char*, size_t, void**, const JsonSink** sink)
+		{ *sink = nullptr; }
+
+		inline void JsonNoElement(void*, void**, const JsonSink** sink)
+		{ *sink = nullptr; }
+
+
+		/**
+		 * @brief Sink of booleans, numbers & strings.
+		 */
+		template<typename T>
+		struct JsonScalarSink
+		{
+			static bool Value(void* target, const JSN_Value* value)
+			{
+				auto& result = *(T*)target;
+
+				if constexpr (std::is_same_v<T, bool>)
+				{
+					if (value->type != JSN_TYPE_BOOL)
+					{ return JsonMismatch(Expected(), value); }
+
+					result = value->bool_value;
+				}
+				else if constexpr (std::is_integral_v<T>)
+				{
+					if (value->type != JSN_TYPE_INTEGER || !std::in_range<T>(value->integer_value))
+					{ return JsonMismatch(Expected(), value); }
+
+					result = (T)value->integer_value;
+				}
+				else if constexpr (std::is_floating_point_v<T>)
+				{
+					if (value->type == JSN_TYPE_INTEGER)
+					{ result = (T)value->integer_value; }
+					else if (value->type == JSN_TYPE_NUMBER)
+					{ result = (T)value->number_value; }
+					else
+					{ return JsonMismatch(Expected(), value); }
+				}
+				else
+				{
+					if (value->type != JSN_TYPE_STRING)
+					{ return JsonMismatch(Expected(), value); }
+
+					result.assign(value->string_value, value->string_length);
+				}
+
+				return true;
+			}
+
+			static constexpr const char* Expected()
+			{
+				if constexpr (std::is_same_v<T, bool>)
+				{ return "boolean"; }
+				else if constexpr (std::is_integral_v<T>)
+				{ return "integer"; }
+				else if constexpr (std::is_floating_point_v<T>)
+				{ return "number"; }
+				else
+				{ return "string"; }
+			}
+		};
+	}
+
+
+	template<typename T>
+	requires std::is_arithmetic_v<T> || std::is_same_v<T, std::string>
+	struct JsonSinkOf<T>
+	{
+		static constexpr JsonSink sink { JsonScalarSink<T>::Expected(), JsonScalarSink<T>::Value, JsonNoContainer, JsonNoKey, JsonNoElement };
+	};
+
+
+	template<JsonEnum E>
+	struct JsonSinkOf<E>
+	{
+		static bool Value(void* target, const JSN_Value* value)
+		{
+			static constexpr auto table = json_values(E{});
+
+			if (value->type != JSN_TYPE_STRING)
+			{ return JsonMismatch(sink.expected, value); }
+
+			size_t i = table.names.Find(value->string_value, value->string_length);
+
+			if (i == table.values.size())
+			{ return SDL_SetError("unknown enum value \"%.*s\" encountered while reading JSON stream", (int)value->string_length, value->string_value); }
+
+			*(E*)target = table.values[i];
+			return true;
+		}
+
+		static constexpr JsonSink sink { "enum name", Value, JsonNoContainer, JsonNoKey, JsonNoElement };
+	};
+
+
+	template<JsonStruct T>
+	struct JsonSinkOf<T>
+	{
+		static bool Value(void*, const JSN_Value* value)
+		{ return JsonMismatch(sink.expected, value); }
+
+		static bool Open(void**, const JsonSink**, bool array)
+		{ return !array; }
+
+		static void Key(void* object, const char* key, size_t length, void** child, const JsonSink** sink)
+		{
+			static constexpr auto table = T::json_fields();
+
+			size_t i = table.names.Find(key, length);
+
+			if (i == table.entries.size())
+			{
+				*sink = nullptr;
+				return;
+			}
+
+			*child = table.entries[i].member(object);
+			*sink = table.entries[i].sink;
+		}
+
+		static constexpr JsonSink sink { "object", Value, Open, Key, JsonNoElement };
+	};
+
+
+	template<typename T>
+	struct JsonSinkOf<std::vector<T>>
+	{
+		static bool Value(void*, const JSN_Value* value)
+		{ return JsonMismatch(sink.expected, value); }
+
+		static bool Open(void** target, const JsonSink**, bool array)
+		{
+			if (array)
+			{ ((std::vector<T>*)*target)->clear(); }
+
+			return array;
+		}
+
+		static void Element(void* array, void** child, const JsonSink** sink)
+		{
+			*child = &((std::vector<T>*)array)->emplace_back();
+			*sink = &JsonSinkOf<T>::sink;
+		}
+
+		static constexpr JsonSink sink { "array", Value, Open, JsonNoKey, Element };
+	};
+
+
+	template<typename T>
+	struct JsonSinkOf<std::optional<T>>
+	{
+		static bool Value(void* target, const JSN_Value* value)
+		{
+			auto& optional = *(std::optional<T>*)target;
+
+			if (value->type == JSN_TYPE_NULL)
+			{
+				optional.reset();
+				return true;
+			}
+
+			return JsonSinkOf<T>::sink.value(&optional.emplace(), value);
+		}
+
+		static bool Open(void** target, const JsonSink** sink, bool array)
+		{
+			*target = &((std::optional<T>*)*target)->emplace();
+			*sink = &JsonSinkOf<T>::sink;
+			return (*sink)->open(target, sink, array);
+		}
+
+		static constexpr JsonSink sink { JsonSinkOf<T>::sink.expected, Value, Open, JsonNoKey, JsonNoElement };
+	};
+
+
+	inline namespace Detail
+	{
+		/**
+		 * @brief Reader interface implementation that reads into typed targets.
+		 *
+		 * @note Subtrees without a target are skipped by counting their depth, without tracking them.
+		 */
+		struct JsonTypedReader
+		{
+			struct Frame
+			{
+				void* object;
+				const JsonSink* sink;
+				bool array;
+				void* child;			/**< Target of the last key of an object. */
+				const JsonSink* child_sink;
+			};
+
+			size_t depth;
+			size_t skip_depth;
+			Frame frames[JSN_MAX_DEPTH + 1];
+
+			JsonTypedReader(void* root, const JsonSink* sink) : depth(1), skip_depth(0)
+			{ frames[0] = Frame{ nullptr, nullptr, false, root, sink }; }
+
+			void Target(void** target, const JsonSink** sink)
+			{
+				Frame& top = frames[depth - 1];
+
+				if (top.array)
+				{ top.sink->element(top.object, target, sink); }
+				else
+				{ *target = top.child; *sink = top.child_sink; }
+			}
+
+			static bool Key(void* userdata, const char* key, size_t length)
+			{
+				auto& reader = *(JsonTypedReader*)userdata;
+
+				if (reader.skip_depth == 0)
+				{
+					Frame& top = reader.frames[reader.depth - 1];
+					top.sink->key(top.object, key, length, &top.child, &top.child_sink);
+				}
+
+				return true;
+			}
+
+			static bool Value(void* userdata, JSN_Value* value)
+			{
+				auto& reader = *(JsonTypedReader*)userdata;
+
+				if (reader.skip_depth)
+				{ return true; }
+
+				void* target;
+				const JsonSink* sink;
+				reader.Target(&target, &sink);
+
+				return sink == nullptr || sink->value(target, value);
+			}
+
+			static bool Open(void* userdata, bool array)
+			{
+				auto& reader = *(JsonTypedReader*)userdata;
+
+				if (reader.skip_depth)
+				{
+					++reader.skip_depth;
+					return true;
+				}
+
+				void* target;
+				const JsonSink* sink;
+				reader.Target(&target, &sink);
+
+				if (sink == nullptr)
+				{
+					reader.skip_depth = 1;
+					return true;
+				}
+
+				if (!sink->open(&target, &sink, array))
+				{ return JsonMismatch(sink->expected, array ? "array" : "object"); }
+
+				reader.frames[reader.depth++] = Frame{ target, sink, array, nullptr, nullptr };
+				return true;
+			}
+
+			static bool Close(void* userdata)
+			{
+				auto& reader = *(JsonTypedReader*)userdata;
+
+				if (reader.skip_depth)
+				{ --reader.skip_depth; }
+				else
+				{ --reader.depth; }
+
+				return true;
+			}
+
+			static bool OpenArray(void* userdata)
+			{ return Open(userdata, true); }
+
+			static bool CloseArray(void* userdata, size_t)
+			{ return Close(userdata); }
+
+			static bool OpenObject(void* userdata)
+			{ return Open(userdata, false); }
+
+			static bool CloseObject(void* userdata, size_t)
+			{ return Close(userdata); }
+
+			static constexpr JSN_ReaderInterface iface
+			{
+				.version = sizeof(JSN_ReaderInterface),
+				.key = Key,
+				.value = Value,
+				.open_array = OpenArray,
+				.close_array = CloseArray,
+				.open_object = OpenObject,
+				.close_object = CloseObject,
+			};
+		};
+	}
+
+
+	/**
+	 * @brief Read JSON data from a stream into a typed target.
+	 *
+	 * @tparam T A struct with a json_fields() member function, an enum with json_values(), a scalar,
+	 *  std::string, or a std::vector or std::optional of those.
+	 * @param stream An SDL_IOStream from which JSON data will be read from.
+	 * @param target The object to read into, whose fields missing from the input are left untouched.
+	 * @param closeio true to close/free the SDL_IOStream before returning, false to leave it open.
+	 * @returns true on success or false on failure; call SDL_GetError() for more information.
+	 */
+	template<typename T>
+	bool ReadJson(SDL_IOStream* stream, T& target, bool closeio)
+	{
+		JsonTypedReader reader(&target, &JsonSinkOf<T>::sink);
+		return JSN_Read(stream, &JsonTypedReader::iface, &reader, closeio);
+	}
+
+
+	/**
+	 * @brief Read JSON data from a memory buffer into a typed target.
+	 *
+	 * @see ReadJson()
+	 */
+	template<typename T>
+	bool ReadJsonMem(const void* mem, size_t length, T& target)
+	{
+		JsonTypedReader reader(&target, &JsonSinkOf<T>::sink);
+		return JSN_ReadMem(mem, length, &JsonTypedReader::iface, &reader);
+	}
+}
+
+
+#endif // GAME_JSONX_HEADER
@@ -1,6 +1,9 @@
 #include "luax.hpp"
 
 
+#include <SDL3/SDL_stdinc.h>
+
+
 std::string_view lua_tostringview(lua_State* lua, int index)
 {
 	size_t length;
@@ -49,4 +52,216 @@ int lua_pushtraceback(lua_State* lua)
 	lua_pop(lua, 2);
 
 	return lua_gettop(lua);
+}
+
+
+int lua_newtype(lua_State* lua, const lua_Type& type)
+{
+	if (!luaL_newmetatable(lua, type.name))
+	{ return 0; }
+
+	lua_pushvalue(lua, -1);
+	lua_rawsetp(lua, LUA_REGISTRYINDEX, &type);
+	return 1;
+}
+
+
+void lua_settype(lua_State* lua, const lua_Type& type)
+{
+	lua_rawgetp(lua, LUA_REGISTRYINDEX, &type);
+	lua_setmetatable(lua, -2);
+}
+
+
+void* lua_testtype(lua_State* lua, int arg, const lua_Type& type)
+{
+	void* ptr = lua_touserdata(lua, arg);
+
+	if (ptr == nullptr || !lua_getmetatable(lua, arg))
+	{ return nullptr; }
+
+	lua_rawgetp(lua, LUA_REGISTRYINDEX, &type);
+
+	if (!lua_rawequal(lua, -1, -2))
+	{ ptr = nullptr; }
+
+	lua_pop(lua, 2);
+	return ptr;
+}
+
+
+void* lua_checktype(lua_State* lua, int arg, const lua_Type& type)
+{
+	void* ptr = lua_testtype(lua, arg, type);
+
+	if (ptr == nullptr)
+	{ luaL_typeerror(lua, arg, type.name); }
+
+	return ptr;
+}
+
+
+/**
+ * @brief Size of the slabs by which pools grow, in bytes.
+ */
+static constexpr size_t LUA_POOL_SLABSIZE = 64 * 1024;
+
+/**
+ * @brief Size classes & slabs of a thread's pools.
+ */
+struct lua_Pool
+{
+	void* free[LUA_POOL_CLASSES] = {};		/**< Singly-linked list of the freed blocks of each class. */
+	char* cursor[LUA_POOL_CLASSES] = {};	/**< Next block of each class never handed out yet. */
+	char* end[LUA_POOL_CLASSES] = {};		/**< End of the slab each class is carving blocks from. */
+	void* slabs = nullptr;					/**< Singly-linked list of every slab, linked through their first bytes. */
+
+	lua_PoolStats stats = {};
+
+	~lua_Pool()
+	{
+		while (slabs)
+		{
+			auto next = *(void**)slabs;
+			SDL_free(slabs);
+			slabs = next;
+		}
+	}
+};
+
+static thread_local lua_Pool lua_pool;
+
+
+static size_t lua_poolclass(size_t size)
+{
+	return (size - 1) / LUA_POOL_GRANULARITY;
+}
+
+
+static void* lua_poolget(size_t size)
+{
+	auto& pool = lua_pool;
+	auto c = lua_poolclass(size);
+
+	if (auto block = pool.free[c])
+	{
+		pool.free[c] = *(void**)block;
+		return block;
+	}
+
+	size = (c + 1) * LUA_POOL_GRANULARITY;
+
+	// Carve blocks out of a new slab once the current one runs out, its first bytes linking it to the previous slabs.
+	if (size_t(pool.end[c] - pool.cursor[c]) < size)
+	{
+		auto slab = (char*)SDL_malloc(LUA_POOL_SLABSIZE);
+
+		if (slab == nullptr)
+		{ return nullptr; }
+
+		*(void**)slab = pool.slabs;
+		pool.slabs = slab;
+		pool.cursor[c] = slab + LUA_POOL_GRANULARITY;
+		pool.end[c] = slab + LUA_POOL_SLABSIZE;
+		pool.stats.reserved += LUA_POOL_SLABSIZE;
+	}
+
+	auto block = pool.cursor[c];
+	pool.cursor[c] += size;
+	return block;
+}
+
+
+static void lua_poolrelease(void* ptr, size_t size)
+{
+	auto& pool = lua_pool;
+	pool.stats.live -= size;
+
+	if (size <= LUA_POOL_MAXSIZE)
+	{
+		auto c = lua_poolclass(size);
+		*(void**)ptr = pool.free[c];
+		pool.free[c] = ptr;
+		pool.stats.classes[c].live -= 1;
+	}
+	else
+	{
+		SDL_free(ptr);
+		pool.stats.reserved -= size;
+		pool.stats.large.live -= 1;
+	}
+}
+
+
+void* lua_poolalloc(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+	auto& stats = lua_pool.stats;
+
+	// Lua passes the type of new objects as their old size.
+	if (ptr == nullptr)
+	{ osize = 0; }
+
+	if (nsize == 0)
+	{
+		if (ptr)
+		{ lua_poolrelease(ptr, osize); }
+
+		return nullptr;
+	}
+
+	lua_PoolClass* counters;
+	void* block;
+
+	if (nsize <= LUA_POOL_MAXSIZE)
+	{
+		// Blocks staying within their class don't move.
+		if (ptr && osize <= LUA_POOL_MAXSIZE && lua_poolclass(osize) == lua_poolclass(nsize))
+		{
+			stats.live += nsize - osize;
+			return ptr;
+		}
+
+		// Lua assumes shrinking never fails, a block too large for its new class is still safe to pool once freed.
+		if ((block = lua_poolget(nsize)) == nullptr)
+		{ return osize >= nsize ? ptr : nullptr; }
+
+		counters = &stats.classes[lua_poolclass(nsize)];
+	}
+	else if (ptr && osize > LUA_POOL_MAXSIZE)
+	{
+		if ((block = SDL_realloc(ptr, nsize)) == nullptr)
+		{ return osize >= nsize ? ptr : nullptr; }
+
+		stats.live += nsize - osize;
+		stats.reserved += nsize - osize;
+		stats.allocations += 1;
+		stats.large.allocations += 1;
+		return block;
+	}
+	else
+	{
+		if ((block = SDL_malloc(nsize)) == nullptr)
+		{ return nullptr; }
+
+		stats.reserved += nsize;
+		counters = &stats.large;
+	}
+
+	if (ptr)
+	{
+		SDL_memcpy(block, ptr, SDL_min(osize, nsize));
+		lua_poolrelease(ptr, osize);
+	}
+
+	stats.live += nsize;
+	stats.allocations += 1;
+	counters->live += 1;
+	counters->allocations += 1;
+	return block;
+}
+
+
+const lua_PoolStats& lua_getpoolstats()
+{
+	return lua_pool.stats;
 }
\ No newline at end of file
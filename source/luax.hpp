@@ -2,6 +2,8 @@
 #define GAME_LUAX_HEADER
 
 
+#include <cstddef>
+#include <new>
 #include <string_view>
 
 #include <lua.hpp>
@@ -99,6 +101,160 @@ T* lua_checkudata(lua_State* lua, int arg, const char* tname)
 	return (T*)luaL_checkudata(lua, arg, tname);
 }
 
+/**
+ * @brief Type of full userdata, whose metatable is keyed in the registry by the address of its `lua_Type`.
+ * 
+ * @note Checking a type this way compares metatables by identity, without looking up its name as a string,
+ *  so instances must be `inline constexpr` variables to have a single address across translation units.
+ */
+struct lua_Type
+{
+	const char* name;	/**< Name of the metatable in the registry, also used in error messages. */
+};
+
+/**
+ * [-0, +1, m]
+ * 
+ * Equivalent to calling [`luaL_newmetatable`](https://www.lua.org/manual/5.4/manual.html#luaL_newmetatable)
+ *  except that the metatable is also keyed by the address of `type` in the registry.
+ * 
+ * @param lua Lua state.
+ * @param type Type of the userdata using this metatable.
+ * @return Zero if the registry already had this metatable, non-zero otherwise.
+ */
+int lua_newtype(lua_State* lua, const lua_Type& type);
+
+/**
+ * [-0, +0, -]
+ * 
+ * Set the metatable of `type` as the metatable of the value on top of the stack.
+ * 
+ * @param lua Lua state.
+ * @param type Type of the userdata, whose metatable was created by `lua_newtype`.
+ */
+void lua_settype(lua_State* lua, const lua_Type& type);
+
+/**
+ * [-0, +0, -]
+ * 
+ * Equivalent to calling [`luaL_testudata`](https://www.lua.org/manual/5.4/manual.html#luaL_testudata)
+ *  except that the metatable is found by the address of `type` rather than by name.
+ * 
+ * @param lua Lua state.
+ * @param arg Argument index to test.
+ * @param type Type of the userdata, whose metatable was created by `lua_newtype`.
+ * @return A pointer to the userdata's memory block, or `nullptr` on failure.
+ */
+void* lua_testtype(lua_State* lua, int arg, const lua_Type& type);
+
+/**
+ * [-0, +0, v]
+ * 
+ * Equivalent to calling [`luaL_checkudata`](https://www.lua.org/manual/5.4/manual.html#luaL_checkudata)
+ *  except that the metatable is found by the address of `type` rather than by name.
+ * 
+ * Raises the same "X expected, got Y" error as `luaL_checkudata` on failure.
+ * 
+ * @param lua Lua state.
+ * @param arg Argument index to check.
+ * @param type Type of the userdata, whose metatable was created by `lua_newtype`.
+ * @return A pointer to the userdata's memory block.
+ */
+void* lua_checktype(lua_State* lua, int arg, const lua_Type& type);
+
+/**
+ * [-0, +0, v]
+ * 
+ * Check that the metatable of the userdata at the given index is the one of `type`.
+ * 
+ * @tparam T The type of the userdata's memory block.
+ * @param lua Lua state.
+ * @param arg Argument index to check.
+ * @param type Type of the userdata, whose metatable was created by `lua_newtype`.
+ * @return A pointer to the userdata's memory block.
+ */
+template<typename T>
+T* lua_checkudata(lua_State* lua, int arg, const lua_Type& type)
+{
+	return (T*)lua_checktype(lua, arg, type);
+}
+
+/**
+ * @brief Layout of a full userdata holding a handle & its metadata inline, in a single block.
+ * 
+ * @note Unlike uservalues, reading the metadata of a handle involves no call into Lua.
+ *  References to other Lua values must still be kept in uservalues, so that they're not collected.
+ * 
+ * @tparam T Type of the handle, usually a pointer to an SDL object.
+ * @tparam Meta Type of the metadata kept alongside the handle, or `void` if there is none.
+ */
+template<typename T, typename Meta = void>
+struct lua_Handle
+{
+	T handle;
+	Meta meta;
+};
+
+template<typename T>
+struct lua_Handle<T, void>
+{
+	T handle;
+};
+
+/**
+ * [-0, +1, m]
+ * 
+ * Push a new full userdata laid out as `H` onto the stack, value-initialized,
+ *  then give it the metatable of `type`.
+ * 
+ * @tparam H A `lua_Handle` type.
+ * @param lua Lua state.
+ * @param type Type of the handle, whose metatable was created by `lua_newtype`.
+ * @param nuvalue Number of uservalues to give our userdata.
+ * @return A reference to the newly allocated handle.
+ */
+template<typename H>
+H& lua_newhandle(lua_State* lua, const lua_Type& type, int nuvalue = 0)
+{
+	auto& handle = *new (lua_newuserdatauv(lua, sizeof(H), nuvalue)) H{};
+	lua_settype(lua, type);
+	return handle;
+}
+
+/**
+ * [-0, +0, m]
+ * 
+ * Test whether the function argument `arg` is a handle of the given type.
+ * 
+ * @tparam H A `lua_Handle` type.
+ * @param lua Lua state.
+ * @param arg Argument index to test.
+ * @param type Type of the handle, whose metatable was created by `lua_newtype`.
+ * @return A pointer to the handle, or `nullptr` on failure.
+ */
+template<typename H>
+H* lua_testhandle(lua_State* lua, int arg, const lua_Type& type)
+{
+	return (H*)lua_testtype(lua, arg, type);
+}
+
+/**
+ * [-0, +0, v]
+ * 
+ * Check that the function argument `arg` is a handle of the given type.
+ * 
+ * @tparam H A `lua_Handle` type.
+ * @param lua Lua state.
+ * @param arg Argument index to check.
+ * @param type Type of the handle, whose metatable was created by `lua_newtype`.
+ * @return A reference to the handle.
+ */
+template<typename H>
+H& lua_checkhandle(lua_State* lua, int arg, const lua_Type& type)
+{
+	return *(H*)lua_checktype(lua, arg, type);
+}
+
 /**
  * @brief Property getter/setter function signature.
  * 
@@ -108,4 +264,65 @@ template<typename T>
 using lua_Prop = void(*)(lua_State*, T&);
 
 
+/**
+ * @brief Granularity of the size classes of `lua_poolalloc`, in bytes.
+ */
+#define LUA_POOL_GRANULARITY 16
+
+/**
+ * @brief Number of size classes of `lua_poolalloc`, blocks larger than the last one are allocated on their own.
+ */
+#define LUA_POOL_CLASSES 16
+
+/**
+ * @brief Size of the largest blocks pooled by `lua_poolalloc`, in bytes.
+ */
+#define LUA_POOL_MAXSIZE (LUA_POOL_GRANULARITY * LUA_POOL_CLASSES)
+
+/**
+ * @brief Counters of a size class of `lua_poolalloc`.
+ */
+struct lua_PoolClass
+{
+	size_t live;			/**< Number of blocks currently in use. */
+	size_t allocations;		/**< Number of blocks handed out so far. */
+};
+
+/**
+ * @brief Counters of the allocations made through `lua_poolalloc` on the calling thread.
+ */
+struct lua_PoolStats
+{
+	size_t live;			/**< Bytes currently in use, as requested by Lua. */
+	size_t reserved;		/**< Bytes currently reserved from the system, both pooled & large. */
+	size_t allocations;		/**< Number of blocks handed out so far, both pooled & large. */
+
+	lua_PoolClass classes[LUA_POOL_CLASSES];	/**< Counters of each size class, the smallest first. */
+	lua_PoolClass large;	/**< Counters of blocks larger than `LUA_POOL_MAXSIZE`. */
+};
+
+/**
+ * Allocation function to pass to [`lua_newstate`](https://www.lua.org/manual/5.4/manual.html#lua_newstate),
+ *  serving blocks of up to `LUA_POOL_MAXSIZE` bytes from thread-local size-class pools
+ *  & larger blocks from `SDL_realloc`.
+ * 
+ * Pools grow by whole slabs which they keep until the thread exits,
+ *  so that long sessions reuse the same memory rather than fragmenting the system heap.
+ * 
+ * @note A Lua state using this allocator must only be used & closed on the thread that created it.
+ * 
+ * @param ud Unused.
+ * @param ptr Block to reallocate or free, or `NULL` to allocate a new block.
+ * @param osize Size of the block, or a Lua type when `ptr` is `NULL`.
+ * @param nsize Requested size of the block, or zero to free it.
+ * @return The reallocated block, or `NULL` if it was freed or couldn't be allocated.
+ */
+void* lua_poolalloc(void* ud, void* ptr, size_t osize, size_t nsize);
+
+/**
+ * @brief Get the counters of the allocations made through `lua_poolalloc` on the calling thread.
+ */
+const lua_PoolStats& lua_getpoolstats();
+
+
 #endif // GAME_LUAX_HEADER
\ No newline at end of file
@@ -0,0 +1,144 @@
+#ifndef GAME_PERFECTHASH_HEADER
+#define GAME_PERFECTHASH_HEADER
+
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+
+namespace Game
+{
+	inline namespace Detail
+	{
+		/**
+		 * @brief Hash a key with a given seed, using FNV-1a.
+		 */
+		constexpr uint64_t PerfectHashOf(const char* key, size_t length, uint64_t seed)
+		{
+			uint64_t hash = 14695981039346656037ull ^ seed;
+
+			for (size_t i = 0; i < length; ++i)
+			{
+				hash ^= (uint8_t)key[i];
+				hash *= 1099511628211ull;
+			}
+
+			return hash ^ (hash >> 32);
+		}
+	}
+
+
+	/**
+	 * @brief Minimal perfect hash of N names, found at compile-time.
+	 *
+	 * @note Slots are four times as many as names, so that a seed mapping every name to its own slot is found quickly.
+	 *
+	 * @tparam N Number of names.
+	 */
+	template<size_t N>
+	struct PerfectHash
+	{
+		static constexpr size_t slot_count = std::bit_ceil(N * 4 + 1);
+
+		std::array<std::string_view, N> names;
+		std::array<uint16_t, slot_count> slots;	/**< Index of the name in each slot, or N if empty. */
+		uint64_t seed;
+
+		constexpr PerfectHash(const std::array<std::string_view, N>& names) : names(names), slots(), seed(0)
+		{
+			for (;; ++seed)
+			{
+				slots.fill((uint16_t)N);
+				bool collided = false;
+
+				for (size_t i = 0; i < N && !collided; ++i)
+				{
+					auto& slot = slots[PerfectHashOf(names[i].data(), names[i].size(), seed) & (slot_count - 1)];
+					collided = slot != N;
+					slot = (uint16_t)i;
+				}
+
+				if (!collided)
+				{ break; }
+			}
+		}
+
+		/**
+		 * @brief Find the index of a name, or N if it isn't part of the table.
+		 */
+		constexpr size_t Find(const char* key, size_t length) const
+		{
+			size_t i = slots[PerfectHashOf(key, length, seed) & (slot_count - 1)];
+			return i < N && names[i] == std::string_view(key, length) ? i : N;
+		}
+	};
+
+
+	/**
+	 * @brief Read-only map of N names to values, built at compile-time around a `PerfectHash`.
+	 *
+	 * @note Lookups hash the key once & compare it against a single name, without allocating.
+	 *  Its interface follows `HashMap`'s, so that `find` returns `end()` for unknown keys.
+	 *
+	 * @tparam V Value type.
+	 * @tparam N Number of entries.
+	 */
+	template<typename V, size_t N>
+	struct PerfectHashMap
+	{
+		using value_type = std::pair<std::string_view, V>;
+
+		std::array<value_type, N> entries;
+		PerfectHash<N> hash;
+
+		constexpr const value_type* begin() const
+		{ return entries.data(); }
+
+		constexpr const value_type* end() const
+		{ return entries.data() + N; }
+
+		constexpr size_t size() const
+		{ return N; }
+
+		/**
+		 * @brief Find the entry of a key, or `end()` if it isn't part of the map.
+		 */
+		constexpr const value_type* find(std::string_view key) const
+		{ return begin() + hash.Find(key.data(), key.size()); }
+	};
+
+
+	inline namespace Detail
+	{
+		template<typename V, size_t N, size_t... I>
+		constexpr PerfectHashMap<V, N> MakePerfectHashMap(const std::pair<std::string_view, V> (&entries)[N], std::index_sequence<I...>)
+		{
+			return PerfectHashMap<V, N>
+			{
+				{ entries[I]... },
+				PerfectHash<N>({ entries[I].first... }),
+			};
+		}
+	}
+
+
+	/**
+	 * @brief Build a `PerfectHashMap` from a list of names & values, meant to initialize a `static constexpr` variable.
+	 *
+	 * @tparam V Value type.
+	 * @tparam N Number of entries, deduced from the list.
+	 * @param entries Names & their values, which must all be distinct names.
+	 */
+	template<typename V, size_t N>
+	constexpr PerfectHashMap<V, N> MakePerfectHashMap(const std::pair<std::string_view, V> (&entries)[N])
+	{
+		return Detail::MakePerfectHashMap<V, N>(entries, std::make_index_sequence<N>());
+	}
+}
+
+
+#endif // GAME_PERFECTHASH_HEADER
\ No newline at end of file
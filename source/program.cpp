@@ -9,6 +9,15 @@ using namespace Game;
 #include "bindings.hpp"
 
 
+static int call_register(lua_State* lua);
+
+static int luaopen_garbage(lua_State* lua);
+
+static size_t lua_getheapsize(lua_State* lua);
+
+static int call_panic(lua_State* lua);
+
+
 Program::Program(int argc, char** argv)
 {
 	// Create our main window with our desired flags.
@@ -36,20 +45,34 @@ Program::Program(int argc, char** argv)
 	if (!SDL_ClaimWindowForGPUDevice(device, window))
 	{ SDL_LogError(0, "%s", SDL_GetError); }
 
-	// Initialize our Lua state.
-	lua = luaL_newstate();
+	// Initialize our Lua state, allocating through our thread's pools.
+	lua = lua_newstate(lua_poolalloc, nullptr);
+
+	if (lua == nullptr)
+	{
+		SDL_DestroyGPUDevice(device);
+		SDL_DestroyWindow(window);
+		throw std::exception("Failed to create Lua state.");
+	}
+
+	lua_atpanic(lua, call_panic);
 	lua_getprogram(lua) = this;
 	luaL_openlibs(lua);
 	lua_openbindings(lua);
+	lua_register(lua, "register", call_register);
+	luaL_requiref(lua, "garbage", luaopen_garbage, true);
+	lua_pop(lua, 1);
+
+	// Keep the traceback function at hand, as the message handler of every call into our scripts.
+	if (lua_pushtraceback(lua))
+	{ traceback = luaL_ref(lua, LUA_REGISTRYINDEX); }
 
-	// Load & run our main script.
-	auto traceback = lua_pushtraceback(lua);
+	// Load & run our main script, then resolve the entry points it defined.
+	lua_rawgeti(lua, LUA_REGISTRYINDEX, traceback);
 	if (luaL_loadfile(lua, "assets/scripts/main.lua") == LUA_OK)
-	{
-		if (lua_pcall(lua, 0, 0, traceback) != LUA_OK)
-		{ SDL_LogError(0, "Lua: %s", lua_tostring(lua, -1)); }
-	}
+	{ Call(0); }
 	lua_settop(lua, 0);
+	Register(lua);
 
 	// Show our window once we're done initializing.
 	if (!SDL_ShowWindow(window))
@@ -57,6 +80,7 @@ Program::Program(int argc, char** argv)
 
 	// Start measuring time.
 	time = SDL_GetPerformanceCounter();
+	garbage.logged = time;
 }
 
 
@@ -75,15 +99,21 @@ SDL_AppResult Program::Update()
 	time = SDL_GetPerformanceCounter();
 	double delta = double(time - prev) / double(SDL_GetPerformanceFrequency());
 
-	// Invoke our main script's draw function.
-	auto traceback = lua_pushtraceback(lua);
-	if (lua_getglobal(lua, "draw") == LUA_TFUNCTION)
+	// Invoke our main script's per-frame callbacks.
+	if (Push(Callback::Update))
 	{
 		lua_pushnumber(lua, delta);
-		if (lua_pcall(lua, 1, 0, traceback) != LUA_OK)
-		{ SDL_LogError(0, "Lua: %s", lua_tostring(lua, -1)); }
+		Call(1);
 	}
-	lua_settop(lua, 0);
+
+	if (Push(Callback::Draw))
+	{
+		lua_pushnumber(lua, delta);
+		Call(1);
+	}
+
+	// Collect garbage with the time left before the next frame.
+	Collect(time);
 
 	// Continue running.
 	return SDL_APP_CONTINUE;
@@ -97,6 +127,14 @@ SDL_AppResult Program::Handle(const SDL_Event& event)
 		case SDL_EVENT_QUIT:
 			return Handle(event.quit);
 
+		case SDL_EVENT_KEY_DOWN:
+		case SDL_EVENT_KEY_UP:
+			return Handle(event.key);
+
+		case SDL_EVENT_MOUSE_BUTTON_DOWN:
+		case SDL_EVENT_MOUSE_BUTTON_UP:
+			return Handle(event.button);
+
 		default:
 			return SDL_APP_CONTINUE;
 	}
@@ -114,4 +152,261 @@ SDL_AppResult Program::Handle(const SDL_QuitEvent& quit)
 
 	// Exit app & signal success.
 	return SDL_APP_SUCCESS;
+}
+
+
+SDL_AppResult Program::Handle(const SDL_KeyboardEvent& key)
+{
+	// Invoke our main script's input function, ignoring repeated key presses.
+	if (!key.repeat && Push(Callback::Input))
+	{
+		lua_pushliteral(lua, "key");
+		lua_pushstring(lua, SDL_GetKeyName(key.key));
+		lua_pushboolean(lua, key.down);
+		Call(3);
+	}
+
+	return SDL_APP_CONTINUE;
+}
+
+
+SDL_AppResult Program::Handle(const SDL_MouseButtonEvent& button)
+{
+	// Invoke our main script's input function.
+	if (Push(Callback::Input))
+	{
+		lua_pushliteral(lua, "mouse");
+		lua_pushinteger(lua, button.button);
+		lua_pushboolean(lua, button.down);
+		Call(3);
+	}
+
+	return SDL_APP_CONTINUE;
+}
+
+
+void Program::SetGarbageBudget(double budget)
+{
+	garbage.budget = SDL_max(budget, 0.0);
+}
+
+
+void Program::SetGarbageMode(GarbageMode mode)
+{
+	if (mode == GarbageMode::Generational)
+	{ lua_gc(lua, LUA_GCGEN, 0, 0); }
+	else
+	{ lua_gc(lua, LUA_GCINC, 0, 0, 0); }
+
+	garbage.mode = mode;
+}
+
+
+void Program::Register(lua_State* thread)
+{
+	static const char* const names[] = { "update", "draw", "input" };
+	static_assert(SDL_arraysize(names) == size_t(Callback::Count));
+
+	for (size_t i = 0; i < size_t(Callback::Count); ++i)
+	{
+		luaL_unref(thread, LUA_REGISTRYINDEX, callbacks[i]);
+		callbacks[i] = LUA_NOREF;
+
+		if (lua_getglobal(thread, names[i]) == LUA_TFUNCTION)
+		{ callbacks[i] = luaL_ref(thread, LUA_REGISTRYINDEX); }
+		else
+		{ lua_pop(thread, 1); }
+	}
+}
+
+
+bool Program::Push(Callback callback)
+{
+	auto ref = callbacks[size_t(callback)];
+
+	if (ref == LUA_NOREF)
+	{ return false; }
+
+	lua_rawgeti(lua, LUA_REGISTRYINDEX, traceback);
+	lua_rawgeti(lua, LUA_REGISTRYINDEX, ref);
+	return true;
+}
+
+
+void Program::Call(int nargs)
+{
+	// The message handler sits right below the callback, and is nil without the debug library.
+	auto msgh = lua_gettop(lua) - nargs - 1;
+
+	if (lua_pcall(lua, nargs, 0, lua_isnil(lua, msgh) ? 0 : msgh) != LUA_OK)
+	{ SDL_LogError(0, "Lua: %s", lua_tostring(lua, -1)); }
+
+	lua_settop(lua, msgh - 1);
+}
+
+
+
+void Program::Collect(uint64_t start)
+{
+	auto frequency = SDL_GetPerformanceFrequency();
+	auto budget = uint64_t(garbage.budget * double(frequency));
+
+	// Don't step past the display's next refresh, where the frame would be presented.
+	if (auto display = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window)); display && display->refresh_rate > 0.0f)
+	{
+		auto period = uint64_t(double(frequency) / double(display->refresh_rate));
+		auto elapsed = SDL_GetPerformanceCounter() - start;
+		budget = elapsed < period ? SDL_min(budget, period - elapsed) : 0;
+	}
+
+	auto heap = lua_getheapsize(lua);
+	auto begin = SDL_GetPerformanceCounter();
+	auto now = begin;
+	garbage.steps = 0;
+
+	while (now - begin < budget)
+	{
+		// A generational step is a whole minor collection, while an incremental step finishing a cycle leaves no debt to pay.
+		auto finished = lua_gc(lua, LUA_GCSTEP, 0);
+		now = SDL_GetPerformanceCounter();
+		++garbage.steps;
+
+		if (finished || garbage.mode == GarbageMode::Generational)
+		{ break; }
+	}
+
+	garbage.heap = lua_getheapsize(lua);
+	garbage.collected = heap > garbage.heap ? heap - garbage.heap : 0;
+	garbage.time = double(now - begin) / double(frequency);
+
+	// Log a summary of the last second.
+	garbage.logged_collected += garbage.collected;
+	garbage.logged_time = SDL_max(garbage.logged_time, garbage.time);
+	garbage.logged_frames += 1;
+
+	if (now - garbage.logged >= frequency)
+	{
+		auto allocations = lua_getpoolstats().allocations;
+		garbage.allocation_rate = double(allocations - garbage.logged_allocations) * double(frequency) / double(now - garbage.logged);
+
+		SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Lua GC: %d frames, %zu bytes collected, %zu bytes in use, %.3f ms longest step, %.0f allocs/s",
+			garbage.logged_frames, garbage.logged_collected, garbage.heap, garbage.logged_time * 1000.0, garbage.allocation_rate);
+
+		garbage.logged = now;
+		garbage.logged_allocations = allocations;
+		garbage.logged_collected = 0;
+		garbage.logged_time = 0.0;
+		garbage.logged_frames = 0;
+	}
+}
+
+
+static int call_register(lua_State* lua)
+{
+	lua_getprogram(lua)->Register(lua);
+	return 0;
+}
+
+
+static int call_garbage_budget(lua_State* lua)
+{
+	auto& program = *lua_getprogram(lua);
+	lua_pushnumber(lua, program.GetGarbage().budget);
+
+	if (!lua_isnoneornil(lua, 1))
+	{ program.SetGarbageBudget(luaL_checknumber(lua, 1)); }
+
+	return 1;
+}
+
+
+static int call_garbage_mode(lua_State* lua)
+{
+	static const char* const modes[] = { "incremental", "generational", nullptr };
+
+	auto& program = *lua_getprogram(lua);
+	lua_pushstring(lua, modes[size_t(program.GetGarbage().mode)]);
+
+	if (!lua_isnoneornil(lua, 1))
+	{ program.SetGarbageMode(GarbageMode(luaL_checkoption(lua, 1, nullptr, modes))); }
+
+	return 1;
+}
+
+
+static int call_garbage_stats(lua_State* lua)
+{
+	auto& garbage = lua_getprogram(lua)->GetGarbage();
+	lua_pushinteger(lua, garbage.collected);
+	lua_pushinteger(lua, garbage.heap);
+	lua_pushnumber(lua, garbage.time);
+	return 3;
+}
+
+
+static int call_garbage_memory(lua_State* lua)
+{
+	auto& garbage = lua_getprogram(lua)->GetGarbage();
+	auto& stats = lua_getpoolstats();
+
+	lua_createtable(lua, 0, 5);
+	lua_pushinteger(lua, stats.live);
+	lua_setfield(lua, -2, "live");
+	lua_pushinteger(lua, stats.reserved);
+	lua_setfield(lua, -2, "reserved");
+	lua_pushinteger(lua, stats.allocations);
+	lua_setfield(lua, -2, "allocations");
+	lua_pushnumber(lua, garbage.allocation_rate);
+	lua_setfield(lua, -2, "rate");
+
+	// One entry per size class, followed by the blocks too large for any class.
+	lua_createtable(lua, LUA_POOL_CLASSES + 1, 0);
+	for (int i = 0; i <= LUA_POOL_CLASSES; ++i)
+	{
+		auto& counters = i < LUA_POOL_CLASSES ? stats.classes[i] : stats.large;
+
+		lua_createtable(lua, 0, 3);
+		if (i < LUA_POOL_CLASSES)
+		{
+			lua_pushinteger(lua, (i + 1) * LUA_POOL_GRANULARITY);
+			lua_setfield(lua, -2, "size");
+		}
+		lua_pushinteger(lua, counters.live);
+		lua_setfield(lua, -2, "live");
+		lua_pushinteger(lua, counters.allocations);
+		lua_setfield(lua, -2, "allocations");
+		lua_rawseti(lua, -2, i + 1);
+	}
+	lua_setfield(lua, -2, "classes");
+
+	return 1;
+}
+
+
+static int luaopen_garbage(lua_State* lua)
+{
+	static const luaL_Reg library[]
+	{
+		{ "budget", call_garbage_budget },
+		{ "mode", call_garbage_mode },
+		{ "stats", call_garbage_stats },
+		{ "memory", call_garbage_memory },
+		{ nullptr, nullptr },
+	};
+
+	luaL_newlib(lua, library);
+	return 1;
+}
+
+
+static size_t lua_getheapsize(lua_State* lua)
+{
+	return size_t(lua_gc(lua, LUA_GCCOUNT)) * 1024 + size_t(lua_gc(lua, LUA_GCCOUNTB));
+}
+
+
+static int call_panic(lua_State* lua)
+{
+	SDL_LogCritical(SDL_LOG_CATEGORY_APPLICATION, "Lua panic: %s", lua_isstring(lua, -1) ? lua_tostring(lua, -1) : "error object is not a string");
+	return 0;
 }
\ No newline at end of file
@@ -10,6 +10,54 @@
 
 namespace Game
 {
+	/**
+	 * @brief Script entry points invoked by the program, each named after the global function it is resolved from.
+	 */
+	enum class Callback
+	{
+		Update,		/**< `update(delta)`, called every frame before drawing. */
+		Draw,		/**< `draw(delta)`, called every frame. */
+		Input,		/**< `input(device, code, down)`, called for every key & mouse button press or release. */
+		Count,
+	};
+
+
+	/**
+	 * @brief Garbage collection modes of the Lua state, as with `collectgarbage("incremental")` & `collectgarbage("generational")`.
+	 */
+	enum class GarbageMode
+	{
+		Incremental,	/**< Collect in small steps interleaved with the script. */
+		Generational,	/**< Collect young objects often & old objects seldom. */
+	};
+
+
+	/**
+	 * @brief Per-frame garbage collection budget & telemetry of the Lua state.
+	 * 
+	 * @note The allocator still collects on its own when frames leave no time to spare,
+	 *  stepping every frame only pays off its debt ahead of time.
+	 */
+	struct Garbage
+	{
+		GarbageMode mode = GarbageMode::Incremental;	/**< Mode the collector was last switched to. */
+
+		double budget = 0.001;		/**< Most time spent stepping the collector every frame, in seconds. */
+
+		size_t collected = 0;		/**< Bytes freed by the last frame's steps. */
+		size_t heap = 0;			/**< Bytes in use by the Lua state after the last frame's steps. */
+		double time = 0.0;			/**< Time spent by the last frame's steps, in seconds. */
+		int steps = 0;				/**< Number of steps taken by the last frame. */
+		double allocation_rate = 0.0;	/**< Allocations per second made by the Lua state, over the last logged period. */
+
+		uint64_t logged = 0;		/**< Performance counter at the time telemetry was last logged. */
+		size_t logged_collected = 0;	/**< Bytes freed since telemetry was last logged. */
+		double logged_time = 0.0;	/**< Longest time spent stepping in a frame since telemetry was last logged, in seconds. */
+		int logged_frames = 0;		/**< Number of frames since telemetry was last logged. */
+		size_t logged_allocations = 0;	/**< Allocations made by the Lua state at the time telemetry was last logged. */
+	};
+
+
 	/**
 	 * @brief Main "singleton" class of the project.
 	 */
@@ -23,6 +71,12 @@ namespace Game
 
 		uint64_t time = 0;
 
+		int traceback = LUA_NOREF;
+
+		int callbacks[size_t(Callback::Count)] = { LUA_NOREF, LUA_NOREF, LUA_NOREF };
+
+		Garbage garbage;
+
 
 	 public:
 		/**
@@ -86,9 +140,60 @@ namespace Game
 		 */
 		SDL_AppResult Handle(const SDL_Event& event);
 
+		/**
+		 * @brief Resolve the script's entry points from their globals into registry references,
+		 *  so that invoking them every frame involves no lookup by name.
+		 * 
+		 * @note Called once the main script has run, and again whenever a script calls `register`.
+		 * 
+		 * @param thread Lua thread from which to look up the globals.
+		 */
+		void Register(lua_State* thread);
+
+		/**
+		 * @brief Get the garbage collection budget & telemetry of the Lua state.
+		 */
+		inline const Garbage& GetGarbage() const
+		{ return garbage; }
+
+		/**
+		 * @brief Set the time spent stepping the garbage collector every frame.
+		 * 
+		 * @param budget Time in seconds, or zero to only collect when the allocator decides to.
+		 */
+		void SetGarbageBudget(double budget);
+
+		/**
+		 * @brief Switch the garbage collector of the Lua state to the given mode.
+		 * 
+		 * @param mode Mode of garbage collection.
+		 */
+		void SetGarbageMode(GarbageMode mode);
+
 
 	 private:
 		SDL_AppResult Handle(const SDL_QuitEvent& quit);
+		SDL_AppResult Handle(const SDL_KeyboardEvent& key);
+		SDL_AppResult Handle(const SDL_MouseButtonEvent& button);
+
+		/**
+		 * @brief Push the message handler & the given callback, unless the script doesn't define it.
+		 * 
+		 * @return Whether the callback was pushed, to be followed by its arguments & a call to `Call`.
+		 */
+		bool Push(Callback callback);
+
+		/**
+		 * @brief Call the callback pushed by `Push` with the given number of arguments, logging errors.
+		 */
+		void Call(int nargs);
+
+		/**
+		 * @brief Step the garbage collector with whatever is left of the frame, up to our budget, then update telemetry.
+		 * 
+		 * @param start Performance counter at the start of the frame.
+		 */
+		void Collect(uint64_t start);
 	};
 }
 
@@ -1,7 +1,65 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 
+#include <cstdlib>
+#include <map>
+#include <string>
+
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_filesystem.h>
+
 #include <json.hpp>
+#include <jsonx.hpp>
+#include <bindings/json.hpp>
+
+#include "json_inputs.hpp"
+
+
+/**
+ * @brief Counts allocations made through SDL's memory functions while in scope.
+ */
+struct AllocationCounter
+{
+	static inline SDL_malloc_func malloc_func;
+	static inline SDL_calloc_func calloc_func;
+	static inline SDL_realloc_func realloc_func;
+	static inline SDL_free_func free_func;
+
+	static inline SDL_AtomicInt allocations;
+	static inline SDL_AtomicInt frees;
+
+	AllocationCounter()
+	{
+		SDL_GetMemoryFunctions(&malloc_func, &calloc_func, &realloc_func, &free_func);
+		SDL_SetMemoryFunctions(Malloc, Calloc, Realloc, Free);
+		SDL_SetAtomicInt(&allocations, 0);
+		SDL_SetAtomicInt(&frees, 0);
+	}
+
+	~AllocationCounter()
+	{
+		SDL_SetMemoryFunctions(malloc_func, calloc_func, realloc_func, free_func);
+	}
+
+	int Allocations() const
+	{ return SDL_GetAtomicInt(&allocations); }
+
+	int Outstanding() const
+	{ return SDL_GetAtomicInt(&allocations) - SDL_GetAtomicInt(&frees); }
+
+	static void* Malloc(size_t size)
+	{ SDL_AddAtomicInt(&allocations, 1); return malloc_func(size); }
+
+	static void* Calloc(size_t count, size_t size)
+	{ SDL_AddAtomicInt(&allocations, 1); return calloc_func(count, size); }
+
+	static void* Realloc(void* mem, size_t size)
+	{ SDL_AddAtomicInt(&allocations, 1); if (mem) { SDL_AddAtomicInt(&frees, 1); } return realloc_func(mem, size); }
+
+	static void Free(void* mem)
+	{ if (mem) { SDL_AddAtomicInt(&frees, 1); } free_func(mem); }
+};
 
 
 TEST_CASE("JSON/Chunk/Create & Destroy", "[json]")
@@ -91,4 +149,2167 @@ TEST_CASE("JSON/Reader/Read Memory", "[json]")
 		REQUIRE(root->type == JSN_TYPE_OBJECT);
 		JSN_DestroyChunk(chunk);
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("JSON/Reader/Read Stream", "[json]")
+{
+	SECTION("Read tokens straddling blocks")
+	{
+		constexpr size_t count = 20000;
+
+		SDL_IOStream* stream = SDL_IOFromDynamicMem();
+		SDL_WriteIO(stream, "[", 1);
+		for (size_t i = 0; i < count; ++i)
+		{ SDL_WriteIO(stream, "12345, true, ", 13); }
+		SDL_WriteIO(stream, "null]", 5);
+		SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+
+		JSN_Chunk* chunk = JSN_ReadChunkFromIO(stream, true);
+		REQUIRE(chunk != NULL);
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		REQUIRE(root->type == JSN_TYPE_ARRAY);
+		REQUIRE(root->array_value->count == count * 2 + 1);
+		JSN_DestroyChunk(chunk);
+	}
+}
+
+
+TEST_CASE("JSON/Chunk/Arena", "[json]")
+{
+	SECTION("Allocate nodes in blocks")
+	{
+		constexpr size_t count = 50000;
+
+		AllocationCounter counter;
+		SDL_IOStream* stream = SDL_IOFromDynamicMem();
+		SDL_WriteIO(stream, "[", 1);
+		for (size_t i = 0; i < count; ++i)
+		{ SDL_WriteIO(stream, "[1], ", 5); }
+		SDL_WriteIO(stream, "[]]", 3);
+		SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+
+		JSN_Chunk* chunk = JSN_ReadChunkFromIO(stream, true);
+		REQUIRE(chunk != NULL);
+		REQUIRE(counter.Outstanding() < 32);
+
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		REQUIRE(root->type == JSN_TYPE_ARRAY);
+		REQUIRE(root->array_value->count == count + 1);
+		JSN_DestroyChunk(chunk);
+
+		REQUIRE(counter.Outstanding() == 0);
+	}
+
+	SECTION("Compact overwritten values")
+	{
+		JSN_Chunk* chunk = JSN_CreateChunk();
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			JSN_ChunkSetArray(chunk, root);
+			JSN_ChunkSetString(chunk, JSN_ChunkAddElement(chunk, root, JSN_APPEND, NULL), "brick", 5);
+			JSN_ChunkSetInteger(chunk, JSN_ChunkAddElement(chunk, root, JSN_APPEND, NULL), i);
+		}
+
+		REQUIRE(JSN_ChunkCompact(chunk));
+		root = JSN_GetChunkRoot(chunk);
+		REQUIRE(root->type == JSN_TYPE_ARRAY);
+		REQUIRE(root->array_value->count == 2);
+		REQUIRE(SDL_strcmp(JSN_ArrayGet(root, 0)->string_value, "brick") == 0);
+		REQUIRE(JSN_ArrayGet(root, 1)->integer_value == 999);
+		JSN_DestroyChunk(chunk);
+	}
+}
+
+
+TEST_CASE("JSON/Chunk/Access", "[json]")
+{
+	SECTION("Get elements by index")
+	{
+		const char* json_string = "[0, [1, 2], 3.5, null]";
+		size_t json_length = SDL_strlen(json_string);
+
+		JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, json_length);
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		REQUIRE(root->array_value->count == 4);
+		REQUIRE(JSN_ArrayGet(root, 0)->integer_value == 0);
+		REQUIRE(JSN_ArrayGet(JSN_ArrayGet(root, 1), 1)->integer_value == 2);
+		REQUIRE(JSN_ArrayGet(root, 2)->number_value == 3.5);
+		REQUIRE(JSN_ArrayGet(root, 3)->type == JSN_TYPE_NULL);
+		REQUIRE(JSN_ArrayGet(root, 4) == NULL);
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Insert elements")
+	{
+		JSN_Chunk* chunk = JSN_CreateChunk();
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		JSN_ChunkSetArray(chunk, root);
+
+		JSN_ChunkSetInteger(chunk, JSN_ChunkAddElement(chunk, root, JSN_APPEND, NULL), 2);
+		JSN_ChunkSetInteger(chunk, JSN_ChunkAddElement(chunk, root, 0, NULL), 0);
+		JSN_ChunkSetInteger(chunk, JSN_ChunkAddElement(chunk, root, 1, NULL), 1);
+
+		for (int64_t i = 0; i < 3; ++i)
+		{ REQUIRE(JSN_ArrayGet(root, i)->integer_value == i); }
+
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Get properties by key")
+	{
+		constexpr int count = 1000;
+
+		JSN_Chunk* chunk = JSN_CreateChunk();
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		JSN_ChunkSetObject(chunk, root);
+
+		char key[32];
+		for (int i = 0; i < count; ++i)
+		{
+			int length = SDL_snprintf(key, sizeof(key), "monster%d", i);
+			JSN_ChunkSetInteger(chunk, JSN_ChunkAddProperty(chunk, root, JSN_APPEND, NULL, key, length), i);
+		}
+
+		JSN_ChunkSetInteger(chunk, JSN_ChunkAddProperty(chunk, root, 0, NULL, "first", 5), -1);
+		REQUIRE(root->object_value->index != NULL);
+
+		for (int i = 0; i < count; ++i)
+		{
+			int length = SDL_snprintf(key, sizeof(key), "monster%d", i);
+			JSN_Value* value = JSN_ObjectGet(root, key, length);
+			REQUIRE(value != NULL);
+			REQUIRE(value->integer_value == i);
+		}
+
+		REQUIRE(JSN_ObjectGet(root, "first", 5)->integer_value == -1);
+		REQUIRE(JSN_ObjectGet(root, "monster", 7) == NULL);
+
+		REQUIRE(JSN_ChunkCompact(chunk));
+		root = JSN_GetChunkRoot(chunk);
+		REQUIRE(JSN_ObjectGet(root, "monster500", 10)->integer_value == 500);
+		JSN_DestroyChunk(chunk);
+	}
+}
+
+
+TEST_CASE("JSON/Reader/Read Strings", "[json]")
+{
+	SECTION("Read plain string")
+	{
+		const char* json_string = "\"brick\"";
+		size_t json_length = SDL_strlen(json_string);
+
+		JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, json_length);
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		REQUIRE(root->type == JSN_TYPE_STRING);
+		REQUIRE(root->string_length == 5);
+		REQUIRE(SDL_strcmp(root->string_value, "brick") == 0);
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Read escaped string")
+	{
+		const char* json_string = "\"a\\\"b\\\\c\\/d\\n\\t\\u00e9\\u20AC\\ud83d\\ude00\"";
+		size_t json_length = SDL_strlen(json_string);
+
+		JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, json_length);
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		REQUIRE(root->type == JSN_TYPE_STRING);
+		REQUIRE(SDL_strcmp(root->string_value, "a\"b\\c/d\n\t\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80") == 0);
+		REQUIRE(root->string_length == SDL_strlen(root->string_value));
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Read object properties")
+	{
+		const char* json_string = "{ \"name\": \"Goblin\", \"stats\": { \"hp\": 7, \"tags\": [\"small\", \"green\"] } }";
+		size_t json_length = SDL_strlen(json_string);
+
+		JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, json_length);
+		REQUIRE(chunk != NULL);
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		REQUIRE(root->type == JSN_TYPE_OBJECT);
+		REQUIRE(SDL_strcmp(JSN_ObjectGet(root, "name", 4)->string_value, "Goblin") == 0);
+
+		JSN_Value* stats = JSN_ObjectGet(root, "stats", 5);
+		REQUIRE(JSN_ObjectGet(stats, "hp", 2)->integer_value == 7);
+		REQUIRE(SDL_strcmp(JSN_ArrayGet(JSN_ObjectGet(stats, "tags", 4), 1)->string_value, "green") == 0);
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Read strings in place")
+	{
+		char json_string[] = "{ \"plain\": \"text\", \"escaped\": \"a\\nb\" }";
+
+		JSN_Chunk* chunk = JSN_ReadChunkInSitu(json_string, sizeof(json_string) - 1);
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+
+		JSN_Value* plain = JSN_ObjectGet(root, "plain", 5);
+		REQUIRE(plain->string_value >= json_string);
+		REQUIRE(plain->string_value < json_string + sizeof(json_string));
+		REQUIRE(SDL_strcmp(plain->string_value, "text") == 0);
+
+		JSN_Value* escaped = JSN_ObjectGet(root, "escaped", 7);
+		REQUIRE(escaped->string_value >= json_string);
+		REQUIRE(escaped->string_value < json_string + sizeof(json_string));
+		REQUIRE(SDL_strcmp(escaped->string_value, "a\nb") == 0);
+		REQUIRE(escaped->string_length == 3);
+
+		REQUIRE(root->object_value->properties[0].key >= json_string);
+		REQUIRE(root->object_value->properties[0].key < json_string + sizeof(json_string));
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Read strings straddling blocks")
+	{
+		constexpr size_t count = 10000;
+
+		SDL_IOStream* stream = SDL_IOFromDynamicMem();
+		SDL_WriteIO(stream, "{", 1);
+		for (size_t i = 0; i < count; ++i)
+		{ SDL_IOprintf(stream, "\"key\\t%zu\": \"value\\u00e9%zu\", ", i, i); }
+		SDL_WriteIO(stream, "\"end\": null}", 12);
+		SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+
+		JSN_Chunk* chunk = JSN_ReadChunkFromIO(stream, true);
+		REQUIRE(chunk != NULL);
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		REQUIRE(root->object_value->count == count + 1);
+
+		char key[32], value[32];
+		for (size_t i = 0; i < count; ++i)
+		{
+			int key_length = SDL_snprintf(key, sizeof(key), "key\t%zu", i);
+			SDL_snprintf(value, sizeof(value), "value\xC3\xA9%zu", i);
+			REQUIRE(SDL_strcmp(JSN_ObjectGet(root, key, key_length)->string_value, value) == 0);
+		}
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Reject malformed input")
+	{
+		const char* invalid[]
+		{
+			"\"unterminated",
+			"\"bad \\x escape\"",
+			"\"lone \\udc00 surrogate\"",
+			"\"raw \n newline\"",
+			"[1 2]",
+			"[1,]",
+			"{1: 2}",
+			"{\"a\" 1}",
+			"[}",
+			"[[]",
+			"1 2",
+		};
+
+		for (const char* json_string : invalid)
+		{
+			INFO(json_string);
+			REQUIRE(JSN_ReadChunkFromMem(json_string, SDL_strlen(json_string)) == NULL);
+		}
+	}
+}
+
+
+static bool ValuesEqual(const JSN_Value* a, const JSN_Value* b)
+{
+	if (a->type != b->type || !JSN_LoadValue(a, false) || !JSN_LoadValue(b, false))
+	{ return false; }
+
+	switch (a->type)
+	{
+		case JSN_TYPE_BOOL:
+			return a->bool_value == b->bool_value;
+
+		case JSN_TYPE_INTEGER:
+			return a->integer_value == b->integer_value;
+
+		case JSN_TYPE_NUMBER:
+			return a->number_value == b->number_value || (a->number_value != a->number_value && b->number_value != b->number_value);
+
+		case JSN_TYPE_STRING:
+			return a->string_length == b->string_length && SDL_memcmp(a->string_value, b->string_value, a->string_length) == 0;
+
+		case JSN_TYPE_ARRAY:
+			if (a->array_value->count != b->array_value->count)
+			{ return false; }
+
+			for (size_t i = 0; i < a->array_value->count; ++i)
+			{
+				if (!ValuesEqual(JSN_ArrayGet(a, i), JSN_ArrayGet(b, i)))
+				{ return false; }
+			}
+			return true;
+
+		case JSN_TYPE_OBJECT:
+			if (a->object_value->count != b->object_value->count)
+			{ return false; }
+
+			for (size_t i = 0; i < a->object_value->count; ++i)
+			{
+				const JSN_Property* pa = &a->object_value->properties[i];
+				const JSN_Property* pb = &b->object_value->properties[i];
+
+				if (pa->key_length != pb->key_length || SDL_memcmp(pa->key, pb->key, pa->key_length) != 0 || !ValuesEqual(&pa->value, &pb->value))
+				{ return false; }
+			}
+			return true;
+
+		default:
+			return true;
+	}
+}
+
+
+TEST_CASE("JSON/Reader/Structural Index", "[json]")
+{
+	SDL_IOStream* stream = SDL_IOFromDynamicMem();
+	SDL_WriteIO(stream, "[", 1);
+	for (int i = 0; i < 5000; ++i)
+	{
+		SDL_IOprintf(stream, "{\"id\":%d,\"name\":\"monster %d\",\"quote\":\"say \\\"hi\\\\\\\" \\\\\",", i, i);
+		SDL_IOprintf(stream, " \"stats\" : { \"hp\" : %d.5 , \"tags\":[true,false,null,\"\\u00e9\", []] } },\n", i);
+	}
+	SDL_IOprintf(stream, "\"%0*d\"]", 40000, 7);
+
+	size_t length = (size_t)SDL_GetIOSize(stream);
+	char* json_string = (char*)SDL_malloc(length);
+	SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+	SDL_ReadIO(stream, json_string, length);
+
+	SECTION("Match the scanning reader")
+	{
+		SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+		JSN_Chunk* scanned = JSN_ReadChunkFromIO(stream, false);
+		JSN_Chunk* indexed = JSN_ReadChunkFromMem(json_string, length);
+		REQUIRE(scanned != NULL);
+		REQUIRE(indexed != NULL);
+		REQUIRE(JSN_GetChunkRoot(indexed)->array_value->count == 5001);
+		REQUIRE(ValuesEqual(JSN_GetChunkRoot(scanned), JSN_GetChunkRoot(indexed)));
+		JSN_DestroyChunk(scanned);
+		JSN_DestroyChunk(indexed);
+	}
+
+	SECTION("Reject characters past scalars")
+	{
+		SDL_memset(json_string, ' ', length);
+		SDL_memcpy(json_string + length - 7, "[12abc]", 7);
+		REQUIRE(JSN_ReadChunkFromMem(json_string, length) == NULL);
+	}
+
+	SECTION("Reject control characters in strings")
+	{
+		json_string[length - 100] = '\n';
+		REQUIRE(JSN_ReadChunkFromMem(json_string, length) == NULL);
+	}
+
+	SDL_free(json_string);
+	SDL_CloseIO(stream);
+}
+
+
+TEST_CASE("JSON/Reader/UTF-8", "[json]")
+{
+	SECTION("Accept multilingual text")
+	{
+		const char* json_string = "[\"\xC3\xA9t\xC3\xA9 \xE6\x97\xA5\xE6\x9C\xAC \xF0\x9F\x8E\xAE\", {\"\xCE\xBA\xCE\xBB\xCE\xB5\xCE\xB9\xCE\xB4\xCE\xAF\": \"\\u03c4\\ud83d\\ude00\"}]";
+		JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, SDL_strlen(json_string));
+		REQUIRE(chunk != NULL);
+
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		REQUIRE(SDL_strcmp(JSN_ArrayGet(root, 0)->string_value, "\xC3\xA9t\xC3\xA9 \xE6\x97\xA5\xE6\x9C\xAC \xF0\x9F\x8E\xAE") == 0);
+
+		JSN_Value* value = JSN_ObjectGet(JSN_ArrayGet(root, 1), "\xCE\xBA\xCE\xBB\xCE\xB5\xCE\xB9\xCE\xB4\xCE\xAF", 12);
+		REQUIRE(value != NULL);
+		REQUIRE(SDL_strcmp(value->string_value, "\xCF\x84\xF0\x9F\x98\x80") == 0);
+
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Reject malformed sequences")
+	{
+		const char* const malformed[]
+		{
+			"\x80",					// lone continuation
+			"\xC3",					// truncated two byte sequence
+			"\xE2\x82",				// truncated three byte sequence
+			"\xC0\xAF",				// overlong encoding of '/'
+			"\xE0\x80\xAF",			// overlong three byte encoding
+			"\xF0\x80\x80\xAF",		// overlong four byte encoding
+			"\xED\xA0\x80",			// encoded surrogate
+			"\xF4\x90\x80\x80",		// past U+10FFFF
+			"\xF5\x80\x80\x80",		// invalid lead byte
+			"\xC3\xA9\xA9",			// extra continuation
+		};
+
+		size_t length;
+		char* json_string = BuildMultilingualJSON(8 * 1024, &length);
+
+		for (const char* sequence : malformed)
+		{
+			size_t size = SDL_strlen(sequence);
+
+			// Short input read one character at a time.
+			char short_string[32];
+			SDL_snprintf(short_string, sizeof(short_string), "[\"ab%scd\"]", sequence);
+			CHECK(JSN_ReadChunkFromMem(short_string, SDL_strlen(short_string)) == NULL);
+
+			// Long input read through the structural index, with the sequence at every offset of a 32 byte block.
+			for (size_t offset = 0; offset < 32; ++offset)
+			{
+				char* copy = (char*)SDL_malloc(length);
+				SDL_memcpy(copy, json_string, length);
+
+				char* quote = SDL_strstr(copy + 4096, "The quick");
+				SDL_memcpy(quote + 4 + offset, sequence, size);
+
+				CHECK(JSN_ReadChunkFromMem(copy, length) == NULL);
+				SDL_free(copy);
+			}
+		}
+
+		SDL_free(json_string);
+	}
+
+	SECTION("Reject non-ASCII characters outside of strings")
+	{
+		const char* json_string = "[1, \xC3\xA9]";
+		REQUIRE(JSN_ReadChunkFromMem(json_string, SDL_strlen(json_string)) == NULL);
+	}
+}
+
+
+TEST_CASE("JSON/Reader/Multilingual Throughput", "[json][benchmark]")
+{
+	size_t length;
+	char* json_string = BuildMultilingualJSON(1024 * 1024, &length);
+
+	JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, length);
+	REQUIRE(chunk != NULL);
+	JSN_DestroyChunk(chunk);
+
+	BENCHMARK("Read 1 MiB from memory")
+	{
+		JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, length);
+		JSN_DestroyChunk(chunk);
+		return chunk;
+	};
+
+	BENCHMARK("Read 1 MiB from a stream")
+	{
+		SDL_IOStream* stream = SDL_IOFromConstMem(json_string, length);
+		JSN_Chunk* chunk = JSN_ReadChunkFromIO(stream, true);
+		JSN_DestroyChunk(chunk);
+		return chunk;
+	};
+
+	BENCHMARK("Read 1 MiB in place")
+	{
+		char* copy = (char*)SDL_malloc(length);
+		SDL_memcpy(copy, json_string, length);
+		JSN_Chunk* chunk = JSN_ReadChunkInSitu(copy, length);
+		JSN_DestroyChunk(chunk);
+		SDL_free(copy);
+		return chunk;
+	};
+
+	SDL_free(json_string);
+}
+
+
+/**
+ * @brief Read a single scalar from memory, returning an empty value on failure.
+ */
+static JSN_Value ReadScalar(const char* json_string)
+{
+	JSN_Value value;
+	SDL_zero(value);
+
+	JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, SDL_strlen(json_string));
+
+	if (chunk)
+	{
+		value = *JSN_GetChunkRoot(chunk);
+		JSN_DestroyChunk(chunk);
+	}
+
+	return value;
+}
+
+
+TEST_CASE("JSON/Reader/Read Numbers", "[json]")
+{
+	SECTION("Read integers up to 64 bits")
+	{
+		JSN_Value value = ReadScalar("9223372036854775807");
+		REQUIRE(value.type == JSN_TYPE_INTEGER);
+		REQUIRE(value.integer_value == INT64_MAX);
+
+		value = ReadScalar("-9223372036854775808");
+		REQUIRE(value.type == JSN_TYPE_INTEGER);
+		REQUIRE(value.integer_value == INT64_MIN);
+
+		value = ReadScalar("-0");
+		REQUIRE(value.type == JSN_TYPE_INTEGER);
+		REQUIRE(value.integer_value == 0);
+	}
+
+	SECTION("Promote overflowing integers to numbers")
+	{
+		JSN_Value value = ReadScalar("9223372036854775808");
+		REQUIRE(value.type == JSN_TYPE_NUMBER);
+		REQUIRE(value.number_value == 9223372036854775808.0);
+
+		value = ReadScalar("-123456789012345678901234567890");
+		REQUIRE(value.type == JSN_TYPE_NUMBER);
+		REQUIRE(value.number_value == -123456789012345678901234567890.0);
+	}
+
+	SECTION("Round numbers correctly")
+	{
+		const char* const numbers[]
+		{
+			"0.1", "-1.5", "3.14159265358979", "12e30", "1e23", "8.98846567431158e307",
+			"2.2250738585072011e-308", "2.2250738585072014e-308", "4.9e-324", "1.7976931348623157e308",
+			"0.30000000000000004", "9007199254740993.0", "1.00000000000000011102230246251565404236316680908203125",
+			"7.0710678118654752440084436210484903928483593768847e-1", "123456.789e-3", "0e999999",
+		};
+
+		for (const char* number : numbers)
+		{
+			JSN_Value value = ReadScalar(number);
+			CHECK(value.type == JSN_TYPE_NUMBER);
+			CHECK(value.number_value == SDL_strtod(number, NULL));
+		}
+
+		// Exhaustively compare short decimals with the exact conversion.
+		char number[32];
+		int mismatches = 0;
+
+		for (int i = 0; i < 100000; ++i)
+		{
+			SDL_snprintf(number, sizeof(number), "%d.%03de%d", i * 7919 % 100000, i % 1000, i % 60 - 30);
+			mismatches += ReadScalar(number).number_value != SDL_strtod(number, NULL);
+		}
+
+		REQUIRE(mismatches == 0);
+	}
+
+	SECTION("Saturate numbers out of range")
+	{
+		REQUIRE(ReadScalar("1e400").number_value == SDL_strtod("1e400", NULL));
+		REQUIRE(ReadScalar("-1e400").number_value == SDL_strtod("-1e400", NULL));
+		REQUIRE(ReadScalar("1e-400").number_value == 0.0);
+	}
+
+	SECTION("Reject malformed numbers")
+	{
+		const char* const malformed[]
+		{
+			"01", "-01", "1.", ".5", "-", "1e", "1e+", "+1", "0x10", "1.2.3", "--1", "1e5.0", "[1-2]", "[1x]",
+		};
+
+		for (const char* number : malformed)
+		{ CHECK(ReadScalar(number).type == JSN_TYPE_EMPTY); }
+	}
+}
+
+
+/**
+ * @brief Reader interface recording every event it receives as text.
+ */
+struct EventLog
+{
+	char* text = NULL;
+	size_t size = 0;
+	bool discard = false;
+
+	~EventLog()
+	{ SDL_free(text); }
+
+	void Append(const char* data, size_t length)
+	{
+		if (discard)
+		{ return; }
+
+		text = (char*)SDL_realloc(text, size + length + 1);
+		SDL_memcpy(text + size, data, length);
+		size += length;
+		text[size] = '\0';
+	}
+
+	void Print(const char* format, ...)
+	{
+		char buffer[64];
+		va_list args;
+		va_start(args, format);
+		int length = SDL_vsnprintf(buffer, sizeof(buffer), format, args);
+		va_end(args);
+		Append(buffer, (size_t)length);
+	}
+
+	static bool Key(void* userdata, const char* key, size_t length)
+	{ ((EventLog*)userdata)->Print("K"); ((EventLog*)userdata)->Append(key, length); return true; }
+
+	static bool Value(void* userdata, JSN_Value* value)
+	{
+		EventLog* log = (EventLog*)userdata;
+
+		switch (value->type)
+		{
+			case JSN_TYPE_NULL: log->Print("N "); break;
+			case JSN_TYPE_BOOL: log->Print("B%d ", value->bool_value); break;
+			case JSN_TYPE_INTEGER: log->Print("I%lld ", (long long)value->integer_value); break;
+			case JSN_TYPE_NUMBER: log->Print("D%.17g ", value->number_value); break;
+			case JSN_TYPE_STRING: log->Print("S"); log->Append(value->string_value, value->string_length); log->Print(" "); break;
+			default: break;
+		}
+
+		return true;
+	}
+
+	static bool OpenArray(void* userdata)
+	{ ((EventLog*)userdata)->Print("[ "); return true; }
+
+	static bool CloseArray(void* userdata, size_t length)
+	{ ((EventLog*)userdata)->Print("]%zu ", length); return true; }
+
+	static bool OpenObject(void* userdata)
+	{ ((EventLog*)userdata)->Print("{ "); return true; }
+
+	static bool CloseObject(void* userdata, size_t length)
+	{ ((EventLog*)userdata)->Print("}%zu ", length); return true; }
+
+	static JSN_ReaderInterface Interface()
+	{
+		JSN_ReaderInterface iface;
+		JSN_INIT_READER_INTERFACE(&iface);
+		iface.key = Key;
+		iface.value = Value;
+		iface.open_array = OpenArray;
+		iface.close_array = CloseArray;
+		iface.open_object = OpenObject;
+		iface.close_object = CloseObject;
+		return iface;
+	}
+};
+
+
+TEST_CASE("JSON/Reader/Incremental Parser", "[json]")
+{
+	JSN_ReaderInterface iface = EventLog::Interface();
+
+	const char* json_string =
+		"{\"name\": \"gr\\u00fcn \\ud83d\\ude00 \xE6\x97\xA5\", \"values\": [1, -25, 3.5e-2, true, false, null, 12345678901234567890],"
+		" \"nested\": {\"a\": [[], {}], \"escaped \\\"key\\\"\": \"tab\\there\"}, \"last\": 0}";
+	size_t length = SDL_strlen(json_string);
+
+	EventLog expected;
+	REQUIRE(JSN_ReadMem(json_string, length, &iface, &expected));
+
+	SECTION("Emit the same events for every chunk size")
+	{
+		for (size_t chunk_size = 1; chunk_size <= length; ++chunk_size)
+		{
+			EventLog log;
+			JSN_Parser* parser = JSN_CreateParser(&iface, &log);
+
+			for (size_t offset = 0; offset < length; offset += chunk_size)
+			{ REQUIRE(JSN_Feed(parser, json_string + offset, SDL_min(chunk_size, length - offset))); }
+
+			REQUIRE(JSN_Finish(parser));
+			REQUIRE(SDL_strcmp(log.text, expected.text) == 0);
+			JSN_DestroyParser(parser);
+		}
+	}
+
+	SECTION("Emit events as soon as tokens are complete")
+	{
+		EventLog log;
+		JSN_Parser* parser = JSN_CreateParser(&iface, &log);
+
+		REQUIRE(JSN_Feed(parser, "[tr", 3));
+		REQUIRE(SDL_strcmp(log.text, "[ ") == 0);
+		REQUIRE(JSN_Feed(parser, "ue, 4", 5));
+		REQUIRE(SDL_strcmp(log.text, "[ B1 ") == 0);
+		REQUIRE(JSN_Feed(parser, "2]", 2));
+		REQUIRE(SDL_strcmp(log.text, "[ B1 I42 ]2 ") == 0);
+		REQUIRE(JSN_Finish(parser));
+		JSN_DestroyParser(parser);
+	}
+
+	SECTION("Reject incomplete & malformed input")
+	{
+		const char* const malformed[]
+		{
+			"[1, 2", "{\"a\": \"unterminated", "[\"\\u12", "tru", "[1 2]", "[\"\\x\"]", "[01]",
+		};
+
+		for (const char* input : malformed)
+		{
+			EventLog log;
+			JSN_Parser* parser = JSN_CreateParser(&iface, &log);
+
+			bool success = true;
+			for (const char* c = input; *c && success; ++c)
+			{ success = JSN_Feed(parser, c, 1); }
+
+			CHECK_FALSE((success && JSN_Finish(parser)));
+			JSN_DestroyParser(parser);
+		}
+	}
+
+	SECTION("Bound memory by the longest token")
+	{
+		AllocationCounter counter;
+		EventLog log;
+		log.discard = true;
+
+		JSN_Parser* parser = JSN_CreateParser(&iface, &log);
+		REQUIRE(JSN_Feed(parser, "[", 1));
+
+		// Chunks of 4001 bytes cut through strings & numbers at varying offsets.
+		char pattern[4032];
+		for (size_t j = 0; j < sizeof(pattern); j += 16)
+		{ SDL_memcpy(pattern + j, "  \"value\", 123, ", 16); }
+
+		for (size_t i = 0; i < 1000; ++i)
+		{
+			REQUIRE(JSN_Feed(parser, pattern + i * 4001 % 16, 4001));
+			REQUIRE(counter.Outstanding() <= 4);
+		}
+
+		// Complete the last pattern, then feed a single string longer than the chunks.
+		size_t end = 1000 * 4001 % 16;
+		REQUIRE(JSN_Feed(parser, pattern + end, 16 - end));
+
+		REQUIRE(JSN_Feed(parser, "\"", 1));
+		for (size_t i = 0; i < 1000; ++i)
+		{ REQUIRE(JSN_Feed(parser, pattern + 3, 5)); }
+		REQUIRE(JSN_Feed(parser, "\",", 2));
+
+		REQUIRE(JSN_Feed(parser, "0]", 2));
+		REQUIRE(JSN_Finish(parser));
+		JSN_DestroyParser(parser);
+	}
+}
+
+
+/**
+ * @brief Write a JSON value into a buffer, returning the null-terminated output.
+ */
+/**
+ * @brief Build arrays nested to the given depth, each holding a number & a string needing to be unescaped.
+ */
+static char* BuildNestedJSON(int depth, size_t* length)
+{
+	const char* open = "[1, \"a\\tb\", ";
+	size_t open_length = SDL_strlen(open);
+
+	*length = depth * (open_length + 1) + 1;
+	char* json_string = (char*)SDL_malloc(*length + 1);
+
+	for (int i = 0; i < depth; ++i)
+	{
+		SDL_memcpy(json_string + i * open_length, open, open_length);
+		json_string[depth * open_length + 1 + i] = ']';
+	}
+
+	json_string[depth * open_length] = '0';
+	json_string[*length] = '\0';
+
+	return json_string;
+}
+
+
+TEST_CASE("JSON/Reader/Allocations", "[json]")
+{
+	size_t length;
+	char* json_string = BuildMultilingualJSON(1024 * 1024, &length);
+
+	JSN_ReaderInterface iface = EventLog::Interface();
+	EventLog log;
+	log.discard = true;
+
+	// The first read on this thread allocates the scratch block which later reads reuse.
+	REQUIRE(JSN_ReadMem(json_string, length, &iface, &log));
+
+	SECTION("Events only")
+	{
+		AllocationCounter counter;
+		REQUIRE(JSN_ReadMem(json_string, length, &iface, &log));
+		REQUIRE(counter.Allocations() == 0);
+	}
+
+	SECTION("Events only from a stream")
+	{
+		const char* file = "json_allocations_test.json";
+		SDL_SaveFile(file, json_string, length);
+
+		SDL_IOStream* stream = SDL_IOFromFile(file, "rb");
+		REQUIRE(stream != NULL);
+		{
+			AllocationCounter counter;
+			REQUIRE(JSN_Read(stream, &iface, &log, false));
+			REQUIRE(counter.Allocations() == 0);
+		}
+
+		SDL_CloseIO(stream);
+		SDL_RemovePath(file);
+	}
+
+	SECTION("Deep nesting")
+	{
+		size_t nested_length;
+		char* nested = BuildNestedJSON(JSN_MAX_DEPTH, &nested_length);
+		REQUIRE(JSN_ReadMem(nested, nested_length, &iface, &log));
+
+		{
+			AllocationCounter counter;
+			REQUIRE(JSN_ReadMem(nested, nested_length, &iface, &log));
+			REQUIRE(counter.Allocations() == 0);
+		}
+
+		// Chunks allocate their blocks & a stack of pending values growing by doubling, but nothing per container.
+		{
+			AllocationCounter counter;
+			JSN_Chunk* chunk = JSN_ReadChunkFromMem(nested, nested_length);
+			REQUIRE(chunk != NULL);
+			REQUIRE(counter.Allocations() <= 16);
+			JSN_DestroyChunk(chunk);
+		}
+
+		SDL_free(nested);
+
+		nested = BuildNestedJSON(JSN_MAX_DEPTH + 1, &nested_length);
+		REQUIRE_FALSE(JSN_ReadMem(nested, nested_length, &iface, &log));
+		REQUIRE(SDL_strstr(SDL_GetError(), "nesting") != NULL);
+		REQUIRE(JSN_ReadChunkFromMem(nested, nested_length) == NULL);
+		SDL_free(nested);
+	}
+
+	SECTION("Long tokens")
+	{
+		// Only the longest token copied into scratch memory allocates, and only once.
+		char* escaped = (char*)SDL_malloc(64 * 1024);
+		SDL_memset(escaped, 'x', 64 * 1024);
+		SDL_memcpy(escaped, "[\"\\n", 4);
+		SDL_memcpy(escaped + 32 * 1024, "\", \"\\n", 6);
+		SDL_memcpy(escaped + 64 * 1024 - 2, "\"]", 2);
+
+		AllocationCounter counter;
+		REQUIRE(JSN_ReadMem(escaped, 64 * 1024, &iface, &log));
+		REQUIRE(counter.Allocations() <= 2);
+
+		SDL_free(escaped);
+	}
+
+	SDL_free(json_string);
+}
+
+
+static const char* WriteToBuffer(const JSN_Value* value, bool pretty, char* buffer, size_t size)
+{
+	SDL_IOStream* stream = SDL_IOFromMem(buffer, size - 1);
+	bool success = JSN_Write(stream, value, pretty, false);
+	buffer[success ? (size_t)SDL_TellIO(stream) : 0] = '\0';
+	SDL_CloseIO(stream);
+	return buffer;
+}
+
+
+TEST_CASE("JSON/Writer", "[json]")
+{
+	static char output[1 << 16];
+
+	const char* json_string = "{\"a\":[1,2.5,-0.1,1.0,\"x\\\"y\\n\\u0001\",true,null,{}],\"b\":{\"c\":[]},\"\xC3\xA9\":1e+100}";
+	JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, SDL_strlen(json_string));
+	REQUIRE(chunk != NULL);
+
+	SECTION("Write compactly")
+	{
+		REQUIRE(SDL_strcmp(WriteToBuffer(JSN_GetChunkRoot(chunk), false, output, sizeof(output)), json_string) == 0);
+	}
+
+	SECTION("Write pretty")
+	{
+		const char* expected =
+			"{\n"
+			"\t\"a\": [\n"
+			"\t\t1,\n"
+			"\t\t2.5,\n"
+			"\t\t-0.1,\n"
+			"\t\t1.0,\n"
+			"\t\t\"x\\\"y\\n\\u0001\",\n"
+			"\t\ttrue,\n"
+			"\t\tnull,\n"
+			"\t\t{}\n"
+			"\t],\n"
+			"\t\"b\": {\n"
+			"\t\t\"c\": []\n"
+			"\t},\n"
+			"\t\"\xC3\xA9\": 1e+100\n"
+			"}\n";
+
+		REQUIRE(SDL_strcmp(WriteToBuffer(JSN_GetChunkRoot(chunk), true, output, sizeof(output)), expected) == 0);
+	}
+
+	SECTION("Round-trip doubles exactly")
+	{
+		JSN_Value value;
+		SDL_zero(value);
+		value.type = JSN_TYPE_NUMBER;
+
+		uint64_t bits = 0x9E3779B97F4A7C15;
+		int mismatches = 0;
+
+		for (int i = 0; i < 20000; ++i)
+		{
+			bits ^= bits << 13; bits ^= bits >> 7; bits ^= bits << 17;
+			SDL_memcpy(&value.number_value, &bits, sizeof(double));
+
+			if (value.number_value != value.number_value)
+			{ continue; }
+
+			JSN_Value result = ReadScalar(WriteToBuffer(&value, false, output, sizeof(output)));
+			mismatches += result.type != JSN_TYPE_NUMBER || SDL_memcmp(&result.number_value, &value.number_value, sizeof(double)) != 0;
+		}
+
+		REQUIRE(mismatches == 0);
+
+		value.number_value = 0.1;
+		REQUIRE(SDL_strcmp(WriteToBuffer(&value, false, output, sizeof(output)), "0.1") == 0);
+	}
+
+	SECTION("Round-trip documents")
+	{
+		size_t length;
+		char* multilingual = BuildMultilingualJSON(64 * 1024, &length);
+		JSN_Chunk* source = JSN_ReadChunkFromMem(multilingual, length);
+
+		SDL_IOStream* stream = SDL_IOFromDynamicMem();
+		REQUIRE(JSN_Write(stream, JSN_GetChunkRoot(source), true, false));
+		SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+
+		JSN_Chunk* result = JSN_ReadChunkFromIO(stream, true);
+		REQUIRE(result != NULL);
+		REQUIRE(ValuesEqual(JSN_GetChunkRoot(source), JSN_GetChunkRoot(result)));
+
+		JSN_DestroyChunk(result);
+		JSN_DestroyChunk(source);
+		SDL_free(multilingual);
+	}
+
+	SECTION("Write events")
+	{
+		SDL_IOStream* stream = SDL_IOFromMem(output, sizeof(output));
+		JSN_Writer* writer = JSN_CreateWriter(stream, false, true);
+
+		JSN_Value value;
+		SDL_zero(value);
+		value.type = JSN_TYPE_INTEGER;
+		value.integer_value = 42;
+
+		REQUIRE(JSN_WriteOpenObject(writer));
+		REQUIRE(JSN_WriteKey(writer, "answer", 6));
+		REQUIRE(JSN_WriteValue(writer, &value));
+		REQUIRE(JSN_WriteKey(writer, "chunk", 5));
+		REQUIRE(JSN_WriteValue(writer, JSN_ObjectGet(JSN_GetChunkRoot(chunk), "b", 1)));
+		REQUIRE(JSN_WriteCloseObject(writer));
+		REQUIRE(JSN_FlushWriter(writer));
+		output[SDL_TellIO(stream)] = '\0';
+		REQUIRE(JSN_CloseWriter(writer));
+
+		REQUIRE(SDL_strcmp(output, "{\"answer\":42,\"chunk\":{\"c\":[]}}") == 0);
+	}
+
+	SECTION("Reject malformed events")
+	{
+		JSN_Value value;
+		SDL_zero(value);
+		value.type = JSN_TYPE_NULL;
+
+		JSN_Writer* writer = JSN_CreateWriter(SDL_IOFromMem(output, sizeof(output)), false, true);
+		REQUIRE(JSN_WriteOpenObject(writer));
+		REQUIRE_FALSE(JSN_WriteValue(writer, &value));
+		REQUIRE_FALSE(JSN_CloseWriter(writer));
+
+		writer = JSN_CreateWriter(SDL_IOFromMem(output, sizeof(output)), false, true);
+		REQUIRE(JSN_WriteOpenArray(writer));
+		REQUIRE_FALSE(JSN_WriteKey(writer, "key", 3));
+		REQUIRE_FALSE(JSN_CloseWriter(writer));
+
+		writer = JSN_CreateWriter(SDL_IOFromMem(output, sizeof(output)), false, true);
+		REQUIRE(JSN_WriteOpenArray(writer));
+		REQUIRE_FALSE(JSN_WriteCloseObject(writer));
+		REQUIRE_FALSE(JSN_CloseWriter(writer));
+
+		writer = JSN_CreateWriter(SDL_IOFromMem(output, sizeof(output)), false, true);
+		REQUIRE(JSN_WriteOpenArray(writer));
+		REQUIRE_FALSE(JSN_CloseWriter(writer));
+	}
+
+	SECTION("Reformat while reading")
+	{
+		const char* spaced = " [ 1 , { \"k\" : \"v\" } , [ ] ] ";
+		SDL_IOStream* stream = SDL_IOFromMem(output, sizeof(output));
+		JSN_Writer* writer = JSN_CreateWriter(stream, false, false);
+
+		REQUIRE(JSN_ReadMem(spaced, SDL_strlen(spaced), JSN_GetWriterInterface(), writer));
+		REQUIRE(JSN_CloseWriter(writer));
+		output[SDL_TellIO(stream)] = '\0';
+		SDL_CloseIO(stream);
+
+		REQUIRE(SDL_strcmp(output, "[1,{\"k\":\"v\"},[]]") == 0);
+	}
+
+	SECTION("Reformat empty strings")
+	{
+		// Empty strings read from memory are views of the closing quote, followed by the rest of the input.
+		for (const char* input : { "[\"\"]", "{\"\":\"\"}", "[\"\",\"abc\"]" })
+		{
+			SDL_IOStream* stream = SDL_IOFromMem(output, sizeof(output));
+			JSN_Writer* writer = JSN_CreateWriter(stream, false, false);
+
+			REQUIRE(JSN_ReadMem(input, SDL_strlen(input), JSN_GetWriterInterface(), writer));
+			REQUIRE(JSN_CloseWriter(writer));
+			output[SDL_TellIO(stream)] = '\0';
+			SDL_CloseIO(stream);
+
+			REQUIRE(SDL_strcmp(output, input) == 0);
+		}
+	}
+
+	JSN_DestroyChunk(chunk);
+}
+
+
+TEST_CASE("JSON/Chunk/Binary Image", "[json]")
+{
+	size_t length;
+	char* json_string = BuildMultilingualJSON(256 * 1024, &length);
+	JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, length);
+	REQUIRE(chunk != NULL);
+
+	SDL_IOStream* stream = SDL_IOFromDynamicMem();
+	REQUIRE(JSN_SaveBinary(chunk, stream, false));
+
+	size_t size = (size_t)SDL_GetIOSize(stream);
+	char* image = (char*)SDL_malloc(size);
+	SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+	SDL_ReadIO(stream, image, size);
+	SDL_CloseIO(stream);
+
+	SECTION("Load without parsing")
+	{
+		SDL_IOStream* input = SDL_IOFromConstMem(image, size);
+		AllocationCounter counter;
+		JSN_Chunk* loaded = JSN_LoadBinary(input, false);
+		REQUIRE(counter.Allocations() <= 2);
+		SDL_CloseIO(input);
+
+		REQUIRE(loaded != NULL);
+		REQUIRE(ValuesEqual(JSN_GetChunkRoot(chunk), JSN_GetChunkRoot(loaded)));
+
+		// Loaded chunks remain fully usable.
+		JSN_Value* root = JSN_GetChunkRoot(loaded);
+		JSN_ChunkSetInteger(loaded, JSN_ChunkAddElement(loaded, root, 0, NULL), 7);
+		REQUIRE(JSN_ArrayGet(root, 0)->integer_value == 7);
+		REQUIRE(JSN_ChunkCompact(loaded));
+		REQUIRE(JSN_ArrayGet(JSN_GetChunkRoot(loaded), 0)->integer_value == 7);
+
+		JSN_DestroyChunk(loaded);
+	}
+
+	SECTION("Keep hash indices")
+	{
+		JSN_Chunk* keyed = JSN_CreateChunk();
+		JSN_Value* root = JSN_GetChunkRoot(keyed);
+		JSN_ChunkSetObject(keyed, root);
+
+		char key[32];
+		for (int i = 0; i < 100; ++i)
+		{
+			SDL_snprintf(key, sizeof(key), "key%d", i);
+			JSN_ChunkSetInteger(keyed, JSN_ChunkAddProperty(keyed, root, JSN_APPEND, NULL, key, SDL_strlen(key)), i);
+		}
+
+		SDL_IOStream* io = SDL_IOFromDynamicMem();
+		REQUIRE(JSN_SaveBinary(keyed, io, false));
+		SDL_SeekIO(io, 0, SDL_IO_SEEK_SET);
+		JSN_Chunk* loaded = JSN_LoadBinary(io, true);
+		REQUIRE(loaded != NULL);
+		REQUIRE(JSN_GetChunkRoot(loaded)->object_value->index != NULL);
+
+		for (int i = 0; i < 100; ++i)
+		{
+			SDL_snprintf(key, sizeof(key), "key%d", i);
+			JSN_Value* value = JSN_ObjectGet(JSN_GetChunkRoot(loaded), key, SDL_strlen(key));
+			REQUIRE(value != NULL);
+			REQUIRE(value->integer_value == i);
+		}
+
+		JSN_DestroyChunk(loaded);
+		JSN_DestroyChunk(keyed);
+	}
+
+	SECTION("Reject corrupted images")
+	{
+		REQUIRE(JSN_LoadBinary(SDL_IOFromConstMem(image, size / 2), true) == NULL);
+		REQUIRE(JSN_LoadBinary(SDL_IOFromConstMem(image, 16), true) == NULL);
+
+		image[size / 2] ^= 0x40;
+		REQUIRE(JSN_LoadBinary(SDL_IOFromConstMem(image, size), true) == NULL);
+		image[size / 2] ^= 0x40;
+
+		image[0] = 'X';
+		REQUIRE(JSN_LoadBinary(SDL_IOFromConstMem(image, size), true) == NULL);
+	}
+
+	SECTION("Cache images of files")
+	{
+		const char* file = "json_binary_cache_test.json";
+		const char* cache = "json_binary_cache_test.json.jsnb";
+
+		SDL_IOStream* output = SDL_IOFromFile(file, "wb");
+		SDL_WriteIO(output, json_string, length);
+		SDL_CloseIO(output);
+
+		// Reading files never writes beside them unless saving images is enabled.
+		JSN_Chunk* uncached = JSN_ReadChunkFromFile(file);
+		REQUIRE(uncached != NULL);
+		REQUIRE_FALSE(SDL_GetPathInfo(cache, NULL));
+		JSN_DestroyChunk(uncached);
+
+		JSN_SetBinaryCache(true, NULL);
+		JSN_Chunk* parsed = JSN_ReadChunkFromFile(file);
+		REQUIRE(parsed != NULL);
+		REQUIRE(ValuesEqual(JSN_GetChunkRoot(chunk), JSN_GetChunkRoot(parsed)));
+
+		SDL_IOStream* cached = SDL_IOFromFile(cache, "rb");
+		REQUIRE(cached != NULL);
+		SDL_CloseIO(cached);
+
+		JSN_Chunk* loaded;
+		{
+			// Loading from the image leaves nothing allocated but the chunk & the block holding its image.
+			AllocationCounter counter;
+			loaded = JSN_ReadChunkFromFile(file);
+			REQUIRE(counter.Outstanding() <= 2);
+		}
+
+		REQUIRE(loaded != NULL);
+		REQUIRE(ValuesEqual(JSN_GetChunkRoot(chunk), JSN_GetChunkRoot(loaded)));
+
+		// Changing the source invalidates the image.
+		output = SDL_IOFromFile(file, "wb");
+		SDL_WriteIO(output, "[\"changed\"]", 11);
+		SDL_CloseIO(output);
+
+		JSN_Chunk* changed = JSN_ReadChunkFromFile(file);
+		REQUIRE(changed != NULL);
+		REQUIRE(SDL_strcmp(JSN_ArrayGet(JSN_GetChunkRoot(changed), 0)->string_value, "changed") == 0);
+
+		JSN_DestroyChunk(changed);
+		JSN_DestroyChunk(loaded);
+		JSN_DestroyChunk(parsed);
+		JSN_SetBinaryCache(false, NULL);
+		SDL_RemovePath(cache);
+		SDL_RemovePath(file);
+	}
+
+	SDL_free(image);
+	JSN_DestroyChunk(chunk);
+	SDL_free(json_string);
+}
+
+
+static const char* const query_json = R"({
+	"name": "bestiary",
+	"monsters": [
+		{ "name": "slime", "stats": { "hp": 10, "speed": 0.5 }, "tags": ["goo"] },
+		{ "name": "bat", "stats": { "hp": 4, "speed": 3 }, "tags": [] },
+		{ "name": "golem", "stats": { "hp": 120 }, "tags": ["rock", "boss"] },
+		{ "name": "ghost", "stats": null }
+	],
+	"a/b": { "~": "escaped" },
+	"7": "seven"
+})";
+
+
+/**
+ * @brief Write the matches of a query against a chunk, and those read from a stream, as compact JSON arrays.
+ */
+static void RunQuery(const char* path, char* from_chunk, char* from_stream, size_t size)
+{
+	JSN_Query* query = JSN_CompileQuery(path);
+	REQUIRE(query != NULL);
+
+	JSN_Chunk* chunk = JSN_ReadChunkFromMem(query_json, SDL_strlen(query_json));
+	REQUIRE(chunk != NULL);
+
+	SDL_IOStream* stream = SDL_IOFromMem(from_chunk, size - 1);
+	JSN_Writer* writer = JSN_CreateWriter(stream, false, false);
+	REQUIRE(JSN_WriteOpenArray(writer));
+
+	auto write_match = [](void* userdata, JSN_Value* value) { return JSN_WriteValue((JSN_Writer*)userdata, value); };
+	JSN_QueryValue(query, JSN_GetChunkRoot(chunk), write_match, writer);
+
+	REQUIRE(JSN_WriteCloseArray(writer));
+	REQUIRE(JSN_CloseWriter(writer));
+	from_chunk[SDL_TellIO(stream)] = '\0';
+	SDL_CloseIO(stream);
+
+	JSN_Chunk* matches = JSN_ReadQueryFromIO(SDL_IOFromConstMem(query_json, SDL_strlen(query_json)), query, true);
+	REQUIRE(matches != NULL);
+	WriteToBuffer(JSN_GetChunkRoot(matches), false, from_stream, size);
+
+	JSN_DestroyChunk(matches);
+	JSN_DestroyChunk(chunk);
+	JSN_DestroyQuery(query);
+}
+
+
+TEST_CASE("JSON/Query", "[json]")
+{
+	char from_chunk[512];
+	char from_stream[512];
+
+	SECTION("Compile paths")
+	{
+		const char* invalid_paths[] = { "a..b", ".a", "a.", "a[", "a[]", "a[0]b", "/a~2", "/a~" };
+
+		for (const char* path : invalid_paths)
+		{
+			INFO(path);
+			REQUIRE(JSN_CompileQuery(path) == NULL);
+		}
+	}
+
+	SECTION("Match keys, indices & wildcards")
+	{
+		struct { const char* path; const char* expected; } cases[] = {
+			{ "", nullptr },
+			{ "/name", R"(["bestiary"])" },
+			{ "name", R"(["bestiary"])" },
+			{ "/monsters/*/stats/hp", "[10,4,120]" },
+			{ "monsters[*].stats.hp", "[10,4,120]" },
+			{ "monsters.*.name", R"(["slime","bat","golem","ghost"])" },
+			{ "/monsters/2/tags/1", R"(["boss"])" },
+			{ "monsters[1].stats", R"([{"hp":4,"speed":3}])" },
+			{ "/monsters/*/tags/*", R"(["goo","rock","boss"])" },
+			{ "/monsters/*/stats", R"([{"hp":10,"speed":0.5},{"hp":4,"speed":3},{"hp":120},null])" },
+			{ "/a~1b/~0", R"(["escaped"])" },
+			{ "/7", R"(["seven"])" },
+			{ "/*/0/name", R"(["slime"])" },
+			{ "/monsters/4", "[]" },
+			{ "/monsters/01", "[]" },
+			{ "/name/0", "[]" },
+			{ "/missing/*", "[]" },
+		};
+
+		for (const auto& c : cases)
+		{
+			INFO(c.path);
+			RunQuery(c.path, from_chunk, from_stream, sizeof(from_chunk));
+			REQUIRE(SDL_strcmp(from_chunk, from_stream) == 0);
+
+			if (c.expected)
+			{ REQUIRE(SDL_strcmp(from_stream, c.expected) == 0); }
+		}
+
+		// The empty query matches the whole document.
+		RunQuery("", from_chunk, from_stream, sizeof(from_chunk));
+		REQUIRE(SDL_strncmp(from_stream, R"([{"name":"bestiary","monsters":[)", 31) == 0);
+	}
+
+	SECTION("Stop & find first")
+	{
+		JSN_Query* query = JSN_CompileQuery("/monsters/*/name");
+		JSN_Chunk* chunk = JSN_ReadChunkFromMem(query_json, SDL_strlen(query_json));
+
+		REQUIRE(JSN_QueryValue(query, JSN_GetChunkRoot(chunk), NULL, NULL) == 4);
+
+		auto stop_at_bat = [](void*, JSN_Value* value) { return SDL_strcmp(value->string_value, "bat") != 0; };
+		REQUIRE(JSN_QueryValue(query, JSN_GetChunkRoot(chunk), stop_at_bat, NULL) == 2);
+
+		JSN_Value* first = JSN_QueryFirst(query, JSN_GetChunkRoot(chunk));
+		REQUIRE(first != NULL);
+		REQUIRE(SDL_strcmp(first->string_value, "slime") == 0);
+
+		JSN_DestroyChunk(chunk);
+		JSN_DestroyQuery(query);
+	}
+
+	SECTION("Filter skips non-matching subtrees")
+	{
+		JSN_Query* query = JSN_CompileQuery("/monsters/*/stats");
+		JSN_ReaderInterface iface = EventLog::Interface();
+		EventLog log;
+
+		JSN_QueryFilter* filter = JSN_CreateQueryFilter(query, &iface, &log);
+		REQUIRE(filter != NULL);
+		REQUIRE(JSN_ReadMem(query_json, SDL_strlen(query_json), JSN_GetQueryFilterInterface(), filter));
+		REQUIRE(SDL_strcmp(log.text, "{ KhpI10 KspeedD0.5 }2 { KhpI4 KspeedI3 }2 { KhpI120 }1 N ") == 0);
+
+		JSN_DestroyQueryFilter(filter);
+		JSN_DestroyQuery(query);
+	}
+}
+
+
+TEST_CASE("JSON/Lua", "[json]")
+{
+	lua_State* lua = luaL_newstate();
+	REQUIRE(lua != NULL);
+
+	SECTION("Build tables")
+	{
+		const char* json_string = R"({ "name": "slime", "stats": { "hp": 10, "speed": 0.5 }, "tags": ["goo", null, true], "name": "dup" })";
+		REQUIRE(lua_pushjson(lua, json_string, SDL_strlen(json_string)));
+		REQUIRE(lua_gettop(lua) == 1);
+		REQUIRE(lua_type(lua, 1) == LUA_TTABLE);
+
+		// The first of duplicate keys wins, like with chunks.
+		REQUIRE(lua_getfield(lua, 1, "name") == LUA_TSTRING);
+		REQUIRE(SDL_strcmp(lua_tostring(lua, -1), "slime") == 0);
+
+		REQUIRE(lua_getfield(lua, 1, "stats") == LUA_TTABLE);
+		REQUIRE(lua_getfield(lua, -1, "hp") == LUA_TNUMBER);
+		REQUIRE(lua_isinteger(lua, -1));
+		REQUIRE(lua_tointeger(lua, -1) == 10);
+		REQUIRE(lua_getfield(lua, -2, "speed") == LUA_TNUMBER);
+		REQUIRE(lua_tonumber(lua, -1) == 0.5);
+
+		REQUIRE(lua_getfield(lua, 1, "tags") == LUA_TTABLE);
+		REQUIRE(luaL_len(lua, -1) == 3);
+		REQUIRE(lua_geti(lua, -1, 2) == LUA_TLIGHTUSERDATA);
+		REQUIRE(lua_touserdata(lua, -1) == NULL);
+		REQUIRE(lua_geti(lua, -2, 3) == LUA_TBOOLEAN);
+	}
+
+	SECTION("Empty & invalid input")
+	{
+		REQUIRE(lua_pushjson(lua, "  ", 2));
+		REQUIRE(lua_isnil(lua, -1));
+
+		lua_settop(lua, 0);
+		REQUIRE_FALSE(lua_pushjson(lua, "[1,", 3));
+		REQUIRE(lua_gettop(lua) == 0);
+	}
+
+	SECTION("Build containers larger than the Lua stack")
+	{
+		// More elements & properties than the Lua stack can hold at once, the first of duplicate keys still winning.
+		std::string json_string = "[";
+		for (int i = 0; i < 1200000; ++i)
+		{ json_string += "1,"; }
+
+		json_string += "{";
+		for (int i = 0; i < 600000; ++i)
+		{ json_string += "\"k" + std::to_string(i) + "\":" + std::to_string(i) + ","; }
+		json_string += "\"k0\":-1}]";
+
+		REQUIRE(lua_pushjson(lua, json_string.data(), json_string.size()));
+		REQUIRE(lua_gettop(lua) == 1);
+		REQUIRE(luaL_len(lua, 1) == 1200001);
+		REQUIRE(lua_geti(lua, 1, 1200000) == LUA_TNUMBER);
+		REQUIRE(lua_geti(lua, 1, 1200001) == LUA_TTABLE);
+		REQUIRE(lua_getfield(lua, -1, "k0") == LUA_TNUMBER);
+		REQUIRE(lua_tointeger(lua, -1) == 0);
+		REQUIRE(lua_getfield(lua, -2, "k599999") == LUA_TNUMBER);
+		REQUIRE(lua_tointeger(lua, -1) == 599999);
+	}
+
+	SECTION("Free the reader when Lua raises an error")
+	{
+		// Once armed, the allocator fails after a given number of allocations.
+		int remaining = -1;
+		lua_State* limited = lua_newstate([](void* ud, void* ptr, size_t osize, size_t nsize) -> void*
+		{
+			int& remaining = *(int*)ud;
+
+			if (nsize == 0)
+			{ std::free(ptr); return nullptr; }
+
+			if (remaining == 0 && (ptr == nullptr || nsize > osize))
+			{ return nullptr; }
+
+			if (remaining > 0)
+			{ --remaining; }
+
+			return std::realloc(ptr, nsize);
+		}, &remaining);
+		REQUIRE(limited != nullptr);
+
+		// A long escaped string makes the reader allocate a token buffer, before many short strings exhaust the allocator.
+		std::string json_string = "[\"\\n" + std::string(64 * 1024, 'x') + "\"";
+		for (int i = 0; i < 10000; ++i)
+		{ json_string += ",\"s" + std::to_string(i) + "\""; }
+		json_string += "]";
+
+		auto push = [](lua_State* lua)
+		{
+			lua_pushjson(lua, lua_touserdata(lua, 1), (size_t)lua_tointeger(lua, 2));
+			return 1;
+		};
+
+		// The first read on this thread allocates the scratch block which later reads reuse.
+		lua_pushcfunction(limited, push);
+		lua_pushlightuserdata(limited, json_string.data());
+		lua_pushinteger(limited, (lua_Integer)json_string.size());
+		REQUIRE(lua_pcall(limited, 2, 1, 0) == LUA_OK);
+		lua_settop(limited, 0);
+
+		{
+			AllocationCounter counter;
+			remaining = 1000;
+
+			lua_pushcfunction(limited, push);
+			lua_pushlightuserdata(limited, json_string.data());
+			lua_pushinteger(limited, (lua_Integer)json_string.size());
+			REQUIRE(lua_pcall(limited, 2, 1, 0) == LUA_ERRMEM);
+			REQUIRE(counter.Outstanding() == 0);
+		}
+
+		// Files loaded by json.load are freed before the error is raised again.
+		remaining = -1;
+		const char* path = "json_load_test.json";
+		REQUIRE(SDL_SaveFile(path, json_string.data(), json_string.size()));
+		lua_settop(limited, 0);
+		luaopen_json(limited);
+		lua_getfield(limited, -1, "load");
+		lua_pushstring(limited, path);
+
+		{
+			AllocationCounter counter;
+			remaining = 1000;
+
+			REQUIRE(lua_pcall(limited, 1, 1, 0) == LUA_ERRMEM);
+			REQUIRE(counter.Outstanding() == 0);
+		}
+
+		SDL_RemovePath(path);
+		remaining = -1;
+		lua_close(limited);
+	}
+
+	lua_close(lua);
+}
+
+
+TEST_CASE("JSON/Chunk/Read Files", "[json]")
+{
+	constexpr int count = 40;
+	char** files = WriteBatchFiles(".", count, 100);
+	JSN_Chunk* chunks[count];
+	char* errors[count];
+
+	SECTION("Keep order")
+	{
+		REQUIRE(JSN_ReadChunksFromFiles(files, count, chunks, errors));
+
+		for (int i = 0; i < count; ++i)
+		{
+			REQUIRE(chunks[i] != NULL);
+			REQUIRE(errors[i] == NULL);
+
+			JSN_Value* index = JSN_ObjectGet(JSN_GetChunkRoot(chunks[i]), "index", 5);
+			REQUIRE(index != NULL);
+			REQUIRE(index->integer_value == i);
+
+			JSN_DestroyChunk(chunks[i]);
+		}
+	}
+
+	SECTION("Capture errors of each file")
+	{
+		SDL_IOStream* stream = SDL_IOFromFile(files[7], "wb");
+		SDL_IOprintf(stream, R"({ "index": )");
+		SDL_CloseIO(stream);
+		SDL_RemovePath(files[13]);
+
+		REQUIRE_FALSE(JSN_ReadChunksFromFiles(files, count, chunks, errors));
+		REQUIRE(SDL_strstr(SDL_GetError(), "2 of 40") != NULL);
+		REQUIRE(SDL_strstr(SDL_GetError(), files[7]) != NULL);
+
+		for (int i = 0; i < count; ++i)
+		{
+			bool failed = i == 7 || i == 13;
+			REQUIRE((chunks[i] == NULL) == failed);
+			REQUIRE((errors[i] != NULL) == failed);
+
+			if (chunks[i])
+			{ JSN_DestroyChunk(chunks[i]); }
+		}
+
+		REQUIRE(SDL_strstr(errors[7], "JSON") != NULL);
+
+		for (int i = 0; i < count; ++i)
+		{ SDL_free(errors[i]); }
+
+		// Errors are optional, but still reported.
+		REQUIRE_FALSE(JSN_ReadChunksFromFiles(files, count, chunks, NULL));
+		REQUIRE(SDL_strstr(SDL_GetError(), "2 of 40") != NULL);
+
+		for (int i = 0; i < count; ++i)
+		{
+			if (chunks[i])
+			{ JSN_DestroyChunk(chunks[i]); }
+		}
+	}
+
+	FreeBatchFiles(files, count);
+}
+
+
+TEST_CASE("JSON/Chunk/Lazy", "[json]")
+{
+	size_t length = SDL_strlen(query_json);
+	JSN_Chunk* full = JSN_ReadChunkFromMem(query_json, length);
+	REQUIRE(full != NULL);
+
+	SECTION("Read on access")
+	{
+		JSN_Chunk* chunk = JSN_ReadLazyChunkFromIO(SDL_IOFromConstMem(query_json, length), true);
+		REQUIRE(chunk != NULL);
+
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		REQUIRE(root->type == JSN_TYPE_OBJECT);
+		REQUIRE(root->object_value->lazy == NULL);
+
+		JSN_Value* monsters = JSN_ObjectGet(root, "monsters", 8);
+		REQUIRE(monsters->type == JSN_TYPE_ARRAY);
+		REQUIRE(monsters->array_value->lazy != NULL);
+
+		JSN_Value* golem = JSN_ArrayGet(monsters, 2);
+		REQUIRE(monsters->array_value->lazy == NULL);
+		REQUIRE(monsters->array_value->count == 4);
+		REQUIRE(golem->object_value->lazy != NULL);
+		REQUIRE(JSN_ObjectGet(JSN_ObjectGet(golem, "stats", 5), "hp", 2)->integer_value == 120);
+
+		// Untouched siblings stay unread, while empty containers are read right away.
+		REQUIRE(JSN_ArrayGet(monsters, 0)->object_value->lazy != NULL);
+		REQUIRE(JSN_ObjectGet(root, "a/b", 3)->object_value->lazy != NULL);
+		REQUIRE(JSN_ObjectGet(JSN_ArrayGet(monsters, 1), "tags", 4)->array_value->lazy == NULL);
+
+		REQUIRE(JSN_LoadValue(root, true));
+		REQUIRE(ValuesEqual(root, JSN_GetChunkRoot(full)));
+
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Read from files")
+	{
+		const char* file = "json_lazy_test.json";
+		REQUIRE(SDL_SaveFile(file, query_json, length));
+
+		JSN_Chunk* chunk = JSN_ReadLazyChunkFromFile(file);
+		REQUIRE(chunk != NULL);
+
+		char from_lazy[512];
+		char from_full[512];
+		REQUIRE(SDL_strcmp(WriteToBuffer(JSN_GetChunkRoot(chunk), false, from_lazy, sizeof(from_lazy)), WriteToBuffer(JSN_GetChunkRoot(full), false, from_full, sizeof(from_full))) == 0);
+
+		JSN_DestroyChunk(chunk);
+		SDL_RemovePath(file);
+	}
+
+	SECTION("Use as a regular chunk")
+	{
+		JSN_Chunk* chunk = JSN_ReadLazyChunkFromIO(SDL_IOFromConstMem(query_json, length), true);
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+
+		JSN_Query* query = JSN_CompileQuery("monsters[*].stats.hp");
+		REQUIRE(JSN_QueryValue(query, root, NULL, NULL) == 3);
+		JSN_DestroyQuery(query);
+
+		JSN_Value* tags = JSN_ObjectGet(JSN_ObjectGet(root, "monsters", 8)->array_value->values, "tags", 4);
+		JSN_ChunkSetString(chunk, JSN_ChunkAddElement(chunk, tags, JSN_APPEND, NULL), "sticky", 6);
+		REQUIRE(JSN_ArrayGet(tags, 1)->string_value == std::string_view("sticky"));
+
+		JSN_Chunk* copy = JSN_CreateChunk();
+		REQUIRE(JSN_ChunkCopy(copy, JSN_GetChunkRoot(copy), JSN_ObjectGet(root, "a/b", 3)));
+		REQUIRE(JSN_ObjectGet(JSN_GetChunkRoot(copy), "~", 1)->string_length == 7);
+		JSN_DestroyChunk(copy);
+
+		SDL_IOStream* stream = SDL_IOFromDynamicMem();
+		REQUIRE(JSN_SaveBinary(chunk, stream, false));
+		SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+		JSN_Chunk* loaded = JSN_LoadBinary(stream, true);
+		REQUIRE(loaded != NULL);
+		REQUIRE(ValuesEqual(root, JSN_GetChunkRoot(loaded)));
+
+		JSN_DestroyChunk(loaded);
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Errors")
+	{
+		// The whole input is checked up front.
+		const char* invalid = R"({ "a": [1, 2 }, "b": {} })";
+		REQUIRE(JSN_ReadLazyChunkFromIO(SDL_IOFromConstMem(invalid, SDL_strlen(invalid)), true) == NULL);
+
+		// Containers whose source can't be read back are reported on access, and may be read again later.
+		char source[] = R"({ "a": [1, 2], "b": { "c": 3 } })";
+		JSN_Chunk* chunk = JSN_ReadLazyChunkFromIO(SDL_IOFromConstMem(source, sizeof(source) - 1), true);
+		REQUIRE(chunk != NULL);
+
+		JSN_Value* a = JSN_ObjectGet(JSN_GetChunkRoot(chunk), "a", 1);
+		*SDL_strchr(source, ']') = '}';
+		REQUIRE(JSN_ArrayGet(a, 0) == NULL);
+		REQUIRE_FALSE(JSN_LoadValue(a, false));
+
+		*SDL_strchr(source, '}') = ']';
+		REQUIRE(JSN_ArrayGet(a, 1)->integer_value == 2);
+		REQUIRE(JSN_ObjectGet(JSN_ObjectGet(JSN_GetChunkRoot(chunk), "b", 1), "c", 1)->integer_value == 3);
+
+		JSN_DestroyChunk(chunk);
+	}
+
+	JSN_DestroyChunk(full);
+}
+
+
+TEST_CASE("JSON/Chunk/Share", "[json]")
+{
+	JSN_Chunk* templates = JSN_ReadChunkFromMem(query_json, SDL_strlen(query_json));
+	REQUIRE(templates != NULL);
+
+	JSN_Value* golem = JSN_ArrayGet(JSN_ObjectGet(JSN_GetChunkRoot(templates), "monsters", 8), 2);
+	JSN_Value* golem_stats = JSN_ObjectGet(golem, "stats", 5);
+	const char* golem_name = JSN_ObjectGet(golem, "name", 4)->string_value;
+
+	JSN_Chunk* expected = JSN_CreateChunk();
+	REQUIRE(JSN_ChunkCopy(expected, JSN_GetChunkRoot(expected), golem));
+
+	SECTION("Copy everything")
+	{
+		JSN_Chunk* chunk = JSN_CreateChunk();
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		REQUIRE(JSN_ChunkCopy(chunk, root, golem));
+
+		REQUIRE(root->object_value->lazy == NULL);
+		REQUIRE(root->object_value->chunk == chunk);
+		REQUIRE(JSN_ObjectGet(root, "name", 4)->string_value != golem_name);
+		REQUIRE(ValuesEqual(root, golem));
+
+		// Values may be copied into one of their own descendants.
+		REQUIRE(JSN_ChunkCopy(chunk, JSN_ObjectGet(root, "stats", 5), root));
+		REQUIRE(ValuesEqual(JSN_ObjectGet(root, "stats", 5), golem));
+
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Share values until accessed")
+	{
+		JSN_Chunk* chunk = JSN_CreateChunk();
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		JSN_ChunkSetArray(chunk, root);
+
+		for (int i = 0; i < 100; ++i)
+		{ REQUIRE(JSN_ChunkShare(chunk, JSN_ChunkAddElement(chunk, root, JSN_APPEND, NULL), golem)); }
+
+		// Copies only get their own children once accessed, strings & keys staying shared.
+		JSN_Value* spawned = JSN_ArrayGet(root, 42);
+		REQUIRE(spawned->object_value->lazy != NULL);
+		REQUIRE(JSN_ObjectGet(spawned, "name", 4)->string_value == golem_name);
+		REQUIRE(spawned->object_value->lazy == NULL);
+		REQUIRE(JSN_ObjectGet(spawned, "stats", 5)->object_value->lazy != NULL);
+		REQUIRE(JSN_ArrayGet(root, 41)->object_value->lazy != NULL);
+
+		for (int i = 0; i < 100; ++i)
+		{ REQUIRE(ValuesEqual(JSN_ArrayGet(root, i), JSN_GetChunkRoot(expected))); }
+
+		// The source is only ever read, so pointers into it remain valid.
+		REQUIRE(golem->object_value->lazy == NULL);
+		REQUIRE(JSN_ObjectGet(golem, "stats", 5) == golem_stats);
+		REQUIRE(golem_stats->object_value->lazy == NULL);
+
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Modify either side")
+	{
+		JSN_Chunk* chunk = JSN_CreateChunk();
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		REQUIRE(JSN_ChunkShare(chunk, root, golem));
+
+		// Containers shared with a copy are copied for the source before it modifies them, even if the copy wasn't accessed yet.
+		JSN_ChunkSetInteger(templates, JSN_ObjectGet(JSN_ObjectGet(golem, "stats", 5), "hp", 2), 999);
+		JSN_ChunkSetString(templates, JSN_ChunkAddElement(templates, JSN_ObjectGet(golem, "tags", 4), JSN_APPEND, NULL), "titan", 5);
+		REQUIRE(root->object_value->lazy != NULL);
+		REQUIRE(JSN_ObjectGet(JSN_ObjectGet(golem, "stats", 5), "hp", 2)->integer_value == 999);
+		REQUIRE(ValuesEqual(root, JSN_GetChunkRoot(expected)));
+
+		JSN_ChunkSetInteger(chunk, JSN_ObjectGet(JSN_ObjectGet(root, "stats", 5), "hp", 2), 1);
+		JSN_ChunkSetString(chunk, JSN_ChunkAddElement(chunk, JSN_ObjectGet(root, "tags", 4), JSN_APPEND, NULL), "cracked", 7);
+		REQUIRE(JSN_ObjectGet(JSN_ObjectGet(golem, "stats", 5), "hp", 2)->integer_value == 999);
+		REQUIRE(JSN_ArrayGet(JSN_ObjectGet(golem, "tags", 4), 2)->string_value == std::string_view("titan"));
+
+		// Containers of the copy which were accessed no longer depend on the source.
+		JSN_ChunkSetString(templates, JSN_ObjectGet(golem, "name", 4), "titan", 5);
+		JSN_ChunkSetNull(templates, JSN_ArrayGet(JSN_ObjectGet(golem, "tags", 4), 0));
+		REQUIRE(JSN_ObjectGet(root, "name", 4)->string_value == golem_name);
+		REQUIRE(JSN_ArrayGet(JSN_ObjectGet(root, "tags", 4), 0)->type == JSN_TYPE_STRING);
+		REQUIRE(JSN_ArrayGet(JSN_ObjectGet(root, "tags", 4), 2)->string_value == std::string_view("cracked"));
+		REQUIRE(JSN_ObjectGet(JSN_ObjectGet(root, "stats", 5), "hp", 2)->integer_value == 1);
+		JSN_DestroyChunk(chunk);
+
+		// Values no longer shared are modified in place again.
+		JSN_Value* hp = JSN_ObjectGet(JSN_ObjectGet(golem, "stats", 5), "hp", 2);
+		JSN_ChunkSetInteger(templates, hp, 5);
+		REQUIRE(JSN_ObjectGet(JSN_ObjectGet(golem, "stats", 5), "hp", 2) == hp);
+	}
+
+	SECTION("Patch shared values")
+	{
+		JSN_Chunk* chunk = JSN_CreateChunk();
+		REQUIRE(JSN_ChunkShare(chunk, JSN_GetChunkRoot(chunk), golem));
+
+		JSN_Chunk* target = JSN_CreateChunk();
+		JSN_Value* target_root = JSN_GetChunkRoot(target);
+		REQUIRE(JSN_ChunkCopy(target, target_root, golem));
+		JSN_ChunkSetInteger(target, JSN_ObjectGet(JSN_ObjectGet(target_root, "stats", 5), "hp", 2), 999);
+		JSN_ChunkSetNull(target, JSN_ObjectGet(target_root, "tags", 4));
+
+		// Patching the source, as reloading it does, leaves the copy as it was when shared.
+		REQUIRE(JSN_ChunkPatch(templates, golem, target_root, NULL, NULL));
+		REQUIRE(ValuesEqual(golem, target_root));
+		REQUIRE(ValuesEqual(JSN_GetChunkRoot(chunk), JSN_GetChunkRoot(expected)));
+
+		JSN_DestroyChunk(target);
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Share shared values")
+	{
+		JSN_Chunk* first = JSN_CreateChunk();
+		JSN_Chunk* second = JSN_CreateChunk();
+		REQUIRE(JSN_ChunkShare(first, JSN_GetChunkRoot(first), golem));
+		REQUIRE(JSN_ChunkShare(second, JSN_GetChunkRoot(second), JSN_GetChunkRoot(first)));
+
+		// Copies of copies which haven't been accessed share the template directly, so that the first copy can be modified.
+		REQUIRE(JSN_GetChunkRoot(first)->object_value->lazy != NULL);
+		REQUIRE(JSN_GetChunkRoot(second)->object_value->lazy != NULL);
+
+		JSN_ChunkSetInteger(first, JSN_ObjectGet(JSN_ObjectGet(JSN_GetChunkRoot(first), "stats", 5), "hp", 2), 1);
+		REQUIRE(ValuesEqual(JSN_GetChunkRoot(second), JSN_GetChunkRoot(expected)));
+
+		JSN_DestroyChunk(first);
+		JSN_DestroyChunk(second);
+	}
+
+	SECTION("Copy instead of sharing")
+	{
+		// Values of the same chunk are copied, even into their own descendants.
+		REQUIRE(JSN_ChunkShare(templates, golem_stats, golem));
+		REQUIRE(golem_stats->object_value->lazy == NULL);
+		REQUIRE(ValuesEqual(golem_stats, JSN_GetChunkRoot(expected)));
+
+		// Chunks whose values are shared copy values from the chunks sharing them, rather than keeping each other alive.
+		AllocationCounter counter;
+		JSN_Chunk* first = JSN_ReadChunkFromMem(query_json, SDL_strlen(query_json));
+		JSN_Chunk* second = JSN_CreateChunk();
+
+		REQUIRE(JSN_ChunkShare(second, JSN_GetChunkRoot(second), JSN_GetChunkRoot(first)));
+		REQUIRE(JSN_ObjectGet(JSN_GetChunkRoot(second), "7", 1) != NULL);
+		REQUIRE(JSN_ChunkShare(first, JSN_ObjectGet(JSN_GetChunkRoot(first), "7", 1), JSN_GetChunkRoot(second)));
+		REQUIRE(JSN_ObjectGet(JSN_GetChunkRoot(first), "7", 1)->object_value->lazy == NULL);
+
+		JSN_DestroyChunk(first);
+		JSN_DestroyChunk(second);
+		REQUIRE(counter.Outstanding() == 0);
+	}
+
+	SECTION("Outlive the source")
+	{
+		JSN_Chunk* chunk = JSN_CreateChunk();
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		REQUIRE(JSN_ChunkShare(chunk, root, golem));
+		REQUIRE(JSN_ObjectGet(root, "stats", 5) != NULL);
+
+		JSN_DestroyChunk(templates);
+		templates = NULL;
+		REQUIRE(ValuesEqual(root, JSN_GetChunkRoot(expected)));
+
+		// Compacting copies leaves nothing shared with the source.
+		JSN_Chunk* compacted = JSN_CreateChunk();
+		REQUIRE(JSN_ChunkShare(compacted, JSN_GetChunkRoot(compacted), root));
+		REQUIRE(JSN_ChunkCompact(compacted));
+		JSN_DestroyChunk(chunk);
+
+		REQUIRE(ValuesEqual(JSN_GetChunkRoot(compacted), JSN_GetChunkRoot(expected)));
+		JSN_DestroyChunk(compacted);
+	}
+
+	SECTION("Compact shared chunks")
+	{
+		JSN_Chunk* chunk = JSN_CreateChunk();
+		REQUIRE(JSN_ChunkShare(chunk, JSN_GetChunkRoot(chunk), golem));
+
+		// The template keeps the values shared with the copy, which can still read them afterwards.
+		REQUIRE(JSN_ChunkCompact(templates));
+		REQUIRE(ValuesEqual(JSN_GetChunkRoot(chunk), JSN_GetChunkRoot(expected)));
+
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Release values once unshared")
+	{
+		AllocationCounter counter;
+
+		for (bool source_first : { false, true })
+		{
+			JSN_Chunk* source = JSN_ReadChunkFromMem(query_json, SDL_strlen(query_json));
+			JSN_Chunk* chunk = JSN_CreateChunk();
+			REQUIRE(JSN_ChunkShare(chunk, JSN_GetChunkRoot(chunk), JSN_GetChunkRoot(source)));
+
+			JSN_DestroyChunk(source_first ? source : chunk);
+			REQUIRE(counter.Outstanding() > 0);
+			JSN_DestroyChunk(source_first ? chunk : source);
+			REQUIRE(counter.Outstanding() == 0);
+		}
+	}
+
+	if (templates)
+	{ JSN_DestroyChunk(templates); }
+
+	JSN_DestroyChunk(expected);
+}
+
+
+/**
+ * @brief Changes gathered by a JSN_ChangeCallback, by path.
+ */
+struct ChangeLog
+{
+	std::map<std::string, JSN_Change> changes;
+	int calls = 0;
+
+	static void Record(void* userdata, const JSN_Change* changes, size_t count)
+	{
+		ChangeLog* log = (ChangeLog*)userdata;
+		log->calls++;
+
+		for (size_t i = 0; i < count; ++i)
+		{ log->changes[changes[i].path] = changes[i]; }
+	}
+};
+
+
+static const char* const patched_json = R"({
+	"monsters": [
+		{ "name": "imp" },
+		{ "name": "slime", "stats": { "hp": 10, "speed": 0.5 }, "tags": ["goo"] },
+		{ "name": "bat", "stats": { "hp": 4, "speed": 3 }, "tags": [] },
+		{ "name": "golem", "stats": { "hp": 150 }, "tags": ["rock", "boss"] },
+		{ "name": "ghost", "stats": null }
+	],
+	"a/b": { "~": "escaped", "new": true },
+	"7": "seven",
+	"version": 2
+})";
+
+
+TEST_CASE("JSON/Chunk/Patch", "[json]")
+{
+	JSN_Chunk* chunk = JSN_ReadChunkFromMem(query_json, SDL_strlen(query_json));
+	JSN_Chunk* target = JSN_ReadChunkFromMem(patched_json, SDL_strlen(patched_json));
+	REQUIRE(chunk != NULL);
+	REQUIRE(target != NULL);
+
+	JSN_Value* root = JSN_GetChunkRoot(chunk);
+
+	SECTION("Report minimal changes")
+	{
+		JSN_Object* escaped = JSN_ObjectGet(root, "a/b", 3)->object_value;
+		JSN_Object* golem_stats = JSN_ObjectGet(JSN_ArrayGet(JSN_ObjectGet(root, "monsters", 8), 2), "stats", 5)->object_value;
+
+		ChangeLog log;
+		REQUIRE(JSN_ChunkPatch(chunk, root, JSN_GetChunkRoot(target), ChangeLog::Record, &log));
+		REQUIRE(log.calls == 1);
+		REQUIRE(log.changes.size() == 5);
+
+		// Monsters before the inserted one aren't reported as modified.
+		REQUIRE(log.changes.at("/name").type == JSN_CHANGE_REMOVED);
+		REQUIRE(log.changes.at("/name").old_value.string_value == std::string_view("bestiary"));
+		REQUIRE(log.changes.at("/name").value == NULL);
+		REQUIRE(log.changes.at("/version").type == JSN_CHANGE_ADDED);
+		REQUIRE(log.changes.at("/version").old_value.type == JSN_TYPE_EMPTY);
+		REQUIRE(log.changes.at("/version").value == JSN_ObjectGet(root, "version", 7));
+		REQUIRE(log.changes.at("/monsters/0").type == JSN_CHANGE_ADDED);
+		REQUIRE(log.changes.at("/monsters/3/stats/hp").type == JSN_CHANGE_MODIFIED);
+		REQUIRE(log.changes.at("/monsters/3/stats/hp").old_value.integer_value == 120);
+		REQUIRE(log.changes.at("/monsters/3/stats/hp").value->integer_value == 150);
+		REQUIRE(log.changes.at("/a~1b/new").type == JSN_CHANGE_ADDED);
+
+		REQUIRE(ValuesEqual(root, JSN_GetChunkRoot(target)));
+
+		// Containers which were kept are patched in place.
+		REQUIRE(JSN_ObjectGet(root, "a/b", 3)->object_value == escaped);
+		REQUIRE(JSN_ObjectGet(JSN_ArrayGet(JSN_ObjectGet(root, "monsters", 8), 3), "stats", 5)->object_value == golem_stats);
+	}
+
+	SECTION("Ignore unchanged values")
+	{
+		ChangeLog log;
+		REQUIRE(JSN_ChunkPatch(chunk, root, root, ChangeLog::Record, &log));
+		REQUIRE(log.calls == 0);
+
+		// Properties are matched by key, whatever their order.
+		const char* reordered = R"({ "7": "seven", "a/b": { "~": "escaped" }, "monsters": [], "name": "bestiary" })";
+		JSN_Chunk* other = JSN_ReadChunkFromMem(reordered, SDL_strlen(reordered));
+		JSN_ChunkCopy(other, JSN_ObjectGet(JSN_GetChunkRoot(other), "monsters", 8), JSN_ObjectGet(root, "monsters", 8));
+
+		REQUIRE(JSN_ChunkPatch(chunk, root, JSN_GetChunkRoot(other), ChangeLog::Record, &log));
+		REQUIRE(log.calls == 0);
+		JSN_DestroyChunk(other);
+	}
+
+	SECTION("Patch arrays")
+	{
+		auto patch = [&](const char* from, const char* to)
+		{
+			JSN_Chunk* source = JSN_ReadChunkFromMem(from, SDL_strlen(from));
+			JSN_Chunk* dest = JSN_ReadChunkFromMem(to, SDL_strlen(to));
+			ChangeLog log;
+			REQUIRE(JSN_ChunkPatch(source, JSN_GetChunkRoot(source), JSN_GetChunkRoot(dest), ChangeLog::Record, &log));
+			REQUIRE(ValuesEqual(JSN_GetChunkRoot(source), JSN_GetChunkRoot(dest)));
+			JSN_DestroyChunk(source);
+			JSN_DestroyChunk(dest);
+
+			std::string summary;
+			for (const auto& [path, change] : log.changes)
+			{ summary += "+-~"[change.type] + path + " "; }
+			return summary;
+		};
+
+		REQUIRE(patch("[1, 2, 3]", "[1, 2, 3, 4]") == "+/3 ");
+		REQUIRE(patch("[1, 2, 3]", "[0, 1, 2, 3]") == "+/0 ");
+		REQUIRE(patch("[1, 2, 3]", "[1, 3]") == "-/1 ");
+		REQUIRE(patch("[1, 2, 3]", "[1, 5, 3]") == "~/1 ");
+		REQUIRE(patch("[1, 2, 3, 4]", "[2, 3, 5, 4]") == "-/0 +/2 ");
+		REQUIRE(patch("[[1], [2]]", "[[1], [2, 3]]") == "+/1/1 ");
+		REQUIRE(patch("[1, 2]", "{ \"1\": 2 }") == "~ ");
+	}
+
+	SECTION("Leave values untouched on failure")
+	{
+		const char* source = R"({ "a": [1, 2], "b": [3] })";
+		char file[] = "json_patch_test.json";
+		REQUIRE(SDL_SaveFile(file, source, SDL_strlen(source)));
+
+		JSN_Chunk* lazy = JSN_ReadLazyChunkFromFile(file);
+		REQUIRE(lazy != NULL);
+
+		const char* changed = R"({ "a": [1, 2, 3], "b": 3 })";
+		REQUIRE(SDL_SaveFile(file, changed, SDL_strlen(changed)));
+
+		ChangeLog log;
+		REQUIRE_FALSE(JSN_ChunkPatch(chunk, root, JSN_GetChunkRoot(lazy), ChangeLog::Record, &log));
+		REQUIRE(log.calls == 0);
+		REQUIRE(JSN_ObjectGet(root, "name", 4) != NULL);
+
+		JSN_DestroyChunk(lazy);
+		SDL_RemovePath(file);
+	}
+
+	JSN_DestroyChunk(target);
+	JSN_DestroyChunk(chunk);
+}
+
+
+TEST_CASE("JSON/Reloader", "[json]")
+{
+	const char* file = "json_reload_test.json";
+	REQUIRE(SDL_SaveFile(file, query_json, SDL_strlen(query_json)));
+
+	JSN_Reloader* reloader = JSN_CreateReloader(file);
+	REQUIRE(reloader != NULL);
+
+	JSN_Chunk* chunk = JSN_GetReloaderChunk(reloader);
+	JSN_Value* monsters = JSN_ObjectGet(JSN_GetChunkRoot(chunk), "monsters", 8);
+
+	ChangeLog all;
+	ChangeLog golem;
+	ChangeLog escaped;
+	REQUIRE(JSN_SubscribeReloader(reloader, "", ChangeLog::Record, &all));
+	REQUIRE(JSN_SubscribeReloader(reloader, "/monsters/3", ChangeLog::Record, &golem));
+	REQUIRE(JSN_SubscribeReloader(reloader, "/a~1b/~0", ChangeLog::Record, &escaped));
+	REQUIRE_FALSE(JSN_SubscribeReloader(reloader, "monsters", ChangeLog::Record, &all));
+
+	// Files which weren't modified aren't read again.
+	REQUIRE(JSN_Reload(reloader, false));
+	REQUIRE(all.calls == 0);
+
+	REQUIRE(SDL_SaveFile(file, patched_json, SDL_strlen(patched_json)));
+	REQUIRE(JSN_Reload(reloader, true));
+	REQUIRE(JSN_GetReloaderChunk(reloader) == chunk);
+	REQUIRE(JSN_ObjectGet(JSN_GetChunkRoot(chunk), "monsters", 8)->array_value == monsters->array_value);
+
+	REQUIRE(all.changes.size() == 5);
+	REQUIRE(golem.changes.size() == 1);
+	REQUIRE(golem.changes.count("/monsters/3/stats/hp") == 1);
+	REQUIRE(escaped.calls == 0);
+
+	// Files which can't be read leave the chunk as is, until they're fixed.
+	const char* broken = R"({ "a/b": 1 )";
+	REQUIRE(SDL_SaveFile(file, broken, SDL_strlen(broken)));
+	REQUIRE_FALSE(JSN_Reload(reloader, true));
+	REQUIRE(JSN_ObjectGet(JSN_GetChunkRoot(chunk), "version", 7)->integer_value == 2);
+
+	// Ancestors of watched values being replaced affects them too.
+	JSN_UnsubscribeReloader(reloader, ChangeLog::Record, &all);
+	const char* fixed = R"({ "a/b": 1 })";
+	REQUIRE(SDL_SaveFile(file, fixed, SDL_strlen(fixed)));
+	REQUIRE(JSN_Reload(reloader, true));
+	REQUIRE(all.calls == 1);
+	REQUIRE(escaped.calls == 1);
+	REQUIRE(escaped.changes.at("/a~1b").type == JSN_CHANGE_MODIFIED);
+	REQUIRE(golem.changes.count("/monsters") == 1);
+
+	JSN_DestroyReloader(reloader);
+	SDL_RemovePath(file);
+}
+
+namespace Typed
+{
+	enum class Element
+	{
+		None,
+		Fire,
+		Ice,
+	};
+
+	constexpr auto json_values(Element)
+	{ return Game::JsonValues(std::pair{ "none", Element::None }, std::pair{ "fire", Element::Fire }, std::pair{ "ice", Element::Ice }); }
+
+	struct Stats
+	{
+		int hp = 0;
+		float speed = 1.0f;
+
+		static constexpr auto json_fields()
+		{
+			return Game::JsonFields(
+				Game::JsonField<&Stats::hp>("hp"),
+				Game::JsonField<&Stats::speed>("speed"));
+		}
+	};
+
+	struct Monster
+	{
+		std::string name;
+		std::optional<Stats> stats;
+		std::vector<std::string> tags;
+		Element element = Element::None;
+
+		static constexpr auto json_fields()
+		{
+			return Game::JsonFields(
+				Game::JsonField<&Monster::name>("name"),
+				Game::JsonField<&Monster::stats>("stats"),
+				Game::JsonField<&Monster::tags>("tags"),
+				Game::JsonField<&Monster::element>("element"));
+		}
+	};
+
+	struct Bestiary
+	{
+		std::string name;
+		std::vector<Monster> monsters;
+
+		static constexpr auto json_fields()
+		{
+			return Game::JsonFields(
+				Game::JsonField<&Bestiary::name>("name"),
+				Game::JsonField<&Bestiary::monsters>("monsters"));
+		}
+	};
+}
+
+
+TEST_CASE("JSON/Typed", "[json]")
+{
+	using namespace Typed;
+
+	SECTION("Read structs")
+	{
+		Bestiary bestiary;
+		REQUIRE(Game::ReadJsonMem(query_json, SDL_strlen(query_json), bestiary));
+
+		// Compare against the same document read into a chunk.
+		JSN_Chunk* chunk = JSN_ReadChunkFromMem(query_json, SDL_strlen(query_json));
+		REQUIRE(chunk != NULL);
+
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		REQUIRE(bestiary.name == JSN_ObjectGet(root, "name", 4)->string_value);
+
+		JSN_Value* monsters = JSN_ObjectGet(root, "monsters", 8);
+		REQUIRE(bestiary.monsters.size() == monsters->array_value->count);
+
+		for (size_t i = 0; i < bestiary.monsters.size(); ++i)
+		{
+			const Monster& monster = bestiary.monsters[i];
+			JSN_Value* value = JSN_ArrayGet(monsters, i);
+			INFO(monster.name);
+			REQUIRE(monster.name == JSN_ObjectGet(value, "name", 4)->string_value);
+
+			JSN_Value* stats = JSN_ObjectGet(value, "stats", 5);
+			REQUIRE(monster.stats.has_value() == (stats->type == JSN_TYPE_OBJECT));
+
+			if (monster.stats)
+			{ REQUIRE(monster.stats->hp == JSN_ObjectGet(stats, "hp", 2)->integer_value); }
+
+			JSN_Value* tags = JSN_ObjectGet(value, "tags", 4);
+			REQUIRE(monster.tags.size() == (tags ? tags->array_value->count : 0));
+		}
+
+		// Fields missing from the input keep their defaults, integers convert to floats.
+		REQUIRE(bestiary.monsters[0].stats->speed == 0.5f);
+		REQUIRE(bestiary.monsters[1].stats->speed == 3.0f);
+		REQUIRE(bestiary.monsters[2].stats->speed == 1.0f);
+		REQUIRE(bestiary.monsters[2].tags[1] == "boss");
+
+		JSN_DestroyChunk(chunk);
+	}
+
+	SECTION("Read enums & root arrays")
+	{
+		const char* json_string = R"([{ "element": "fire", "extra": [[{}], 1] }, { "element": "ice" }, {}])";
+		std::vector<Monster> monsters;
+		REQUIRE(Game::ReadJsonMem(json_string, SDL_strlen(json_string), monsters));
+		REQUIRE(monsters.size() == 3);
+		REQUIRE(monsters[0].element == Element::Fire);
+		REQUIRE(monsters[1].element == Element::Ice);
+		REQUIRE(monsters[2].element == Element::None);
+	}
+
+	SECTION("Mismatched types")
+	{
+		Monster monster;
+		const char* unknown_enum = R"({ "element": "water" })";
+		REQUIRE_FALSE(Game::ReadJsonMem(unknown_enum, SDL_strlen(unknown_enum), monster));
+		REQUIRE(SDL_strstr(SDL_GetError(), "water") != NULL);
+
+		Stats stats;
+		const char* fractional_hp = R"({ "hp": 1.5 })";
+		REQUIRE_FALSE(Game::ReadJsonMem(fractional_hp, SDL_strlen(fractional_hp), stats));
+		REQUIRE(SDL_strstr(SDL_GetError(), "expected integer but found number") != NULL);
+
+		const char* array_name = R"({ "name": ["slime"] })";
+		REQUIRE_FALSE(Game::ReadJsonMem(array_name, SDL_strlen(array_name), monster));
+		REQUIRE(SDL_strstr(SDL_GetError(), "expected string but found array") != NULL);
+
+		const char* object_tags = R"({ "tags": { "goo": true } })";
+		REQUIRE_FALSE(Game::ReadJsonMem(object_tags, SDL_strlen(object_tags), monster));
+		REQUIRE(SDL_strstr(SDL_GetError(), "expected array but found object") != NULL);
+
+		const char* out_of_range = R"({ "hp": 3000000000 })";
+		REQUIRE_FALSE(Game::ReadJsonMem(out_of_range, SDL_strlen(out_of_range), stats));
+	}
+}
@@ -0,0 +1,532 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL3/SDL_timer.h>
+
+#include <json.hpp>
+#include <jsonx.hpp>
+#include <bindings/json.hpp>
+
+#include "json_inputs.hpp"
+
+
+#ifndef JSON_CORPUS_DIR
+#define JSON_CORPUS_DIR "tests/corpus"
+#endif
+
+#ifndef JSON_OUTPUT_DIR
+#define JSON_OUTPUT_DIR "."
+#endif
+
+
+/**
+ * @brief Tracks the number of allocations & the peak of allocated bytes made through SDL's memory functions while in scope.
+ *
+ * @note Sizes are kept on the side, since blocks allocated before the tracker may be freed while it's in scope.
+ *  This makes tracking slow, so measurements are taken separately from timings. Not thread-safe.
+ */
+struct MemoryTracker
+{
+	static inline SDL_malloc_func malloc_func;
+	static inline SDL_calloc_func calloc_func;
+	static inline SDL_realloc_func realloc_func;
+	static inline SDL_free_func free_func;
+
+	static inline std::unordered_map<void*, size_t>* sizes;
+	static inline size_t allocations;
+	static inline size_t current;
+	static inline size_t peak;
+
+	MemoryTracker()
+	{
+		sizes = new std::unordered_map<void*, size_t>();
+		allocations = current = peak = 0;
+		SDL_GetMemoryFunctions(&malloc_func, &calloc_func, &realloc_func, &free_func);
+		SDL_SetMemoryFunctions(Malloc, Calloc, Realloc, Free);
+	}
+
+	~MemoryTracker()
+	{
+		SDL_SetMemoryFunctions(malloc_func, calloc_func, realloc_func, free_func);
+		delete sizes;
+	}
+
+	static void Track(void* mem, size_t size)
+	{
+		if (mem == NULL)
+		{ return; }
+
+		(*sizes)[mem] = size;
+		current += size;
+		peak = SDL_max(peak, current);
+		++allocations;
+	}
+
+	static void Untrack(void* mem)
+	{
+		if (auto it = sizes->find(mem); it != sizes->end())
+		{
+			current -= it->second;
+			sizes->erase(it);
+		}
+	}
+
+	static void* Malloc(size_t size)
+	{ void* mem = malloc_func(size); Track(mem, size); return mem; }
+
+	static void* Calloc(size_t count, size_t size)
+	{ void* mem = calloc_func(count, size); Track(mem, count * size); return mem; }
+
+	static void* Realloc(void* mem, size_t size)
+	{ Untrack(mem); mem = realloc_func(mem, size); Track(mem, size); return mem; }
+
+	static void Free(void* mem)
+	{ Untrack(mem); free_func(mem); }
+};
+
+
+/**
+ * @brief A file of the corpus, loaded into memory.
+ */
+struct CorpusFile
+{
+	const char* name;
+	char path[256];
+	void* data;
+	size_t length;
+
+	CorpusFile(const char* name) : name(name)
+	{
+		SDL_snprintf(path, sizeof(path), "%s/%s", JSON_CORPUS_DIR, name);
+		data = SDL_LoadFile(path, &length);
+		REQUIRE(data != NULL);
+	}
+
+	~CorpusFile()
+	{ SDL_free(data); }
+};
+
+
+/**
+ * @brief Time an operation on a corpus file, then track its memory, printing its throughput & memory usage.
+ *
+ * @note Throughput is measured against the size of the JSON file, whatever the operation.
+ */
+template<typename F>
+static void Report(const CorpusFile& file, const char* operation, F&& run)
+{
+	// Repeat for at least a quarter second to smooth out the timer's resolution.
+	Uint64 frequency = SDL_GetPerformanceFrequency();
+	Uint64 start = SDL_GetPerformanceCounter();
+	Uint64 elapsed = 0;
+	size_t iterations = 0;
+
+	do
+	{
+		REQUIRE(run());
+		++iterations;
+		elapsed = SDL_GetPerformanceCounter() - start;
+	}
+	while (iterations < 3 || elapsed < frequency / 4);
+
+	double megabytes = (double)file.length / (1024.0 * 1024.0);
+	double seconds = (double)elapsed / (double)frequency;
+
+	size_t allocations;
+	size_t peak;
+	{
+		MemoryTracker tracker;
+		REQUIRE(run());
+		allocations = tracker.allocations;
+		peak = tracker.peak;
+	}
+
+	std::printf("%-20s %-28s %10.1f MB/s %12.1f allocs/MB %10.2f MB peak (%.2fx)\n",
+		file.name, operation,
+		megabytes * (double)iterations / seconds,
+		(double)allocations / megabytes,
+		(double)peak / (1024.0 * 1024.0),
+		(double)peak / (double)file.length);
+}
+
+
+/**
+ * @brief Report & benchmark reading, loading & copying a corpus file.
+ */
+static void RunCorpus(const char* name)
+{
+	CorpusFile file(name);
+
+	JSN_Chunk* source = JSN_ReadChunkFromMem(file.data, file.length);
+	REQUIRE(source != NULL);
+
+	auto read_mem = [&]()
+	{
+		JSN_Chunk* chunk = JSN_ReadChunkFromMem(file.data, file.length);
+
+		if (chunk)
+		{ JSN_DestroyChunk(chunk); }
+
+		return chunk != NULL;
+	};
+
+	auto read_file = [&]()
+	{
+		JSN_Chunk* chunk = JSN_ReadChunkFromFile(file.path);
+
+		if (chunk)
+		{ JSN_DestroyChunk(chunk); }
+
+		return chunk != NULL;
+	};
+
+	// Follows the first child of every container down to the first scalar, reading only that path.
+	auto read_lazy_path = [&]()
+	{
+		JSN_Chunk* chunk = JSN_ReadLazyChunkFromFile(file.path);
+
+		if (chunk == NULL)
+		{ return false; }
+
+		JSN_Value* value = JSN_GetChunkRoot(chunk);
+
+		while (value && (value->type == JSN_TYPE_ARRAY || value->type == JSN_TYPE_OBJECT))
+		{
+			value = value->type == JSN_TYPE_ARRAY
+				? JSN_ArrayGet(value, 0)
+				: (JSN_LoadValue(value, false) && value->object_value->count ? &value->object_value->properties[0].value : NULL);
+		}
+
+		JSN_DestroyChunk(chunk);
+		return true;
+	};
+
+	auto copy = [&]()
+	{
+		JSN_Chunk* chunk = JSN_CreateChunk();
+		bool success = JSN_ChunkCopy(chunk, JSN_GetChunkRoot(chunk), JSN_GetChunkRoot(source));
+		JSN_DestroyChunk(chunk);
+		return success;
+	};
+
+	Report(file, "JSN_ReadChunkFromMem", read_mem);
+
+	JSN_SetBinaryCache(false, NULL);
+	Report(file, "JSN_ReadChunkFromFile", read_file);
+
+	// The first read saves the binary image, which the following reads load, away from the corpus itself.
+	JSN_SetBinaryCache(true, JSON_OUTPUT_DIR);
+	REQUIRE(read_file());
+	Report(file, "JSN_ReadChunkFromFile cached", read_file);
+
+	Report(file, "JSN_ChunkCopy", copy);
+	Report(file, "JSN_ReadLazyChunkFromFile", read_lazy_path);
+
+	BENCHMARK("JSN_ReadChunkFromMem")
+	{ return read_mem(); };
+
+	JSN_SetBinaryCache(false, NULL);
+
+	BENCHMARK("JSN_ReadChunkFromFile")
+	{ return read_file(); };
+
+	JSN_SetBinaryCache(true, JSON_OUTPUT_DIR);
+
+	BENCHMARK("JSN_ReadChunkFromFile cached")
+	{ return read_file(); };
+
+	BENCHMARK("JSN_ChunkCopy")
+	{ return copy(); };
+
+	BENCHMARK("JSN_ReadLazyChunkFromFile")
+	{ return read_lazy_path(); };
+
+	JSN_SetBinaryCache(false, NULL);
+	JSN_DestroyChunk(source);
+}
+
+
+TEST_CASE("JSON/Corpus/Flat Array", "[json][benchmark]")
+{
+	RunCorpus("flat_array.json");
+}
+
+
+TEST_CASE("JSON/Corpus/Deep Nesting", "[json][benchmark]")
+{
+	RunCorpus("deep_nesting.json");
+}
+
+
+TEST_CASE("JSON/Corpus/Numbers", "[json][benchmark]")
+{
+	RunCorpus("numbers.json");
+}
+
+
+TEST_CASE("JSON/Corpus/Strings", "[json][benchmark]")
+{
+	RunCorpus("strings.json");
+}
+
+
+TEST_CASE("JSON/Corpus/Keys", "[json][benchmark]")
+{
+	RunCorpus("keys.json");
+}
+
+
+TEST_CASE("JSON/Reader/Number Throughput", "[json][benchmark]")
+{
+	// Coordinates as exported by map editors, mostly short decimals.
+	SDL_IOStream* stream = SDL_IOFromDynamicMem();
+	SDL_WriteIO(stream, "[", 1);
+	for (int i = 0; i < 50000; ++i)
+	{ SDL_IOprintf(stream, "[%d.%d, -%d.%03d, %d, %de-3],\n", i % 4096, i % 10, i % 977, i % 1000, i * 31, i); }
+	SDL_IOprintf(stream, "0]");
+
+	size_t length = (size_t)SDL_GetIOSize(stream);
+	char* json_string = (char*)SDL_malloc(length);
+	SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+	SDL_ReadIO(stream, json_string, length);
+	SDL_CloseIO(stream);
+
+	BENCHMARK("Read 200000 numbers")
+	{
+		JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, length);
+		JSN_DestroyChunk(chunk);
+		return chunk;
+	};
+
+	SDL_free(json_string);
+}
+
+
+TEST_CASE("JSON/Writer/Throughput", "[json][benchmark]")
+{
+	size_t length;
+	char* json_string = BuildMultilingualJSON(1024 * 1024, &length);
+	JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, length);
+	REQUIRE(chunk != NULL);
+
+	size_t size = 4 * length;
+	char* output = (char*)SDL_malloc(size);
+
+	{
+		// Writing allocates the writer alone, whatever the size of the output.
+		SDL_IOStream* stream = SDL_IOFromMem(output, size);
+		MemoryTracker tracker;
+		REQUIRE(JSN_Write(stream, JSN_GetChunkRoot(chunk), true, false));
+		REQUIRE(tracker.allocations == 1);
+		SDL_CloseIO(stream);
+	}
+
+	BENCHMARK("Write 1 MiB compactly")
+	{
+		SDL_IOStream* stream = SDL_IOFromMem(output, size);
+		bool success = JSN_Write(stream, JSN_GetChunkRoot(chunk), false, true);
+		return success;
+	};
+
+	BENCHMARK("Write 1 MiB pretty")
+	{
+		SDL_IOStream* stream = SDL_IOFromMem(output, size);
+		bool success = JSN_Write(stream, JSN_GetChunkRoot(chunk), true, true);
+		return success;
+	};
+
+	SDL_free(output);
+	JSN_DestroyChunk(chunk);
+	SDL_free(json_string);
+}
+
+
+TEST_CASE("JSON/Query/Throughput", "[json][benchmark]")
+{
+	size_t length;
+	char* json_string = BuildMonstersJSON(20000, &length);
+
+	JSN_Query* query = JSN_CompileQuery("monsters[*].stats.hp");
+	REQUIRE(query != NULL);
+
+	BENCHMARK("Read whole chunk & query it")
+	{
+		JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, length);
+		size_t count = JSN_QueryValue(query, JSN_GetChunkRoot(chunk), NULL, NULL);
+		JSN_DestroyChunk(chunk);
+		return count;
+	};
+
+	BENCHMARK("Read query matches only")
+	{
+		JSN_Chunk* chunk = JSN_ReadQueryFromIO(SDL_IOFromConstMem(json_string, length), query, true);
+		size_t count = JSN_GetChunkRoot(chunk)->array_value->count;
+		JSN_DestroyChunk(chunk);
+		return count;
+	};
+
+	JSN_DestroyQuery(query);
+	SDL_free(json_string);
+}
+
+
+TEST_CASE("JSON/Lua/Throughput", "[json][benchmark]")
+{
+	size_t length;
+	char* json_string = BuildMultilingualJSON(1024 * 1024, &length);
+	lua_State* lua = luaL_newstate();
+
+	BENCHMARK("Read 1 MiB into a chunk")
+	{
+		JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, length);
+		JSN_DestroyChunk(chunk);
+		return chunk != NULL;
+	};
+
+	BENCHMARK("Read 1 MiB into Lua tables")
+	{
+		bool success = lua_pushjson(lua, json_string, length);
+		lua_settop(lua, 0);
+		return success;
+	};
+
+	lua_close(lua);
+	SDL_free(json_string);
+}
+
+
+TEST_CASE("JSON/Chunk/Read Files Throughput", "[json][benchmark]")
+{
+	constexpr int count = 200;
+	char** files = WriteBatchFiles(JSON_OUTPUT_DIR, count, 1000);
+	JSN_Chunk* chunks[count];
+
+	BENCHMARK("Read 200 files one after another")
+	{
+		for (int i = 0; i < count; ++i)
+		{ chunks[i] = JSN_ReadChunkFromFile(files[i]); }
+
+		for (int i = 0; i < count; ++i)
+		{ JSN_DestroyChunk(chunks[i]); }
+	};
+
+	BENCHMARK("Read 200 files at once")
+	{
+		JSN_ReadChunksFromFiles(files, count, chunks, NULL);
+
+		for (int i = 0; i < count; ++i)
+		{ JSN_DestroyChunk(chunks[i]); }
+	};
+
+	FreeBatchFiles(files, count);
+}
+
+
+TEST_CASE("JSON/Typed/Throughput", "[json][benchmark]")
+{
+	struct Stats
+	{
+		int hp = 0;
+		float speed = 1.0f;
+
+		static constexpr auto json_fields()
+		{
+			return Game::JsonFields(
+				Game::JsonField<&Stats::hp>("hp"),
+				Game::JsonField<&Stats::speed>("speed"));
+		}
+	};
+
+	struct Entry
+	{
+		std::string name;
+		Stats stats;
+		std::string lore;
+
+		static constexpr auto json_fields()
+		{
+			return Game::JsonFields(
+				Game::JsonField<&Entry::name>("name"),
+				Game::JsonField<&Entry::stats>("stats"),
+				Game::JsonField<&Entry::lore>("lore"));
+		}
+	};
+
+	struct Entries
+	{
+		std::vector<Entry> monsters;
+
+		static constexpr auto json_fields()
+		{ return Game::JsonFields(Game::JsonField<&Entries::monsters>("monsters")); }
+	};
+
+	size_t length;
+	char* json_string = BuildMonstersJSON(20000, &length);
+
+	BENCHMARK("Read into a chunk")
+	{
+		JSN_Chunk* chunk = JSN_ReadChunkFromMem(json_string, length);
+		JSN_DestroyChunk(chunk);
+		return chunk != NULL;
+	};
+
+	BENCHMARK("Read into structs")
+	{
+		Entries entries;
+		Game::ReadJsonMem(json_string, length, entries);
+		return entries.monsters.size();
+	};
+
+	SDL_free(json_string);
+}
+
+
+TEST_CASE("JSON/Chunk/Share Throughput", "[json][benchmark]")
+{
+	size_t length;
+	char* json_string = BuildMonstersJSON(100, &length);
+
+	JSN_Chunk* templates = JSN_ReadChunkFromMem(json_string, length);
+	REQUIRE(templates != NULL);
+	JSN_Value* monsters = JSN_ObjectGet(JSN_GetChunkRoot(templates), "monsters", 8);
+
+	// Spawn a thousand entities from templates, touching the stats of one in ten.
+	auto spawn = [&](bool share)
+	{
+		JSN_Chunk* chunk = JSN_CreateChunk();
+		JSN_Value* root = JSN_GetChunkRoot(chunk);
+		JSN_ChunkSetArray(chunk, root);
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			JSN_Value* entity = JSN_ChunkAddElement(chunk, root, JSN_APPEND, NULL);
+
+			if (share)
+			{ JSN_ChunkShare(chunk, entity, JSN_ArrayGet(monsters, i % 100)); }
+			else
+			{ JSN_ChunkCopy(chunk, entity, JSN_ArrayGet(monsters, i % 100)); }
+
+			if (i % 10 == 0)
+			{ JSN_ChunkSetInteger(chunk, JSN_ObjectGet(JSN_ObjectGet(entity, "stats", 5), "hp", 2), 0); }
+		}
+
+		size_t count = root->array_value->count;
+		JSN_DestroyChunk(chunk);
+		return count;
+	};
+
+	BENCHMARK("Spawn shared copies")
+	{ return spawn(true); };
+
+	BENCHMARK("Spawn deep copies")
+	{ return spawn(false); };
+
+	JSN_DestroyChunk(templates);
+	SDL_free(json_string);
+}
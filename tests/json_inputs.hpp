@@ -0,0 +1,139 @@
+#ifndef GAME_JSON_INPUTS_HEADER
+#define GAME_JSON_INPUTS_HEADER
+
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <SDL3/SDL_filesystem.h>
+
+#include <json.hpp>
+
+
+/**
+ * @brief Build an array of strings and objects mixing several scripts, at least the given number of bytes long.
+ */
+inline char* BuildMultilingualJSON(size_t min_length, size_t* length)
+{
+	static const char* const phrases[]
+	{
+		"The quick brown fox jumps over the lazy dog",
+		"Falsches \xC3\x9C" "ben von Xylophonmusik qu\xC3\xA4lt jeden gr\xC3\xB6\xC3\x9F" "eren Zwerg",
+		"\xCE\x9E\xCE\xB5\xCF\x83\xCE\xBA\xCE\xB5\xCF\x80\xCE\xAC\xCE\xB6\xCF\x89 \xCF\x84\xE1\xBD\xB4\xCE\xBD \xCF\x88\xCF\x85\xCF\x87\xCE\xBF\xCF\x86\xCE\xB8\xCF\x8C\xCF\x81\xCE\xB1",
+		"\xD0\xA1\xD1\x8A\xD0\xB5\xD1\x88\xD1\x8C \xD0\xB6\xD0\xB5 \xD0\xB5\xD1\x89\xD1\x91 \xD1\x8D\xD1\x82\xD0\xB8\xD1\x85 \xD0\xBC\xD1\x8F\xD0\xB3\xD0\xBA\xD0\xB8\xD1\x85",
+		"\xE3\x81\x84\xE3\x82\x8D\xE3\x81\xAF\xE3\x81\xAB\xE3\x81\xBB\xE3\x81\xB8\xE3\x81\xA8 \xE3\x81\xA1\xE3\x82\x8A\xE3\x81\xAC\xE3\x82\x8B\xE3\x82\x92",
+		"\xE4\xBD\xA0\xE5\xA5\xBD\xEF\xBC\x8C\xE4\xB8\x96\xE7\x95\x8C",
+		"\xD8\xB5\xD9\x90\xD9\x81 \xD8\xAE\xD9\x8E\xD9\x84\xD9\x82\xD9\x8E",
+		"\xF0\x9F\x8E\xAE \xF0\x9F\x90\x89 \xF0\x9F\x8F\xB0 \\ud83d\\udc7e \\u00e9t\\u00e9",
+	};
+
+	SDL_IOStream* stream = SDL_IOFromDynamicMem();
+	SDL_WriteIO(stream, "[", 1);
+
+	for (size_t i = 0; (size_t)SDL_GetIOSize(stream) < min_length; ++i)
+	{
+		const char* phrase = phrases[i % SDL_arraysize(phrases)];
+		SDL_IOprintf(stream, "{\"%s\":\"%s\",\"id\":%zu},\"%s\",\n", phrases[(i + 3) % SDL_arraysize(phrases)], phrase, i, phrase);
+	}
+
+	SDL_IOprintf(stream, "null]");
+
+	*length = (size_t)SDL_GetIOSize(stream);
+	char* json_string = (char*)SDL_malloc(*length);
+	SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET);
+	SDL_ReadIO(stream, json_string, *length);
+	SDL_CloseIO(stream);
+
+	return json_string;
+}
+
+
+/**
+ * @brief Build a bestiary of monsters with a name, stats & lore, to be freed with SDL_free().
+ */
+inline char* BuildMonstersJSON(int count, size_t* length)
+{
+	size_t size = 4 * 1024 * 1024;
+	char* json_string = (char*)SDL_malloc(size);
+	SDL_IOStream* stream = SDL_IOFromMem(json_string, size);
+	JSN_Writer* writer = JSN_CreateWriter(stream, false, true);
+	JSN_WriteOpenObject(writer);
+	JSN_WriteKey(writer, "monsters", 8);
+	JSN_WriteOpenArray(writer);
+
+	for (int i = 0; i < count; ++i)
+	{
+		char name[32];
+		SDL_snprintf(name, sizeof(name), "monster %d", i);
+
+		JSN_Value values[3];
+		values[0].type = JSN_TYPE_STRING;
+		values[0].string_value = name;
+		values[0].string_length = (uint32_t)SDL_strlen(name);
+		values[1].type = JSN_TYPE_INTEGER;
+		values[1].integer_value = i % 500;
+		values[2].type = JSN_TYPE_NUMBER;
+		values[2].number_value = i * 0.25;
+
+		JSN_WriteOpenObject(writer);
+		JSN_WriteKey(writer, "name", 4);
+		JSN_WriteValue(writer, &values[0]);
+		JSN_WriteKey(writer, "stats", 5);
+		JSN_WriteOpenObject(writer);
+		JSN_WriteKey(writer, "hp", 2);
+		JSN_WriteValue(writer, &values[1]);
+		JSN_WriteKey(writer, "speed", 5);
+		JSN_WriteValue(writer, &values[2]);
+		JSN_WriteCloseObject(writer);
+		JSN_WriteKey(writer, "lore", 4);
+		JSN_WriteValue(writer, &values[0]);
+		JSN_WriteCloseObject(writer);
+	}
+
+	JSN_WriteCloseArray(writer);
+	JSN_WriteCloseObject(writer);
+	JSN_FlushWriter(writer);
+	*length = (size_t)SDL_TellIO(stream);
+	REQUIRE(JSN_CloseWriter(writer));
+	return json_string;
+}
+
+
+/**
+ * @brief Write numbered JSON files into a directory, returning their paths to be freed with FreeBatchFiles().
+ */
+inline char** WriteBatchFiles(const char* directory, int count, int elements)
+{
+	char** files = (char**)SDL_calloc(count, sizeof(char*));
+
+	for (int i = 0; i < count; ++i)
+	{
+		SDL_asprintf(&files[i], "%s/json_batch_test_%d.json", directory, i);
+
+		SDL_IOStream* stream = SDL_IOFromFile(files[i], "wb");
+		REQUIRE(stream != NULL);
+		SDL_IOprintf(stream, R"({ "index": %d, "name": "file %d", "values": [)", i, i);
+
+		for (int j = 0; j < elements; ++j)
+		{ SDL_IOprintf(stream, j ? ", %d.5" : "%d.5", j); }
+
+		SDL_IOprintf(stream, "] }");
+		REQUIRE(SDL_CloseIO(stream));
+	}
+
+	return files;
+}
+
+
+inline void FreeBatchFiles(char** files, int count)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		SDL_RemovePath(files[i]);
+		SDL_free(files[i]);
+	}
+
+	SDL_free(files);
+}
+
+
+#endif // GAME_JSON_INPUTS_HEADER
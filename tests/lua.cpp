@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+
+
+#include <cstring>
+#include <string>
+
+#include <luax.hpp>
+
+
+TEST_CASE("Lua/Pool", "[lua]")
+{
+	const auto& stats = lua_getpoolstats();
+
+	SECTION("Reuse freed blocks of the same class")
+	{
+		auto live = stats.live;
+		auto a = lua_poolalloc(nullptr, nullptr, LUA_TTABLE, 40);
+		REQUIRE(a != nullptr);
+		CHECK(stats.live == live + 40);
+		CHECK(stats.classes[2].live >= 1);
+
+		lua_poolalloc(nullptr, a, 40, 0);
+		CHECK(stats.live == live);
+
+		auto b = lua_poolalloc(nullptr, nullptr, LUA_TSTRING, 48);
+		CHECK(b == a);
+		lua_poolalloc(nullptr, b, 48, 0);
+	}
+
+	SECTION("Keep blocks in place within their class")
+	{
+		auto a = lua_poolalloc(nullptr, nullptr, 0, 33);
+		CHECK(lua_poolalloc(nullptr, a, 33, 48) == a);
+		lua_poolalloc(nullptr, a, 48, 0);
+	}
+
+	SECTION("Move blocks across classes & to large blocks")
+	{
+		auto live = stats.live;
+		auto large = stats.large.live;
+
+		auto a = (char*)lua_poolalloc(nullptr, nullptr, 0, 16);
+		std::memcpy(a, "0123456789abcde", 16);
+
+		a = (char*)lua_poolalloc(nullptr, a, 16, 200);
+		REQUIRE(a != nullptr);
+		CHECK(std::memcmp(a, "0123456789abcde", 16) == 0);
+
+		a = (char*)lua_poolalloc(nullptr, a, 200, 4096);
+		REQUIRE(a != nullptr);
+		CHECK(std::memcmp(a, "0123456789abcde", 16) == 0);
+		CHECK(stats.large.live == large + 1);
+
+		a = (char*)lua_poolalloc(nullptr, a, 4096, 8);
+		REQUIRE(a != nullptr);
+		CHECK(std::memcmp(a, "01234567", 8) == 0);
+		CHECK(stats.large.live == large);
+
+		lua_poolalloc(nullptr, a, 8, 0);
+		CHECK(stats.live == live);
+	}
+
+	SECTION("Run a Lua state")
+	{
+		auto live = stats.live;
+		auto allocations = stats.allocations;
+
+		lua_State* lua = lua_newstate(lua_poolalloc, nullptr);
+		REQUIRE(lua != nullptr);
+
+		luaL_openlibs(lua);
+		REQUIRE(luaL_dostring(lua, "local t = {} for i = 1, 10000 do t[i] = { i, tostring(i) } end return #t") == LUA_OK);
+		CHECK(lua_tointeger(lua, -1) == 10000);
+		CHECK(stats.allocations > allocations + 20000);
+
+		lua_close(lua);
+		CHECK(stats.live == live);
+	}
+}
+
+
+TEST_CASE("Lua/Types", "[lua]")
+{
+	static constexpr lua_Type type { "Test" };
+	static constexpr lua_Type other { "Other" };
+
+	lua_State* lua = luaL_newstate();
+	REQUIRE(lua != nullptr);
+
+	REQUIRE(lua_newtype(lua, type) != 0);
+	REQUIRE(lua_newtype(lua, other) != 0);
+	CHECK(lua_newtype(lua, type) == 0);
+	lua_settop(lua, 0);
+
+	auto& handle = lua_newhandle<lua_Handle<int>>(lua, type);
+	handle.handle = 42;
+
+	SECTION("Match the metatable created by luaL_newmetatable")
+	{
+		CHECK(luaL_testudata(lua, 1, "Test") == &handle);
+		CHECK(lua_testtype(lua, 1, type) == &handle);
+		CHECK(lua_testhandle<lua_Handle<int>>(lua, 1, type)->handle == 42);
+		CHECK(lua_gettop(lua) == 1);
+	}
+
+	SECTION("Reject other types & values")
+	{
+		lua_newhandle<lua_Handle<int>>(lua, other);
+		lua_newuserdatauv(lua, sizeof(int), 0);
+		lua_pushinteger(lua, 42);
+
+		CHECK(lua_testtype(lua, 1, other) == nullptr);
+		CHECK(lua_testtype(lua, 2, type) == nullptr);
+		CHECK(lua_testtype(lua, 3, type) == nullptr);
+		CHECK(lua_testtype(lua, 4, type) == nullptr);
+		CHECK(lua_gettop(lua) == 4);
+	}
+
+	SECTION("Raise the same error as luaL_checkudata")
+	{
+		lua_pushcfunction(lua, [](lua_State* lua) { luaL_checkudata(lua, 1, "Test"); return 0; });
+		lua_pushinteger(lua, 1);
+		REQUIRE(lua_pcall(lua, 1, 0, 0) != LUA_OK);
+		std::string expected = lua_tostring(lua, -1);
+
+		lua_pushcfunction(lua, [](lua_State* lua) { lua_checktype(lua, 1, type); return 0; });
+		lua_pushinteger(lua, 1);
+		REQUIRE(lua_pcall(lua, 1, 0, 0) != LUA_OK);
+		CHECK(expected == lua_tostring(lua, -1));
+	}
+
+	lua_close(lua);
+}
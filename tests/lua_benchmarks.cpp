@@ -0,0 +1,261 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+
+#include <string>
+
+#include <luax.hpp>
+#include <hashmap.hpp>
+#include <perfecthash.hpp>
+
+
+/**
+ * @brief Script defining trivial entry points, so that only the cost of dispatching to them is measured.
+ */
+static const char* const dispatch_script = R"(
+	frames = 0
+	function update(delta) frames = frames + 1 end
+	function draw(delta) end
+)";
+
+
+/**
+ * @brief Call the function pushed above its arguments, with the message handler found below it.
+ */
+static bool Call(lua_State* lua, int nargs)
+{
+	int msgh = lua_gettop(lua) - nargs - 1;
+	bool success = lua_pcall(lua, nargs, 0, msgh) == LUA_OK;
+	lua_settop(lua, msgh - 1);
+	return success;
+}
+
+
+TEST_CASE("Lua/Dispatch", "[lua][benchmark]")
+{
+	lua_State* lua = luaL_newstate();
+	REQUIRE(lua != NULL);
+
+	luaL_openlibs(lua);
+	REQUIRE(luaL_dostring(lua, dispatch_script) == LUA_OK);
+
+	// Every frame, as `Program::Update` used to: look up the traceback & each callback by name.
+	auto by_name = [&](const char* name)
+	{
+		lua_pushtraceback(lua);
+
+		if (lua_getglobal(lua, name) != LUA_TFUNCTION)
+		{ lua_settop(lua, 0); return false; }
+
+		lua_pushnumber(lua, 1.0 / 60.0);
+		return Call(lua, 1);
+	};
+
+	// Once, as `Program::Register` does: resolve the traceback & callbacks into registry references.
+	REQUIRE(lua_pushtraceback(lua) != 0);
+	int traceback = luaL_ref(lua, LUA_REGISTRYINDEX);
+
+	REQUIRE(lua_getglobal(lua, "update") == LUA_TFUNCTION);
+	int update = luaL_ref(lua, LUA_REGISTRYINDEX);
+
+	REQUIRE(lua_getglobal(lua, "draw") == LUA_TFUNCTION);
+	int draw = luaL_ref(lua, LUA_REGISTRYINDEX);
+
+	auto by_ref = [&](int ref)
+	{
+		lua_rawgeti(lua, LUA_REGISTRYINDEX, traceback);
+		lua_rawgeti(lua, LUA_REGISTRYINDEX, ref);
+		lua_pushnumber(lua, 1.0 / 60.0);
+		return Call(lua, 1);
+	};
+
+	REQUIRE(by_name("update"));
+	REQUIRE(by_ref(update));
+
+	BENCHMARK("Frame by name")
+	{ return by_name("update") && by_name("draw"); };
+
+	BENCHMARK("Frame by reference")
+	{ return by_ref(update) && by_ref(draw); };
+
+	luaL_unref(lua, LUA_REGISTRYINDEX, draw);
+	luaL_unref(lua, LUA_REGISTRYINDEX, update);
+	luaL_unref(lua, LUA_REGISTRYINDEX, traceback);
+	lua_close(lua);
+}
+
+
+/**
+ * @brief Script churning through short-lived tables, closures & strings, as per-frame script code tends to.
+ */
+static const char* const allocation_script = R"(
+	local function churn(n)
+		local kept = {}
+		for i = 1, n do
+			local v = { x = i, y = -i, name = "v" .. i }
+			kept[i % 64 + 1] = function() return v end
+		end
+		return #kept
+	end
+	return churn
+)";
+
+
+TEST_CASE("Lua/Allocator", "[lua][benchmark]")
+{
+	// Run the same script on a state allocating through the system & on one allocating through our pools.
+	auto run = [](lua_State* lua)
+	{
+		REQUIRE(lua != NULL);
+		luaL_openlibs(lua);
+		REQUIRE(luaL_dostring(lua, allocation_script) == LUA_OK);
+		return lua;
+	};
+
+	lua_State* system = run(luaL_newstate());
+	lua_State* pooled = run(lua_newstate(lua_poolalloc, NULL));
+
+	auto churn = [](lua_State* lua)
+	{
+		lua_pushvalue(lua, -1);
+		lua_pushinteger(lua, 10000);
+		bool success = lua_pcall(lua, 1, 1, 0) == LUA_OK;
+		lua_pop(lua, 1);
+		return success;
+	};
+
+	BENCHMARK("Churn with luaL_newstate")
+	{ return churn(system); };
+
+	BENCHMARK("Churn with lua_poolalloc")
+	{ return churn(pooled); };
+
+	lua_close(pooled);
+	lua_close(system);
+}
+
+
+TEST_CASE("Lua/Name Lookup", "[lua][benchmark]")
+{
+	// The same table of names as a vertex format lookup, resolved at runtime & at compile-time.
+	static const Game::HashMap<std::string, int> hash_map
+	{
+		{ "int", 0 }, { "int2", 1 }, { "int3", 2 }, { "int4", 3 },
+		{ "float", 4 }, { "float2", 5 }, { "float3", 6 }, { "float4", 7 },
+		{ "ubyte4norm", 8 }, { "short2norm", 9 }, { "ushort4norm", 10 }, { "r", 11 },
+	};
+
+	static constexpr auto perfect_hash_map = Game::MakePerfectHashMap<int>
+	({
+		{ "int", 0 }, { "int2", 1 }, { "int3", 2 }, { "int4", 3 },
+		{ "float", 4 }, { "float2", 5 }, { "float3", 6 }, { "float4", 7 },
+		{ "ubyte4norm", 8 }, { "short2norm", 9 }, { "ushort4norm", 10 }, { "r", 11 },
+	});
+
+	static_assert(perfect_hash_map.find("float3")->second == 6);
+	static_assert(perfect_hash_map.find("float5") == perfect_hash_map.end());
+
+	static const std::string_view keys[] { "r", "float3", "ushort4norm", "int", "unknown" };
+
+	for (auto key : keys)
+	{
+		auto it = hash_map.find(key);
+		auto found = perfect_hash_map.find(key);
+		REQUIRE((it == hash_map.end()) == (found == perfect_hash_map.end()));
+		CHECK((found == perfect_hash_map.end() || found->second == it->second));
+	}
+
+	BENCHMARK("Game::HashMap")
+	{
+		int sum = 0;
+		for (auto key : keys)
+		{
+			if (auto it = hash_map.find(key); it != hash_map.end())
+			{ sum += it->second; }
+		}
+		return sum;
+	};
+
+	BENCHMARK("Game::PerfectHashMap")
+	{
+		int sum = 0;
+		for (auto key : keys)
+		{
+			if (auto it = perfect_hash_map.find(key); it != perfect_hash_map.end())
+			{ sum += it->second; }
+		}
+		return sum;
+	};
+}
+
+
+TEST_CASE("Lua/Userdata Metadata", "[lua][benchmark]")
+{
+	struct Size
+	{
+		lua_Integer width;
+		lua_Integer height;
+	};
+
+	lua_State* lua = luaL_newstate();
+	REQUIRE(lua != NULL);
+
+	static constexpr lua_Type type { "Benchmark" };
+	lua_newtype(lua, type);
+	lua_pop(lua, 1);
+
+	// As bindings used to: a bare pointer, its size hung off uservalues.
+	*lua_newudata<void*>(lua, 2) = lua;
+	luaL_setmetatable(lua, "Benchmark");
+	lua_pushinteger(lua, 800);
+	lua_setiuservalue(lua, 1, 1);
+	lua_pushinteger(lua, 600);
+	lua_setiuservalue(lua, 1, 2);
+
+	// As bindings do now: the pointer & its size in one block.
+	auto& handle = lua_newhandle<lua_Handle<void*, Size>>(lua, type);
+	handle = { lua, { 800, 600 } };
+
+	BENCHMARK("Size from uservalues")
+	{
+		auto ptr = *lua_checkudata<void*>(lua, 1, "Benchmark");
+		lua_getiuservalue(lua, 1, 1);
+		auto width = lua_tointeger(lua, -1);
+		lua_getiuservalue(lua, 1, 2);
+		auto height = lua_tointeger(lua, -1);
+		lua_pop(lua, 2);
+		return ptr != NULL ? width * height : 0;
+	};
+
+	BENCHMARK("Size from lua_Handle")
+	{
+		auto& block = lua_checkhandle<lua_Handle<void*, Size>>(lua, 2, type);
+		return block.handle != NULL ? block.meta.width * block.meta.height : 0;
+	};
+
+	lua_close(lua);
+}
+
+
+TEST_CASE("Lua/Type Check", "[lua][benchmark]")
+{
+	static constexpr lua_Type type { "Benchmark" };
+
+	lua_State* lua = luaL_newstate();
+	REQUIRE(lua != NULL);
+
+	// Open the standard libraries, so that the registry holds as much as the game's does.
+	luaL_openlibs(lua);
+	lua_newtype(lua, type);
+	lua_pop(lua, 1);
+
+	lua_newhandle<lua_Handle<void*>>(lua, type).handle = lua;
+
+	BENCHMARK("luaL_checkudata")
+	{ return luaL_checkudata(lua, 1, "Benchmark"); };
+
+	BENCHMARK("lua_checktype")
+	{ return lua_checktype(lua, 1, type); };
+
+	lua_close(lua);
+}